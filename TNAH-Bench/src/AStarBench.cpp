@@ -0,0 +1,170 @@
+#include "tnahpch.h"
+#include "Bench.h"
+#include "BaselineAStar.h"
+
+#include <cmath>
+#include <random>
+
+namespace tnah::bench {
+
+	/** @brief	A grid with a share of its cells blocked and start and end pairs that are both open */
+	struct AStarBenchGrid
+	{
+		Int2 Origin;
+		Int2 Size;
+		std::vector<Int2> Blocked;
+		std::vector<std::pair<Int2, Int2>> Queries;
+	};
+
+	static AStarBenchGrid MakeGrid(int side, float blockedShare, size_t queries, uint32_t seed)
+	{
+		// The old search gives up on paths through cell 0,0, so the grids start at 1,1
+		AStarBenchGrid grid;
+		grid.Origin = { 1, 1 };
+		grid.Size = { side, side };
+
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> share(0.0f, 1.0f);
+		std::uniform_int_distribution<int> cell(0, side - 1);
+		std::vector<bool> blocked(static_cast<size_t>(side) * side, false);
+		for(int y = 0; y < side; y++)
+		{
+			for(int x = 0; x < side; x++)
+			{
+				if(share(random) < blockedShare)
+				{
+					blocked[static_cast<size_t>(y) * side + x] = true;
+					grid.Blocked.push_back({ grid.Origin.x + x, grid.Origin.y + y });
+				}
+			}
+		}
+
+		while(grid.Queries.size() < queries)
+		{
+			const int sx = cell(random), sy = cell(random), dx = cell(random), dy = cell(random);
+			if(blocked[static_cast<size_t>(sy) * side + sx] || blocked[static_cast<size_t>(dy) * side + dx] || (sx == dx && sy == dy))
+				continue;
+			grid.Queries.push_back({ { grid.Origin.x + sx, grid.Origin.y + sy }, { grid.Origin.x + dx, grid.Origin.y + dy } });
+		}
+		return grid;
+	}
+
+	/**
+	 * @fn	static float PathCost(Int2 start, const std::deque<Node>& path)
+	 *
+	 * @brief	Adds up the steps of a path from the start, whether or not the path lists the start itself. The old
+	 * 			search prices two of the four diagonals at 1 and stops as soon as it sees the goal, so its own costs
+	 * 			are not comparable and both paths are priced here the same way
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	grid 	The grid the path has to stay on.
+	 * @param 	start	The start of the query.
+	 * @param 	end  	The end of the query.
+	 * @param 	path 	The path.
+	 *
+	 * @returns	The cost with a 1.5 diagonal step, or -1 if the path leaves the open cells, jumps or misses the end.
+	 */
+
+	static float PathCost(const AStarGrid& grid, Int2 start, Int2 end, const std::deque<Node>& path)
+	{
+		float cost = 0.0f;
+		Int2 previous = start;
+		for(const Node& node : path)
+		{
+			const int dx = std::abs(node.position.x - previous.x);
+			const int dy = std::abs(node.position.y - previous.y);
+			if(dx == 0 && dy == 0)
+				continue;
+			if(dx > 1 || dy > 1 || !grid.IsValid(node.position))
+				return -1.0f;
+			cost += dx != 0 && dy != 0 ? 1.5f : 1.0f;
+			previous = node.position;
+		}
+		return previous.x == end.x && previous.y == end.y ? cost : -1.0f;
+	}
+
+	TNAH_BENCH(AStarBaselineVsGrid)
+	{
+		std::printf("%8s %8s %12s %16s %16s %10s\n", "grid", "queries", "found b/n", "baseline ms/q", "grid ms/q", "speedup");
+		size_t mismatches = 0, shorter = 0;
+
+		const int sides[] = { 32, 64, 128, 256 };
+		for(int side : sides)
+		{
+			const AStarBenchGrid grid = MakeGrid(side, 0.2f, side >= 128 ? 8 : 16, 17u + side);
+
+			// The old search also walks the row and column one past the end, block them so both search the same cells
+			BaselineAStar::Clear();
+			for(const Int2& cell : grid.Blocked)
+				BaselineAStar::AddUsedPosition(cell, false);
+			for(int i = 0; i <= side; i++)
+			{
+				BaselineAStar::AddUsedPosition({ grid.Origin.x + side, grid.Origin.y + i }, false);
+				BaselineAStar::AddUsedPosition({ grid.Origin.x + i, grid.Origin.y + side }, false);
+			}
+			BaselineAStar::Init(grid.Origin, grid.Size);
+
+			auto dense = Ref<AStarGrid>::Create(grid.Origin, grid.Size);
+			for(const Int2& cell : grid.Blocked)
+				dense->AddUsedPosition(cell, false);
+
+			size_t baselineFound = 0;
+			std::vector<std::deque<Node>> baselinePaths;
+			baselinePaths.reserve(grid.Queries.size());
+			const double baselineTime = TimeMilliseconds([&]()
+			{
+				for(const auto& [start, end] : grid.Queries)
+				{
+					baselinePaths.push_back(BaselineAStar::Algorithm(Node(start), Node(end)));
+					baselineFound += baselinePaths.back().empty() ? 0 : 1;
+				}
+			});
+
+			// The new search is fast enough to need repeats for a steady time
+			const int repeats = 20;
+			size_t gridFound = 0;
+			AStarSearchContext context;
+			const double gridTime = TimeMilliseconds([&]()
+			{
+				for(int repeat = 0; repeat < repeats; repeat++)
+				{
+					for(const auto& [start, end] : grid.Queries)
+						gridFound += dense->FindPath(start, end, context).empty() ? 0 : 1;
+				}
+			});
+			gridFound /= repeats;
+
+			// Both have to agree on whether there is a path, and the new one has to be a real path no dearer than the old
+			for(size_t i = 0; i < grid.Queries.size(); i++)
+			{
+				const auto& [start, end] = grid.Queries[i];
+				const std::deque<Node> path = dense->FindPath(start, end, context);
+				if(path.empty() || baselinePaths[i].empty())
+				{
+					mismatches += path.empty() == baselinePaths[i].empty() ? 0 : 1;
+					continue;
+				}
+
+				const float cost = PathCost(*dense, start, end, path);
+				const float baselineCost = PathCost(*dense, start, end, baselinePaths[i]);
+				mismatches += cost >= 0.0f && baselineCost >= 0.0f && cost <= baselineCost + 1e-3f ? 0 : 1;
+				shorter += cost >= 0.0f && cost < baselineCost - 1e-3f ? 1 : 0;
+			}
+
+			const double queries = static_cast<double>(grid.Queries.size());
+			const double baselinePerQuery = baselineTime / queries;
+			const double gridPerQuery = gridTime / (queries * repeats);
+			char found[32];
+			std::snprintf(found, sizeof(found), "%zu/%zu", baselineFound, gridFound);
+			std::printf("%5dx%-3d %8zu %12s %16.4f %16.4f %9.1fx\n", side, side, grid.Queries.size(), found,
+				baselinePerQuery, gridPerQuery, baselinePerQuery / gridPerQuery);
+		}
+		BaselineAStar::Clear();
+
+		std::printf("%-32s %10zu\n", "queries found shorter", shorter);
+		std::printf("%-32s %10zu\n", "queries that disagree", mismatches);
+		GetFailureCount() += mismatches;
+	}
+}
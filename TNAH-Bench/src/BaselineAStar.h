@@ -0,0 +1,118 @@
+#pragma once
+#include "TNAH/Scene/Components/ComponentIdentification.h"
+#include "TNAH/Scene/Components/AI/AStar.h"
+
+#include <stack>
+
+namespace tnah::bench {
+
+	/**
+	 * @class	BaselineAStar
+	 *
+	 * @brief	The A* search as it was before the dense grid, kept so the new search can be measured against it on
+	 * 			the same grids. The search, its nested hash maps and its linear scan of the open list are copied
+	 * 			unchanged, only the class is renamed.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class BaselineAStar
+	{
+	public:
+
+		/**
+		 * @fn	static bool BaselineAStar::IsValid(Int2 point);
+		 *
+		 * @brief	Checks if a point is in bounds and not used
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	point	The point.
+		 *
+		 * @returns	True if valid.
+		 */
+
+		static bool IsValid(Int2 point);
+
+		/**
+		 * @fn	static void BaselineAStar::Update();
+		 *
+		 * @brief	Frees the cells of the dynamic obstacles
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		static void Update();
+
+		/**
+		 * @fn	static void BaselineAStar::Init(Int2 startingPosition, Int2 xySize);
+		 *
+		 * @brief	Sets up the map, used cells are kept
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	startingPosition	The lowest cell.
+		 * @param 	xySize				The size.
+		 */
+
+		static void Init(Int2 startingPosition, Int2 xySize);
+
+		/**
+		 * @fn	static std::deque<Node> BaselineAStar::Algorithm(Node point, Node destination);
+		 *
+		 * @brief	Searches for a path
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	point	   	The start.
+		 * @param 	destination	The destination.
+		 *
+		 * @returns	The path, empty if there is none.
+		 */
+
+		static std::deque<Node> Algorithm(Node point, Node destination);
+
+		/**
+		 * @fn	static void BaselineAStar::AddUsedPosition(Int2 position, bool dynamic);
+		 *
+		 * @brief	Marks a cell as used
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	position	The cell.
+		 * @param 	dynamic 	True if the cell is freed by the next Update.
+		 */
+
+		static void AddUsedPosition(Int2 position, bool dynamic);
+
+		/**
+		 * @fn	static void BaselineAStar::Clear();
+		 *
+		 * @brief	Drops the map and every used cell, so another grid can be set up
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		static void Clear();
+
+	private:
+		static bool Reached(Int2 point, Node destination);
+		static double heuristic(Int2 point, Node destination);
+		static std::deque<Node> makePath(std::unordered_map<int, std::unordered_map<int, Node>> map, Node destination);
+
+		inline static bool initilised = false;
+		inline static Int2 startingPos = {0, 0};
+		inline static Int2 size = {10, 10};
+		inline static std::unordered_map<int, std::unordered_map<int, bool>> closedList;
+		inline static std::unordered_map<int, std::unordered_map<int, bool>> usedPositions;
+		inline static std::unordered_map<int, std::unordered_map<int, Node>> astarMap;
+		inline static std::vector<Int2> usedPositionsHolder;
+	};
+}
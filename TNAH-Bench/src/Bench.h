@@ -0,0 +1,106 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace tnah::bench {
+
+	/** @brief	A benchmark, it prints its own results */
+	using BenchFunction = void(*)();
+
+	/**
+	 * @struct	BenchCase
+	 *
+	 * @brief	A registered benchmark
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct BenchCase
+	{
+		const char* Name;
+		BenchFunction Function;
+	};
+
+	/**
+	 * @fn	inline std::vector<BenchCase>& GetBenchCases()
+	 *
+	 * @brief	Gets every benchmark registered with TNAH_BENCH, in the order the files were linked
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @returns	The benchmarks.
+	 */
+
+	inline std::vector<BenchCase>& GetBenchCases()
+	{
+		static std::vector<BenchCase> s_Cases;
+		return s_Cases;
+	}
+
+	/**
+	 * @fn	inline bool RegisterBench(const char* name, BenchFunction function)
+	 *
+	 * @brief	Adds a benchmark, called by TNAH_BENCH before main
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	name		The name the benchmark is picked by on the command line.
+	 * @param 	function	The benchmark.
+	 *
+	 * @returns	True.
+	 */
+
+	inline bool RegisterBench(const char* name, BenchFunction function)
+	{
+		GetBenchCases().push_back({ name, function });
+		return true;
+	}
+
+	/**
+	 * @fn	inline size_t& GetFailureCount()
+	 *
+	 * @brief	Gets the number of results the benchmarks found to disagree with their baseline
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @returns	The count, main fails the run if it is not 0.
+	 */
+
+	inline size_t& GetFailureCount()
+	{
+		static size_t s_Failures = 0;
+		return s_Failures;
+	}
+
+	/**
+	 * @fn	template<typename Function> double TimeMilliseconds(Function&& function)
+	 *
+	 * @brief	Runs a function once and measures it on the steady clock
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	function	The function.
+	 *
+	 * @returns	The time it took in milliseconds.
+	 */
+
+	template<typename Function>
+	double TimeMilliseconds(Function&& function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+/** @brief	Defines and registers a benchmark */
+#define TNAH_BENCH(name) \
+	static void name(); \
+	static const bool s_##name##Registered = ::tnah::bench::RegisterBench(#name, &name); \
+	static void name()
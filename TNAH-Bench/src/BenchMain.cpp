@@ -0,0 +1,40 @@
+#include "tnahpch.h"
+#include "Bench.h"
+
+#include <cstring>
+
+/**
+ * @fn	int main(int argc, char** argv)
+ *
+ * @brief	Runs every benchmark, or only those whose name contains one of the arguments
+ *
+ * @author	Chris
+ * @date	17/10/2026
+ *
+ * @param 	argc	The number of command-line arguments.
+ * @param 	argv	Parts of the names of the benchmarks to run.
+ *
+ * @returns	0, or 1 if a benchmark found results that disagree with its baseline.
+ */
+
+int main(int argc, char** argv)
+{
+	tnah::Log::Init();
+
+	for(const auto& bench : tnah::bench::GetBenchCases())
+	{
+		bool selected = argc < 2;
+		for(int arg = 1; arg < argc && !selected; arg++)
+			selected = std::strstr(bench.Name, argv[arg]) != nullptr;
+		if(!selected)
+			continue;
+
+		std::printf("== %s\n", bench.Name);
+		const size_t failures = tnah::bench::GetFailureCount();
+		bench.Function();
+		if(tnah::bench::GetFailureCount() != failures)
+			std::printf("FAILED: %zu wrong results\n", tnah::bench::GetFailureCount() - failures);
+		std::printf("\n");
+	}
+	return tnah::bench::GetFailureCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include "tnahpch.h"
+#include "Bench.h"
+#include "BaselineEmotionComponent.h"
+
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Scene/Components/AI/EmotionComponent.h"
+
+#include <cmath>
+
+namespace tnah::bench {
+
+	static constexpr int s_Characters = 10000;
+	static constexpr int s_Frames = 2000;
+	static constexpr float s_FrameTime = 1.0f / 60.0f;
+	static const Trait s_Traits[] = { Trait::Happy, Trait::Sad, Trait::Paranoid, Trait::Carefree, Trait::Bland };
+
+	/**
+	 * @fn	template<typename Component, typename Step> static double RunCharacters(std::vector<Component>& characters, const Step& step)
+	 *
+	 * @brief	Sets up the characters and steps them for every frame, nudging some of them now and then so moods change
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param [in,out]	characters	The characters, filled by the run.
+	 * @param 		  	step	  	Steps every character by a frame time.
+	 *
+	 * @returns	The time per frame in milliseconds.
+	 */
+
+	template<typename Component, typename Step>
+	static double RunCharacters(std::vector<Component>& characters, const Step& step)
+	{
+		characters.reserve(s_Characters);
+		for(int i = 0; i < s_Characters; i++)
+		{
+			characters.emplace_back(((i * 37) % 200 - 100) / 100.0f, ((i * 91) % 200 - 100) / 100.0f, static_cast<Mood>(i % 5));
+			characters.back().AddTrait(s_Traits[i % 5]);
+		}
+
+		return TimeMilliseconds([&]()
+		{
+			for(int frame = 0; frame < s_Frames; frame++)
+			{
+				step();
+				if(frame % 100 == 0)
+				{
+					for(int i = 0; i < s_Characters; i += 97)
+					{
+						characters[i].IncreaseArousal(0.3f);
+						characters[i].DecreaseValence(0.2f);
+					}
+				}
+			}
+		}) / s_Frames;
+	}
+
+	TNAH_BENCH(EmotionSystemUpdate)
+	{
+		std::printf("%d characters, %d frames\n", s_Characters, s_Frames);
+
+		std::vector<BaselineEmotionComponent> baseline;
+		const double baselineTime = RunCharacters(baseline, [&]()
+		{
+			for(auto& character : baseline)
+				character.Update(s_FrameTime);
+		});
+		std::printf("%-32s %10.4f ms/frame\n", "per component update", baselineTime);
+
+		std::vector<EmotionComponent> arrays;
+		const double inlineTime = RunCharacters(arrays, []() { EmotionSystem::GetStandalone().Update(s_FrameTime); });
+		std::printf("%-32s %10.4f ms/frame %8.1fx\n", "EmotionSystem, one thread", inlineTime, baselineTime / inlineTime);
+
+		// Both updates have to end in the same state for the times to be comparable
+		size_t mismatches = 0;
+		for(int i = 0; i < s_Characters; i++)
+		{
+			auto& before = baseline[i];
+			auto& after = arrays[i];
+			if(before.GetEmotion() != after.GetEmotion() || before.GetMood() != after.GetMood()
+				|| std::abs(before.GetArousal() - after.GetArousal()) > 1e-4f || std::abs(before.GetValence() - after.GetValence()) > 1e-4f)
+				mismatches++;
+		}
+		std::printf("%-32s %10zu of %d\n", "characters in a different state", mismatches, s_Characters);
+		arrays.clear();
+
+		JobSystem::Init();
+		std::vector<EmotionComponent> threaded;
+		const double threadedTime = RunCharacters(threaded, []() { EmotionSystem::GetStandalone().Update(s_FrameTime); });
+		char label[64];
+		std::snprintf(label, sizeof(label), "EmotionSystem, %u threads", JobSystem::GetThreadCount());
+		std::printf("%-32s %10.4f ms/frame %8.1fx\n", label, threadedTime, baselineTime / threadedTime);
+		threaded.clear();
+		JobSystem::Shutdown();
+	}
+}
@@ -0,0 +1,132 @@
+#include "tnahpch.h"
+#include "Bench.h"
+
+#include "TNAH/Scene/Components/AI/HPAStar.h"
+
+#include <random>
+
+namespace tnah::bench {
+
+	static float PathCost(const std::deque<Node>& path)
+	{
+		float cost = 0.0f;
+		for(size_t i = 1; i < path.size(); i++)
+		{
+			const bool diagonal = path[i].position.x != path[i - 1].position.x && path[i].position.y != path[i - 1].position.y;
+			cost += diagonal ? 1.5f : 1.0f;
+		}
+		return cost;
+	}
+
+	TNAH_BENCH(HPAStarLongQueries)
+	{
+		const int side = 2048;
+		auto grid = Ref<AStarGrid>::Create(Int2(0, 0), Int2(side, side));
+		std::mt19937 random(41u);
+		std::uniform_real_distribution<float> share(0.0f, 1.0f);
+		std::uniform_int_distribution<int> cell(0, side - 1);
+		for(int y = 0; y < side; y++)
+		{
+			for(int x = 0; x < side; x++)
+			{
+				if(share(random) < 0.02f)
+					grid->AddUsedPosition({ x, y }, false);
+			}
+		}
+
+		auto hierarchy = Ref<HPAStarGraph>::Create(grid);
+		const double buildTime = TimeMilliseconds([&]() { hierarchy->Build(); });
+
+		std::vector<std::pair<Int2, Int2>> queries;
+		while(queries.size() < 200)
+		{
+			const Int2 start(cell(random), cell(random)), end(cell(random), cell(random));
+			if(grid->IsValid(start) && grid->IsValid(end) && hierarchy->IsLongRange(start, end) && std::abs(start.x - end.x) + std::abs(start.y - end.y) > side / 2)
+				queries.push_back({ start, end });
+		}
+
+		// What the path service does for a long request, a route and its first segment. The first query sizes the
+		// search memory for the whole grid, the service keeps it between requests so it is left out
+		size_t routed = 0;
+		HPARoute route;
+		std::deque<Node> path;
+		hierarchy->FindRoute(queries[0].first, queries[0].second, route);
+		hierarchy->RefineNext(route, path);
+		const double firstSegmentTime = TimeMilliseconds([&]()
+		{
+			for(const auto& [start, end] : queries)
+			{
+				path.clear();
+				if(hierarchy->FindRoute(start, end, route) && hierarchy->RefineNext(route, path))
+					routed++;
+			}
+		});
+
+		std::printf("%dx%d grid, 2%% blocked, build %.0f ms\n", side, side, buildTime);
+		std::printf("%-36s %10.3f ms/q (%zu of %zu routed)\n", "route and first segment", firstSegmentTime / queries.size(), routed, queries.size());
+
+		// The whole path for a smaller set, against the flat search on the same queries
+		const size_t compared = 16;
+		double hierarchicalCost = 0.0, flatCost = 0.0;
+		size_t mismatches = 0;
+		AStarSearchContext context;
+		double flatTime = 0.0, fullTime = 0.0;
+		for(size_t i = 0; i < compared; i++)
+		{
+			const auto& [start, end] = queries[i];
+			std::deque<Node> full;
+			fullTime += TimeMilliseconds([&]()
+			{
+				if(hierarchy->FindRoute(start, end, route))
+				{
+					while(hierarchy->RefineNext(route, full))
+						;
+				}
+			});
+
+			std::deque<Node> flat;
+			flatTime += TimeMilliseconds([&]() { flat = grid->FindPath(start, end, context); });
+
+			// Both searches have to agree on whether a path exists, the hierarchical one may be a little longer
+			if(flat.empty() != full.empty())
+				mismatches++;
+			else if(!flat.empty())
+			{
+				hierarchicalCost += PathCost(full);
+				flatCost += PathCost(flat);
+			}
+		}
+
+		std::printf("%-36s %10.3f ms/q\n", "hierarchical, whole path", fullTime / compared);
+		std::printf("%-36s %10.3f ms/q %8.1fx\n", "flat A*, whole path", flatTime / compared, flatTime / fullTime);
+		std::printf("%-36s %10.1f%%\n", "hierarchical path length over flat", (hierarchicalCost / flatCost - 1.0) * 100.0);
+		std::printf("%-36s %10zu of %zu\n", "queries found by only one search", mismatches, compared);
+		GetFailureCount() += mismatches;
+
+		// Catching up after obstacles move is spread over polls that each stop once their budget is used
+		for(int i = 0; i < 2000; i++)
+		{
+			const Int2 position(cell(random), cell(random));
+			if(grid->IsValid(position))
+				grid->AddUsedPosition(position, false);
+		}
+
+		const float budget = 1.0f;
+		int polls = 0;
+		double longestPoll = 0.0, syncTime = 0.0;
+		bool ready = false;
+		while(!ready)
+		{
+			const double pollTime = TimeMilliseconds([&]()
+			{
+				const auto start = std::chrono::steady_clock::now();
+				ready = hierarchy->IsReady([&]() { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget; });
+			});
+			longestPoll = std::max(longestPoll, pollTime);
+			syncTime += pollTime;
+			polls++;
+		}
+
+		std::printf("%-36s %10.3f ms in %d polls, longest %.3f ms\n", "sync after 2000 cells changed", syncTime, polls, longestPoll);
+	}
+}
@@ -0,0 +1,107 @@
+#include "tnahpch.h"
+#include "Bench.h"
+
+#include "TNAH/Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace tnah::bench {
+
+	/** @brief	The parts of a transform the synthetic update reads and writes */
+	struct BenchTransform
+	{
+		glm::vec3 Position;
+		glm::vec3 Velocity;
+		float Yaw;
+		float Spin;
+		glm::vec3 Scale;
+		glm::mat4 World;
+	};
+
+	static void UpdateTransforms(std::vector<BenchTransform>& transforms, size_t begin, size_t end, float dt)
+	{
+		for(size_t i = begin; i < end; i++)
+		{
+			auto& transform = transforms[i];
+			transform.Position += transform.Velocity * dt;
+			transform.Yaw += transform.Spin * dt;
+
+			// Translation, then a turn about y, then the scale
+			const float c = std::cos(transform.Yaw);
+			const float s = std::sin(transform.Yaw);
+			glm::mat4 world(1.0f);
+			world[0] = glm::vec4(c * transform.Scale.x, 0.0f, -s * transform.Scale.x, 0.0f);
+			world[1] = glm::vec4(0.0f, transform.Scale.y, 0.0f, 0.0f);
+			world[2] = glm::vec4(s * transform.Scale.z, 0.0f, c * transform.Scale.z, 0.0f);
+			world[3] = glm::vec4(transform.Position, 1.0f);
+			transform.World = world;
+		}
+	}
+
+	static std::vector<BenchTransform> MakeTransforms(size_t count)
+	{
+		std::vector<BenchTransform> transforms(count);
+		for(size_t i = 0; i < count; i++)
+		{
+			const float f = static_cast<float>(i);
+			transforms[i] = { glm::vec3(f, 0.0f, -f), glm::vec3(std::sin(f), 0.0f, std::cos(f)), f * 0.01f, 0.5f + (i % 7) * 0.1f,
+				glm::vec3(1.0f + (i % 3) * 0.5f), glm::mat4(1.0f) };
+		}
+		return transforms;
+	}
+
+	TNAH_BENCH(JobSystemScaling)
+	{
+		const size_t count = 200000;
+		const int frames = 50;
+		const float dt = 1.0f / 60.0f;
+		const size_t grain = 1024;
+
+		std::vector<uint32_t> threadCounts = { 1, 2, 4, 8 };
+		const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+		if(std::find(threadCounts.begin(), threadCounts.end(), hardware) == threadCounts.end())
+			threadCounts.push_back(hardware);
+		std::sort(threadCounts.begin(), threadCounts.end());
+
+		std::printf("%zu transforms, %d frames, %u hardware threads\n", count, frames, hardware);
+		std::printf("%8s %12s %10s %12s %10s\n", "threads", "ms/frame", "speedup", "efficiency", "matches");
+
+		std::vector<BenchTransform> serial = MakeTransforms(count);
+		for(int frame = 0; frame < frames; frame++)
+			UpdateTransforms(serial, 0, count, dt);
+
+		double oneThread = 0.0;
+		for(uint32_t threads : threadCounts)
+		{
+			// One thread leaves the job system off, so the first line has no scheduling in it at all
+			if(threads > 1)
+				JobSystem::Init(threads - 1);
+
+			std::vector<BenchTransform> transforms = MakeTransforms(count);
+			const double time = TimeMilliseconds([&]()
+			{
+				for(int frame = 0; frame < frames; frame++)
+				{
+					JobSystem::ParallelFor(count, grain, [&transforms, dt](size_t begin, size_t end)
+					{
+						UpdateTransforms(transforms, begin, end, dt);
+					});
+				}
+			}) / frames;
+
+			if(threads > 1)
+				JobSystem::Shutdown();
+
+			bool same = true;
+			for(size_t i = 0; i < count && same; i++)
+				same = transforms[i].World == serial[i].World;
+
+			if(threads == 1)
+				oneThread = time;
+			const double speedup = oneThread / time;
+			std::printf("%8u %12.3f %9.2fx %11.0f%% %10s\n", threads, time, speedup, speedup / threads * 100.0, same ? "yes" : "NO");
+		}
+	}
+}
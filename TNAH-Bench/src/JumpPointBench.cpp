@@ -0,0 +1,107 @@
+#include "tnahpch.h"
+#include "Bench.h"
+
+#include "TNAH/Scene/Components/AI/AStar.h"
+
+#include <cmath>
+#include <random>
+
+namespace tnah::bench {
+
+	/** @brief	The totals of one search mode over a set of queries, and the cost of each query, -1 where none was found */
+	struct SearchModeResult
+	{
+		size_t Found = 0;
+		size_t Expansions = 0;
+		std::vector<float> Costs;
+		double Milliseconds = 0.0;
+	};
+
+	static SearchModeResult RunQueries(AStarGrid& grid, AStarSearchMode mode, const std::vector<std::pair<Int2, Int2>>& queries, int repeats)
+	{
+		grid.SetSearchMode(mode);
+		SearchModeResult result;
+		AStarSearchContext context;
+
+		// Expansions and costs come from a single pass, the timed passes only repeat it
+		for(const auto& [start, end] : queries)
+		{
+			const std::deque<Node> path = grid.FindPath(start, end, context);
+			result.Expansions += context.GetExpansions();
+			result.Costs.push_back(path.empty() ? -1.0f : path.back().g);
+			result.Found += path.empty() ? 0 : 1;
+		}
+
+		result.Milliseconds = TimeMilliseconds([&]()
+		{
+			for(int repeat = 0; repeat < repeats; repeat++)
+			{
+				for(const auto& [start, end] : queries)
+					grid.FindPath(start, end, context);
+			}
+		}) / repeats;
+		return result;
+	}
+
+	TNAH_BENCH(AStarVsJumpPoint)
+	{
+		std::printf("%8s %8s %8s %8s %8s %12s %12s %9s %12s %12s %9s\n", "grid", "blocked", "queries", "found", "wrong",
+			"A* exp/q", "JPS exp/q", "exp ratio", "A* ms/q", "JPS ms/q", "speedup");
+		size_t expansionsAt10[2] = { 0, 0 };
+
+		const int sides[] = { 64, 256, 512 };
+		const float blockedShares[] = { 0.0f, 0.1f, 0.3f };
+		for(int side : sides)
+		{
+			for(float blockedShare : blockedShares)
+			{
+				auto grid = Ref<AStarGrid>::Create(Int2(0, 0), Int2(side, side));
+				std::mt19937 random(31u + side);
+				std::uniform_real_distribution<float> share(0.0f, 1.0f);
+				std::uniform_int_distribution<int> cell(0, side - 1);
+				for(int y = 0; y < side; y++)
+				{
+					for(int x = 0; x < side; x++)
+					{
+						if(share(random) < blockedShare)
+							grid->AddUsedPosition({ x, y }, false);
+					}
+				}
+
+				std::vector<std::pair<Int2, Int2>> queries;
+				while(queries.size() < 64)
+				{
+					const Int2 start(cell(random), cell(random)), end(cell(random), cell(random));
+					if(grid->IsValid(start) && grid->IsValid(end) && !(start.x == end.x && start.y == end.y))
+						queries.push_back({ start, end });
+				}
+
+				const int repeats = side >= 512 ? 2 : 8;
+				const SearchModeResult astar = RunQueries(*grid, AStarSearchMode::AStar, queries, repeats);
+				const SearchModeResult jump = RunQueries(*grid, AStarSearchMode::JumpPoint, queries, repeats);
+
+				// Both modes promise the same path cost on every query, each one that differs fails the run
+				size_t wrong = 0;
+				for(size_t i = 0; i < queries.size(); i++)
+					wrong += std::abs(astar.Costs[i] - jump.Costs[i]) < 1e-3f * (1.0f + astar.Costs[i]) ? 0 : 1;
+				GetFailureCount() += wrong;
+
+				if(blockedShare == 0.1f)
+				{
+					expansionsAt10[0] += astar.Expansions;
+					expansionsAt10[1] += jump.Expansions;
+				}
+
+				const double count = static_cast<double>(queries.size());
+				std::printf("%5dx%-3d %7.0f%% %8zu %8zu %8zu %12.1f %12.1f %8.1fx %12.4f %12.4f %8.1fx\n", side, side, blockedShare * 100.0f,
+					queries.size(), astar.Found, wrong, astar.Expansions / count, jump.Expansions / count,
+					static_cast<double>(astar.Expansions) / jump.Expansions, astar.Milliseconds / count, jump.Milliseconds / count,
+					astar.Milliseconds / jump.Milliseconds);
+			}
+		}
+
+		// Jump points pay off on open ground, with scattered blocks the gain is a small factor rather than an order of magnitude
+		std::printf("at 10%% blocked jump points expand %.1fx fewer cells than A*\n",
+			static_cast<double>(expansionsAt10[0]) / expansionsAt10[1]);
+	}
+}
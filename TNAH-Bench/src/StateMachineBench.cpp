@@ -0,0 +1,158 @@
+#include "tnahpch.h"
+#include "Bench.h"
+
+#include "TNAH/Scene/Components/AI/StateMachine.h"
+#include "TNAH/Scene/Components/AI/StaticStateMachine.h"
+
+#include <memory>
+#include <random>
+
+namespace tnah::bench {
+
+	static constexpr int s_Agents = 10000;
+	static constexpr int s_Frames = 1000;
+
+	/** @brief	An agent that works until it is tired and rests until it is not, on the virtual state machine */
+	struct VirtualAgent
+	{
+		float Energy;
+		float Rate;
+		int Shifts = 0;
+		std::unique_ptr<StateMachine<VirtualAgent>> Machine;
+	};
+
+	struct VirtualWork : State<VirtualAgent>
+	{
+		void Enter(VirtualAgent* agent) override { agent->Shifts++; }
+		void Execute(VirtualAgent* agent) override;
+		void Exit(VirtualAgent*) override {}
+	};
+
+	struct VirtualRest : State<VirtualAgent>
+	{
+		void Enter(VirtualAgent*) override {}
+		void Execute(VirtualAgent* agent) override;
+		void Exit(VirtualAgent*) override {}
+	};
+
+	// The states are shared by every agent, as StateMachine expects
+	static VirtualWork s_VirtualWork;
+	static VirtualRest s_VirtualRest;
+
+	void VirtualWork::Execute(VirtualAgent* agent)
+	{
+		agent->Energy -= agent->Rate;
+		if(agent->Energy < 0.0f)
+			agent->Machine->changeState(&s_VirtualRest);
+	}
+
+	void VirtualRest::Execute(VirtualAgent* agent)
+	{
+		agent->Energy += agent->Rate * 2.0f;
+		if(agent->Energy > 1.0f)
+			agent->Machine->changeState(&s_VirtualWork);
+	}
+
+	/** @brief	The same agent on the static state machine, the machine lives inside the agent */
+	struct StaticAgent
+	{
+		struct Work
+		{
+			void Enter(StaticAgent& agent) { agent.Shifts++; }
+			template<class MachineType>
+			void Execute(StaticAgent& agent, MachineType& machine);
+		};
+
+		struct Rest
+		{
+			template<class MachineType>
+			void Execute(StaticAgent& agent, MachineType& machine);
+		};
+
+		float Energy;
+		float Rate;
+		int Shifts = 0;
+		StaticStateMachine<StaticAgent, Work, Rest> Machine;
+	};
+
+	template<class MachineType>
+	void StaticAgent::Work::Execute(StaticAgent& agent, MachineType& machine)
+	{
+		agent.Energy -= agent.Rate;
+		if(agent.Energy < 0.0f)
+			machine.template ChangeState<Rest>(agent);
+	}
+
+	template<class MachineType>
+	void StaticAgent::Rest::Execute(StaticAgent& agent, MachineType& machine)
+	{
+		agent.Energy += agent.Rate * 2.0f;
+		if(agent.Energy > 1.0f)
+			machine.template ChangeState<Work>(agent);
+	}
+
+	TNAH_BENCH(StateMachineTick)
+	{
+		std::mt19937 random(5u);
+		std::uniform_real_distribution<float> energy(0.0f, 1.0f);
+		std::uniform_real_distribution<float> rate(0.01f, 0.1f);
+		std::vector<float> energies(s_Agents), rates(s_Agents);
+		for(int i = 0; i < s_Agents; i++)
+		{
+			energies[i] = energy(random);
+			rates[i] = rate(random);
+		}
+
+		std::vector<VirtualAgent> virtualAgents(s_Agents);
+		for(int i = 0; i < s_Agents; i++)
+		{
+			auto& agent = virtualAgents[i];
+			agent.Energy = energies[i];
+			agent.Rate = rates[i];
+			agent.Machine = std::make_unique<StateMachine<VirtualAgent>>(&agent);
+			agent.Machine->changeState(&s_VirtualWork);
+		}
+
+		std::vector<StaticAgent> staticAgents(s_Agents);
+		for(int i = 0; i < s_Agents; i++)
+		{
+			auto& agent = staticAgents[i];
+			agent.Energy = energies[i];
+			agent.Rate = rates[i];
+			agent.Machine.Start(agent);
+		}
+
+		const double virtualTime = TimeMilliseconds([&]()
+		{
+			for(int frame = 0; frame < s_Frames; frame++)
+			{
+				for(auto& agent : virtualAgents)
+					agent.Machine->update();
+			}
+		});
+
+		const double staticTime = TimeMilliseconds([&]()
+		{
+			for(int frame = 0; frame < s_Frames; frame++)
+			{
+				for(auto& agent : staticAgents)
+					agent.Machine.Update(agent);
+			}
+		});
+
+		// Both machines have to take every agent through the same shifts for the times to be comparable
+		size_t mismatches = 0;
+		long long shifts = 0;
+		for(int i = 0; i < s_Agents; i++)
+		{
+			mismatches += virtualAgents[i].Shifts == staticAgents[i].Shifts && virtualAgents[i].Energy == staticAgents[i].Energy ? 0 : 1;
+			shifts += staticAgents[i].Shifts;
+		}
+
+		const double ticks = static_cast<double>(s_Agents) * s_Frames;
+		std::printf("%d agents, %d frames, %lld state changes into work\n", s_Agents, s_Frames, shifts);
+		std::printf("%-32s %10.2f ns/tick\n", "StateMachine", virtualTime * 1e6 / ticks);
+		std::printf("%-32s %10.2f ns/tick %8.2fx\n", "StaticStateMachine", staticTime * 1e6 / ticks, virtualTime / staticTime);
+		std::printf("%-32s %10zu of %d\n", "agents that ended differently", mismatches, s_Agents);
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "TNAH/Renderer/RenderingBuffers.h"
+
+namespace tnah {
+
+	/**
+	 * @class	HeadlessVertexBuffer
+	 *
+	 * @brief	A vertex buffer of RendererAPI::API::None, it keeps its layout and drops the data
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessVertexBuffer : public VertexBuffer
+	{
+	public:
+		void Bind() const override {}
+		void Unbind() const override {}
+		void SetData(uint32_t size, const void* data, DrawType type = DrawType::STATIC, TypeMode mode = TypeMode::DRAW) const override {}
+		void CreateLayout(uint32_t location, BufferElement element, uint32_t stride) override {}
+		void DisableLayout(uint32_t location) override {}
+		const VertexBufferLayout& GetLayout() const override { return m_Layout; }
+		void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
+
+	private:
+		VertexBufferLayout m_Layout;
+	};
+
+	/**
+	 * @class	HeadlessIndexBuffer
+	 *
+	 * @brief	An index buffer of RendererAPI::API::None, it keeps its count and drops the indices
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessIndexBuffer : public IndexBuffer
+	{
+	public:
+		HeadlessIndexBuffer(uint32_t count) : m_Count(count) {}
+
+		void Bind() const override {}
+		void Unbind() const override {}
+		uint32_t GetCount() const override { return m_Count; }
+		int GetDataType() const override { return 0; }
+
+	private:
+		uint32_t m_Count;
+	};
+
+	/**
+	 * @class	HeadlessFramebuffer
+	 *
+	 * @brief	A framebuffer of RendererAPI::API::None, it keeps its specification and has no attachments
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessFramebuffer : public Framebuffer
+	{
+	public:
+		HeadlessFramebuffer(const FramebufferSpecification& spec) : m_Specification(spec) {}
+
+		const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+		void DrawToNext() override {}
+		uint32_t GetColorAttachment() const override { return 0; }
+		uint32_t GetColorAttachment(uint32_t attachmentNumber) const override { return 0; }
+		uint32_t GetTotalColorAttachments() const override { return 0; }
+		uint32_t GetDepthAttachmentID() const override { return 0; }
+		uint32_t GetDepthAttachmentID(uint32_t attachmentNumber) const override { return 0; }
+		uint32_t GetTotalDepthAttachments() const override { return 0; }
+		uint32_t GetRenderBufferID() const override { return 0; }
+		void SetRenderbufferSpecification(uint32_t bufferSlot, const RenderbufferSpecification& spec) override {}
+		uint32_t GetRendererID() const override { return 0; }
+		void Bind(uint32_t attachmentSlot = 0) override {}
+		void Unbind() override {}
+		void Rebuild(const FramebufferSpecification& spec) override { m_Specification = spec; }
+		void SelectDrawToBuffer(const FramebufferDrawMode& mode, uint32_t attachmentNumber) override {}
+		int GetFormatFromSpec(const FramebufferSpecification& spec) override { return 0; }
+
+	private:
+		FramebufferSpecification m_Specification;
+	};
+
+	/**
+	 * @class	HeadlessRenderbuffer
+	 *
+	 * @brief	A renderbuffer of RendererAPI::API::None, it holds nothing
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessRenderbuffer : public Renderbuffer
+	{
+	public:
+		uint32_t GetRendererID() const override { return 0; }
+		void Bind() override {}
+		void Unbind() override {}
+		void Rebuild(const RenderbufferSpecification& spec) override {}
+		void AttachToFramebuffer() override {}
+		int GetFormatFromSpecification(const RenderbufferSpecification& spec) override { return 0; }
+		int GetFramebufferFormatFromSpecification(const RenderbufferSpecification& spec) override { return 0; }
+	};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "TNAH/Renderer/RendererAPI.h"
+
+namespace tnah {
+
+	/**
+	 * @class	HeadlessRendererAPI
+	 *
+	 * @brief	The renderer api of RendererAPI::API::None. Every command is accepted and does nothing, so a scene
+	 * 			can be updated without a window or graphics context.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessRendererAPI : public RendererAPI
+	{
+	public:
+		void Init() override {}
+		void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override {}
+		void SetClearColor(const glm::vec4& color) override {}
+		void Clear() override {}
+		void Disable(const APIEnum& value) override {}
+		void Enable(const APIEnum& value) override {}
+		void DrawArray(const Ref<VertexArray>& vertexArray, const DrawMode& mode = DrawMode::Triangles) override {}
+		void DrawIndexed(const Ref<VertexArray>& vertexArray, const DrawMode& mode = DrawMode::Triangles, void* indicesStart = nullptr) override {}
+		void SetWireframe(const bool& enable) override {}
+		bool CheckFullScreen(const int& width, const int& height) override { return false; }
+		void SetCullMode(const CullMode& mode) override {}
+		void SetDepthMask(const bool& enabled) override {}
+		void SetDepthFunc(const DepthFunc& enabled) override {}
+
+	protected:
+		int ModeFromDrawMode(const DrawMode& mode) override { return 0; }
+	};
+}
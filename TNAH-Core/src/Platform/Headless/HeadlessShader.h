@@ -0,0 +1,48 @@
+#pragma once
+
+#include "TNAH/Renderer/Shader.h"
+
+namespace tnah {
+
+	/**
+	 * @class	HeadlessShader
+	 *
+	 * @brief	A shader of RendererAPI::API::None. It keeps its paths so the shader cache still finds it, but never
+	 * 			reads or compiles the source and drops every uniform.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessShader : public Shader
+	{
+	public:
+		HeadlessShader(const std::string& shaderFilePath)
+		{
+			m_FilePaths = { shaderFilePath, "SINGLE SHADER FILE" };
+			m_ShaderName = shaderFilePath;
+		}
+
+		HeadlessShader(const std::string& vertexSrc, const std::string& fragmentSrc)
+		{
+			m_FilePaths = { vertexSrc, fragmentSrc };
+			m_ShaderName = vertexSrc;
+		}
+
+		void Bind() override { m_Bound = true; }
+		void Unbind() override { m_Bound = false; }
+		bool IsBound() const override { return m_Bound; }
+		void SetBool(const std::string& name, bool value) override {}
+		void SetInt(const std::string& name, int value) override {}
+		void SetFloat(const std::string& name, float value) override {}
+		void SetVec2(const std::string& name, const glm::vec2& value) override {}
+		void SetVec3(const std::string& name, const glm::vec3& value) override {}
+		void SetVec4(const std::string& name, const glm::vec4& value) override {}
+		void SetMat3(const std::string& name, const glm::mat3& value) override {}
+		void SetMat4(const std::string& name, const glm::mat4& value) override {}
+		const std::string& GetName() const override { return m_ShaderName; }
+
+	private:
+		bool m_Bound = false;
+	};
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "TNAH/Renderer/Texture.h"
+
+namespace tnah {
+
+	/**
+	 * @class	HeadlessTexture2D
+	 *
+	 * @brief	A 2D texture of RendererAPI::API::None. It keeps the path and size it was made with but never loads
+	 * 			the image, so it reports itself as not loaded.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessTexture2D : public Texture2D
+	{
+	public:
+		HeadlessTexture2D(ImageFormat format, uint32_t width, uint32_t height, const void* data, TextureProperties properties)
+		{
+			m_Width = width;
+			m_Height = height;
+			m_Properties = properties;
+		}
+
+		HeadlessTexture2D(uint32_t width, uint32_t height)
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+
+		HeadlessTexture2D(const std::string& path, const std::string& textureName = "")
+		{
+			m_TextureResource = path;
+			m_TextureResource.CustomName = textureName;
+			m_UniformName = textureName;
+		}
+
+		ktxTexture* GetKtxData() const override { return nullptr; }
+		unsigned char* GetImageData() const override { return nullptr; }
+		void Free() override {}
+		void Free(void* data) override {}
+		void SetData(void* data, uint32_t size) override {}
+		void Bind(uint32_t slot) const override {}
+		void Bind() const override {}
+	};
+
+	/**
+	 * @class	HeadlessTexture3D
+	 *
+	 * @brief	A cubemap of RendererAPI::API::None, it keeps the name it was made with and nothing else
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessTexture3D : public Texture3D
+	{
+	public:
+		HeadlessTexture3D(const std::string& textureName)
+		{
+			m_TextureResource.CustomName = textureName;
+		}
+
+		ktxTexture* GetKtxData() const override { return nullptr; }
+		unsigned char* GetImageData() const override { return nullptr; }
+		void SetData(void* data, uint32_t size) override {}
+		void Bind(uint32_t slot) const override {}
+		void Bind() const override {}
+	};
+}
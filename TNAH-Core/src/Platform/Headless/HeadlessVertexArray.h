@@ -0,0 +1,36 @@
+#pragma once
+
+#include "TNAH/Core/Ref.h"
+#include "TNAH/Renderer/VertexArray.h"
+
+namespace tnah {
+
+	/**
+	 * @class	HeadlessVertexArray
+	 *
+	 * @brief	A vertex array of RendererAPI::API::None, it keeps the buffers given to it and nothing else
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class HeadlessVertexArray : public VertexArray
+	{
+	public:
+		void Bind() const override {}
+		void Unbind() const override {}
+		void SetID(const uint32_t& id) override {}
+		void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override { m_VertexBuffers.push_back(vertexBuffer); }
+		void UpdateVertexBuffer() override {}
+		void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override { m_IndexBuffer = indexBuffer; m_IndexSize = indexBuffer ? indexBuffer->GetCount() : 0; }
+		void SetIndexSize(const uint32_t& size) override { m_IndexSize = size; }
+		const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
+		const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+		uint32_t GetIndexSize() const override { return m_IndexSize; }
+
+	private:
+		std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+		Ref<IndexBuffer> m_IndexBuffer;
+		uint32_t m_IndexSize = 0;
+	};
+}
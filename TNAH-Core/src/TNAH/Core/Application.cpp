@@ -5,12 +5,14 @@
 #include "GLFW/glfw3.h"
 #include "GLFW/glfw3native.h"
 #include "TNAH/Audio/Audio.h"
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Core/Random.h"
 
 namespace tnah
 {
 	
 	Application* Application::s_Instance = nullptr;
-	std::deque<LogText> Application::logQueue = std::deque<LogText>();
+	GameLog Application::s_GameLog;
 	Application::Application(const std::string& name)
 	{
 		TNAH_CORE_ASSERT(!s_Instance, "Application already exists!");
@@ -20,6 +22,7 @@ namespace tnah
 		m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
  
 
+		JobSystem::Init();
 		Renderer::Init();
 		Audio::Init();
 
@@ -29,28 +32,23 @@ namespace tnah
 			PushOverlay(m_ImGuiLayer);
 		}
 
-		//seed for any rand() functions
-		srand(static_cast<unsigned>(time(0)));
-
-		for(int i = 0; i < 15; i++)
-		{
-			logQueue.push_back(LogText(" "));
-		}
+		// Picks the seed now rather than on the first draw, rand() is seeded along with it
+		Random::GetSeed();
 	}
 
 	Application::~Application()
 	{
+		JobSystem::Shutdown();
 	}
 
-	void Application::LogPush(LogText log)
+	void Application::LogPush(const LogText& log)
 	{
-		logQueue.pop_front();
-		logQueue.push_back(log);	
+		s_GameLog.Push(GameLog::s_PlainFormat, log.colour, log.text);
 	}
 
-	std::deque<LogText> Application::GetLogQueue()
+	GameLogView Application::GetLogView()
 	{
-		return logQueue;
+		return s_GameLog.GetView();
 	}
 
 
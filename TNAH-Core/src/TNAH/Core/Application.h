@@ -11,6 +11,7 @@
 
 
 #include "Timestep.h"
+#include "GameLog.h"
 
 #include "TNAH/Layers/ImGuiLayer.h"
 #include "TNAH/Renderer/Shader.h"
@@ -149,6 +150,19 @@ namespace tnah
 
 		inline static Application& Get() { return *s_Instance; }
 
+		/**
+		 * @fn	inline static bool Application::Exists()
+		 *
+		 * @brief	Checks if an application has been created, there is none during a headless run
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	True if there is an application.
+		 */
+
+		inline static bool Exists() { return s_Instance != nullptr; }
+
 		/**
 		 * @fn	inline Window& Application::GetWindow()
 		 *
@@ -216,9 +230,45 @@ namespace tnah
 
 		static std::pair<std::string, int> SaveFileAs(const char* fileName);
 
-		static void LogPush(LogText log);
-		
-		static std::deque<LogText> GetLogQueue();
+		/**
+		 * @fn	static void Application::LogPush(const LogText& log);
+		 *
+		 * @brief	Pushes a line of plain text to the game log, safe from any thread
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	log	The text and colour of the line.
+		 */
+
+		static void LogPush(const LogText& log);
+
+		/**
+		 * @fn	static GameLog& Application::GetGameLog()
+		 *
+		 * @brief	Gets the game log, for pushing lines with a format
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The game log.
+		 */
+
+		static GameLog& GetGameLog() { return s_GameLog; }
+
+		/**
+		 * @fn	static GameLogView Application::GetLogView();
+		 *
+		 * @brief	Gets the lines of the game log to show, oldest first. Only call from the UI thread, the view is
+		 * 			valid until the next call.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The view of the log.
+		 */
+
+		static GameLogView GetLogView();
 		/**
 		 * @fn	bool Application::CheckEditor() const
 		 *
@@ -352,7 +402,8 @@ namespace tnah
 		bool m_DebugModeEnabled = false;
 		bool m_DebugModeToggled = false;
 
-		static std::deque<LogText> logQueue;
+		/** @brief	The game log shown on screen */
+		static GameLog s_GameLog;
 		
 		
 		/** @brief	The pointer to the instance of the application */
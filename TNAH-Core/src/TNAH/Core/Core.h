@@ -2,7 +2,7 @@
 #include <memory>
 
 #ifdef TNAH_PLATFORM_WINDOWS
-	#if TNAH_DYNAMIC_LINK
+	#if TNAH_DYNAMIC_LINK && !defined(TNAH_STATIC_LINK)
 		#ifdef TNAH_BUILD_DLL
 			#define TNAH_API _declspec(dllexport)
 		#else
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "TNAH/Core/Core.h"
+#include "TNAH/Scene/AISimulation.h"
+
+#include <cstring>
 
 #ifdef TNAH_PLATFORM_WINDOWS
 
@@ -34,6 +37,10 @@
 	int main(int argc, char** argv)
 	{
 		tnah::Log::Init();
+
+		// A headless AI run never opens a window, so it is handled before the application is made
+		if(argc > 1 && std::strcmp(argv[1], "--ai-sim") == 0)
+			return tnah::AISimulation::RunFromCommandLine(argc, argv);
 		
 		auto app = tnah::CreateApplication();
 
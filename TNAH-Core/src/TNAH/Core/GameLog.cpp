@@ -0,0 +1,162 @@
+#include "tnahpch.h"
+#include "GameLog.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace tnah {
+
+	namespace
+	{
+		constexpr size_t s_MaxFormats = 256;
+
+		std::array<const char*, s_MaxFormats> s_Formats = { "{}" };
+		std::atomic<uint16_t> s_FormatCount = 1;
+		std::mutex s_FormatMutex;
+	}
+
+	void LogEntry::Add(int64_t value)
+	{
+		auto& argument = Arguments[ArgumentCount++];
+		argument.ArgType = LogArgument::Type::Int;
+		argument.Int = value;
+	}
+
+	void LogEntry::Add(double value)
+	{
+		auto& argument = Arguments[ArgumentCount++];
+		argument.ArgType = LogArgument::Type::Float;
+		argument.Float = value;
+	}
+
+	void LogEntry::Add(std::string_view value)
+	{
+		const size_t length = std::min(value.size(), s_TextCapacity - TextUsed);
+		std::memcpy(Text + TextUsed, value.data(), length);
+
+		auto& argument = Arguments[ArgumentCount++];
+		argument.ArgType = LogArgument::Type::Text;
+		argument.Text.Offset = TextUsed;
+		argument.Text.Length = static_cast<uint16_t>(length);
+		TextUsed += static_cast<uint16_t>(length);
+	}
+
+	GameLog::GameLog()
+	{
+		for(size_t i = 0; i < s_Capacity; i++)
+			m_Ring[i].Sequence.store(i, std::memory_order_relaxed);
+		m_History.fill(LogText(" "));
+	}
+
+	uint16_t GameLog::RegisterFormat(const char* format)
+	{
+		std::lock_guard<std::mutex> lock(s_FormatMutex);
+		const uint16_t count = s_FormatCount.load(std::memory_order_relaxed);
+		for(uint16_t i = 0; i < count; i++)
+		{
+			if(std::strcmp(s_Formats[i], format) == 0)
+				return i;
+		}
+
+		TNAH_CORE_ASSERT(count < s_MaxFormats, "Too many log formats");
+		s_Formats[count] = format;
+		s_FormatCount.store(count + 1, std::memory_order_release);
+		return count;
+	}
+
+	GameLog::Slot* GameLog::claim()
+	{
+		size_t position = m_Tail.load(std::memory_order_relaxed);
+		for(;;)
+		{
+			Slot& slot = m_Ring[position & (s_Capacity - 1)];
+			const size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+			if(difference == 0)
+			{
+				// The slot is free for this position, whoever moves the tail past it owns it
+				if(m_Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					return &slot;
+			}
+			else if(difference < 0)
+			{
+				// The reader has not got to this slot since it was last used, the ring is full
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			else
+			{
+				position = m_Tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void GameLog::publish(Slot* slot)
+	{
+		const size_t position = slot->Sequence.load(std::memory_order_relaxed);
+		slot->Sequence.store(position + 1, std::memory_order_release);
+	}
+
+	GameLogView GameLog::GetView()
+	{
+		// Find how far the published entries run, only the ones still on screen afterwards are worth formatting
+		size_t end = m_Head;
+		while(m_Ring[end & (s_Capacity - 1)].Sequence.load(std::memory_order_acquire) == end + 1)
+			end++;
+
+		const size_t firstShown = end - std::min(end - m_Head, s_HistorySize);
+		for(; m_Head < end; m_Head++)
+		{
+			Slot& slot = m_Ring[m_Head & (s_Capacity - 1)];
+			if(m_Head >= firstShown)
+			{
+				m_History[m_NextLine] = LogText(format(slot.Entry), slot.Entry.Colour);
+				m_NextLine = (m_NextLine + 1) % s_HistorySize;
+			}
+
+			// Hand the slot back for the position one lap on
+			slot.Sequence.store(m_Head + s_Capacity, std::memory_order_release);
+		}
+		return GameLogView(m_History.data(), s_HistorySize, m_NextLine);
+	}
+
+	std::string GameLog::format(const LogEntry& entry) const
+	{
+		const uint16_t count = s_FormatCount.load(std::memory_order_acquire);
+		const char* format = entry.Format < count ? s_Formats[entry.Format] : "{}";
+
+		std::string text;
+		size_t argument = 0;
+		for(const char* c = format; *c; c++)
+		{
+			if(c[0] != '{' || c[1] != '}')
+			{
+				text += *c;
+				continue;
+			}
+
+			c++;
+			if(argument >= entry.ArgumentCount)
+				continue;
+
+			const auto& value = entry.Arguments[argument++];
+			switch(value.ArgType)
+			{
+			case LogArgument::Type::Int:
+				text += std::to_string(value.Int);
+				break;
+			case LogArgument::Type::Float:
+			{
+				char number[32];
+				std::snprintf(number, sizeof(number), "%g", value.Float);
+				text += number;
+				break;
+			}
+			case LogArgument::Type::Text:
+				text.append(entry.Text + value.Text.Offset, value.Text.Length);
+				break;
+			}
+		}
+		return text;
+	}
+}
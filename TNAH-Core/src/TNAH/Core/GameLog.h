@@ -0,0 +1,246 @@
+#pragma once
+#include <atomic>
+#include <string_view>
+
+namespace tnah {
+
+	/**
+	 * @struct	LogArgument
+	 *
+	 * @brief	One argument of a log entry, kept unformatted until the entry is read
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct LogArgument
+	{
+		enum class Type : uint8_t { Int, Float, Text };
+
+		Type ArgType = Type::Int;
+		union
+		{
+			int64_t Int;
+			double Float;
+			struct { uint16_t Offset; uint16_t Length; } Text;
+		};
+
+		LogArgument() : Int(0) {}
+	};
+
+	/**
+	 * @struct	LogEntry
+	 *
+	 * @brief	A log line as it sits in the ring, the id of its format and the arguments that go in it. Text arguments
+	 * 			are copied into a small inline buffer so pushing never allocates, longer text is cut short.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct LogEntry
+	{
+		static constexpr size_t s_MaxArguments = 4;
+		static constexpr size_t s_TextCapacity = 128;
+
+		uint16_t Format = 0;
+		uint8_t ArgumentCount = 0;
+		glm::vec4 Colour = glm::vec4(1.0f);
+		std::array<LogArgument, s_MaxArguments> Arguments;
+		uint16_t TextUsed = 0;
+		char Text[s_TextCapacity];
+
+		void Add(int64_t value);
+		void Add(double value);
+		void Add(std::string_view value);
+
+		template<typename T>
+		void Add(const T& value)
+		{
+			if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+				Add(static_cast<int64_t>(value));
+			else if constexpr (std::is_floating_point_v<T>)
+				Add(static_cast<double>(value));
+			else
+				Add(std::string_view(value));
+		}
+	};
+
+	/**
+	 * @class	GameLogView
+	 *
+	 * @brief	The lines of the game log oldest first, read straight from the history the log keeps. Only valid until
+	 * 			the next call to GameLog::GetView.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class GameLogView
+	{
+	public:
+		GameLogView(const LogText* lines, size_t capacity, size_t first)
+			: m_Lines(lines), m_Capacity(capacity), m_First(first) {}
+
+		size_t size() const { return m_Capacity; }
+		const LogText& operator[](size_t index) const { return m_Lines[(m_First + index) % m_Capacity]; }
+
+		class Iterator
+		{
+		public:
+			Iterator(const GameLogView* view, size_t index) : m_View(view), m_Index(index) {}
+			const LogText& operator*() const { return (*m_View)[m_Index]; }
+			const LogText* operator->() const { return &(*m_View)[m_Index]; }
+			Iterator& operator++() { m_Index++; return *this; }
+			bool operator!=(const Iterator& other) const { return m_Index != other.m_Index; }
+		private:
+			const GameLogView* m_View;
+			size_t m_Index;
+		};
+
+		Iterator begin() const { return Iterator(this, 0); }
+		Iterator end() const { return Iterator(this, m_Capacity); }
+
+	private:
+		const LogText* m_Lines;
+		size_t m_Capacity;
+		size_t m_First;
+	};
+
+	/**
+	 * @class	GameLog
+	 *
+	 * @brief	The on screen game log. Any thread can push, the UI thread reads. Pushes go into a fixed size lock-free
+	 * 			multi producer single consumer ring, a slot costs a compare exchange on the tail and a store of its
+	 * 			sequence, and when the ring is full the line is dropped rather than waited on. The entries hold a format
+	 * 			id and raw arguments, the text is only built when the reader takes them into the history it shows.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class GameLog
+	{
+	public:
+
+		/** @brief	Lines shown */
+		static constexpr size_t s_HistorySize = 15;
+
+		/** @brief	Slots in the ring, a power of two */
+		static constexpr size_t s_Capacity = 256;
+
+		/** @brief	The format that prints its one argument as it is */
+		static constexpr uint16_t s_PlainFormat = 0;
+
+		/**
+		 * @fn	GameLog::GameLog();
+		 *
+		 * @brief	Constructor, the history starts as blank lines
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		GameLog();
+
+		/**
+		 * @fn	static uint16_t GameLog::RegisterFormat(const char* format);
+		 *
+		 * @brief	Registers a format, each {} in it is replaced by the next argument. Registering the same text
+		 * 			again gives back the same id. The text has to outlive the log, a string literal is best.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	format	The format.
+		 *
+		 * @returns	The id of the format.
+		 */
+
+		static uint16_t RegisterFormat(const char* format);
+
+		/**
+		 * @fn	template<typename... Args> bool GameLog::Push(uint16_t format, const glm::vec4& colour, const Args&... args);
+		 *
+		 * @brief	Pushes a line, safe from any thread
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	format	The id of the format.
+		 * @param 	colour	The colour of the line.
+		 * @param 	args	Numbers or text for the format, at most LogEntry::s_MaxArguments.
+		 *
+		 * @returns	False if the ring was full and the line was dropped.
+		 */
+
+		template<typename... Args>
+		bool Push(uint16_t format, const glm::vec4& colour, const Args&... args)
+		{
+			static_assert(sizeof...(Args) <= LogEntry::s_MaxArguments, "Too many log arguments");
+
+			Slot* slot = claim();
+			if(!slot)
+				return false;
+
+			LogEntry& entry = slot->Entry;
+			entry.Format = format;
+			entry.Colour = colour;
+			entry.ArgumentCount = 0;
+			entry.TextUsed = 0;
+			(entry.Add(args), ...);
+			publish(slot);
+			return true;
+		}
+
+		/**
+		 * @fn	GameLogView GameLog::GetView();
+		 *
+		 * @brief	Formats the lines pushed since the last call into the history and returns it. Only call from the
+		 * 			one thread that reads the log.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The view of the history.
+		 */
+
+		GameLogView GetView();
+
+		/**
+		 * @fn	uint64_t GameLog::GetDropped() const
+		 *
+		 * @brief	Gets the number of lines dropped because the ring was full
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The dropped count.
+		 */
+
+		uint64_t GetDropped() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+	private:
+
+		/** @brief	A slot of the ring, its sequence says whose turn it is */
+		struct Slot
+		{
+			std::atomic<size_t> Sequence;
+			LogEntry Entry;
+		};
+
+		Slot* claim();
+		void publish(Slot* slot);
+		std::string format(const LogEntry& entry) const;
+
+		/** @brief	The ring, the tail is shared by producers and the head only moved by the reader */
+		std::array<Slot, s_Capacity> m_Ring;
+		alignas(64) std::atomic<size_t> m_Tail = 0;
+		alignas(64) size_t m_Head = 0;
+		std::atomic<uint64_t> m_Dropped = 0;
+
+		/** @brief	The formatted lines shown, m_NextLine is the oldest */
+		std::array<LogText, s_HistorySize> m_History;
+		size_t m_NextLine = 0;
+	};
+}
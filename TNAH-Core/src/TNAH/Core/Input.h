@@ -29,7 +29,7 @@ namespace tnah {
 		 * @returns	True if key pressed, false if not.
 		 */
 
-		inline static bool IsKeyPressed(int keycode) { return s_Instance->IsKeyPressedImpl(keycode); }
+		inline static bool IsKeyPressed(int keycode) { return Get()->IsKeyPressedImpl(keycode); }
 
 		/**
 		 * @fn	inline static bool Input::IsMouseButtonPressed(int button)
@@ -44,7 +44,7 @@ namespace tnah {
 		 * @returns	True if mouse button pressed, false if not.
 		 */
 
-		inline static bool IsMouseButtonPressed(int button) { return s_Instance->IsMouseButtonPressedImpl(button); }
+		inline static bool IsMouseButtonPressed(int button) { return Get()->IsMouseButtonPressedImpl(button); }
 
 		/**
 		 * @fn	inline static float Input::GetMouseX()
@@ -57,7 +57,7 @@ namespace tnah {
 		 * @returns	The mouse x coordinate.
 		 */
 
-		inline static float GetMouseX() { return s_Instance->GetMouseXImpl(); }
+		inline static float GetMouseX() { return Get()->GetMouseXImpl(); }
 
 		/**
 		 * @fn	inline static float Input::GetMouseY()
@@ -70,7 +70,7 @@ namespace tnah {
 		 * @returns	The mouse y coordinate.
 		 */
 
-		inline static float GetMouseY() { return s_Instance->GetMouseYImpl(); }
+		inline static float GetMouseY() { return Get()->GetMouseYImpl(); }
 
 		/**
 		 * @fn	inline static std::pair<float, float> Input::GetMousePos()
@@ -83,7 +83,21 @@ namespace tnah {
 		 * @returns	The mouse position.
 		 */
 
-		inline static std::pair<float, float> GetMousePos() { return s_Instance->GetMousePosImpl(); }
+		inline static std::pair<float, float> GetMousePos() { return Get()->GetMousePosImpl(); }
+
+		/**
+		 * @fn	inline static void Input::SetOverride(Input* input)
+		 *
+		 * @brief	Answers every query from another input instead of the device, such as a recording being played
+		 * 			back. Null goes back to the device.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	input	The input to use, not owned.
+		 */
+
+		inline static void SetOverride(Input* input) { s_Override = input; }
 
 	protected:
 
@@ -158,8 +172,24 @@ namespace tnah {
 
 	private:
 
+		/**
+		 * @fn	inline static Input* Input::Get()
+		 *
+		 * @brief	Gets the input queries go to
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The override if one is set, else the device.
+		 */
+
+		inline static Input* Get() { return s_Override ? s_Override : s_Instance; }
+
 		/** @brief	The instance */
 		static Input* s_Instance;
+
+		/** @brief	The input used in place of the instance, may be null */
+		inline static Input* s_Override = nullptr;
 	};
 
 
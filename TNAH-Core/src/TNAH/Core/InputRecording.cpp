@@ -0,0 +1,130 @@
+#include "tnahpch.h"
+#include "InputRecording.h"
+
+#include <sstream>
+
+namespace tnah {
+
+	void InputRecording::Capture(uint32_t tick, const std::vector<int>& keys, const std::vector<int>& buttons)
+	{
+		Frame frame;
+		frame.Tick = tick;
+		std::tie(frame.MouseX, frame.MouseY) = Input::GetMousePos();
+		for(int key : keys)
+		{
+			if(Input::IsKeyPressed(key))
+				frame.Keys.push_back(key);
+		}
+		for(int button : buttons)
+		{
+			if(Input::IsMouseButtonPressed(button))
+				frame.Buttons.push_back(button);
+		}
+		std::sort(frame.Keys.begin(), frame.Keys.end());
+		std::sort(frame.Buttons.begin(), frame.Buttons.end());
+
+		if(!m_Frames.empty())
+		{
+			const Frame& last = m_Frames.back();
+			if(last.MouseX == frame.MouseX && last.MouseY == frame.MouseY && last.Keys == frame.Keys && last.Buttons == frame.Buttons)
+				return;
+		}
+		m_Frames.push_back(std::move(frame));
+	}
+
+	void InputRecording::SetTick(uint32_t tick)
+	{
+		// Ticks nearly always go up one at a time, so step from the current change before searching
+		if(m_Current >= 0 && m_Frames[m_Current].Tick <= tick)
+		{
+			while(m_Current + 1 < static_cast<int>(m_Frames.size()) && m_Frames[m_Current + 1].Tick <= tick)
+				m_Current++;
+			return;
+		}
+
+		const auto it = std::upper_bound(m_Frames.begin(), m_Frames.end(), tick, [](uint32_t t, const Frame& frame) { return t < frame.Tick; });
+		m_Current = static_cast<int>(it - m_Frames.begin()) - 1;
+	}
+
+	bool InputRecording::Save(const std::string& filePath) const
+	{
+		std::ofstream out(filePath);
+		if(!out)
+			return false;
+
+		for(const auto& frame : m_Frames)
+		{
+			out << frame.Tick << ' ' << frame.MouseX << ' ' << frame.MouseY;
+			for(int key : frame.Keys)
+				out << " k" << key;
+			for(int button : frame.Buttons)
+				out << " b" << button;
+			out << '\n';
+		}
+		return static_cast<bool>(out);
+	}
+
+	bool InputRecording::Load(const std::string& filePath)
+	{
+		std::ifstream in(filePath);
+		if(!in)
+		{
+			TNAH_CORE_ERROR("Could not open input recording {0}", filePath);
+			return false;
+		}
+
+		m_Frames.clear();
+		m_Current = -1;
+		std::string line;
+		while(std::getline(in, line))
+		{
+			std::istringstream stream(line);
+			Frame frame;
+			if(!(stream >> frame.Tick >> frame.MouseX >> frame.MouseY))
+				continue;
+
+			std::string token;
+			while(stream >> token)
+			{
+				if(token.size() < 2)
+					continue;
+				const int id = std::atoi(token.c_str() + 1);
+				if(token[0] == 'k')
+					frame.Keys.push_back(id);
+				else if(token[0] == 'b')
+					frame.Buttons.push_back(id);
+			}
+			std::sort(frame.Keys.begin(), frame.Keys.end());
+			std::sort(frame.Buttons.begin(), frame.Buttons.end());
+			m_Frames.push_back(std::move(frame));
+		}
+
+		std::stable_sort(m_Frames.begin(), m_Frames.end(), [](const Frame& a, const Frame& b) { return a.Tick < b.Tick; });
+		return true;
+	}
+
+	bool InputRecording::IsKeyPressedImpl(int keycode)
+	{
+		return m_Current >= 0 && std::binary_search(m_Frames[m_Current].Keys.begin(), m_Frames[m_Current].Keys.end(), keycode);
+	}
+
+	bool InputRecording::IsMouseButtonPressedImpl(int button)
+	{
+		return m_Current >= 0 && std::binary_search(m_Frames[m_Current].Buttons.begin(), m_Frames[m_Current].Buttons.end(), button);
+	}
+
+	float InputRecording::GetMouseXImpl()
+	{
+		return m_Current >= 0 ? m_Frames[m_Current].MouseX : 0.0f;
+	}
+
+	float InputRecording::GetMouseYImpl()
+	{
+		return m_Current >= 0 ? m_Frames[m_Current].MouseY : 0.0f;
+	}
+
+	std::pair<float, float> InputRecording::GetMousePosImpl()
+	{
+		return { GetMouseXImpl(), GetMouseYImpl() };
+	}
+}
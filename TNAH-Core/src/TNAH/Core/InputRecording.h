@@ -0,0 +1,118 @@
+#pragma once
+#include "TNAH/Core/Input.h"
+
+namespace tnah {
+
+	/**
+	 * @class	InputRecording
+	 *
+	 * @brief	Keys, mouse buttons and the mouse position over a run of fixed ticks. Captured from the device while
+	 * 			playing, then set as the input override to replay the same run. Only changes are stored, a tick with
+	 * 			no entry holds the state of the last one before it.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class InputRecording : public Input
+	{
+	public:
+
+		/**
+		 * @fn	void InputRecording::Capture(uint32_t tick, const std::vector<int>& keys, const std::vector<int>& buttons);
+		 *
+		 * @brief	Reads the device for the watched keys and buttons and stores the state if it changed
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	tick   	The tick being captured, ticks must go up.
+		 * @param 	keys   	The keys to watch.
+		 * @param 	buttons	The mouse buttons to watch.
+		 */
+
+		void Capture(uint32_t tick, const std::vector<int>& keys, const std::vector<int>& buttons);
+
+		/**
+		 * @fn	void InputRecording::SetTick(uint32_t tick);
+		 *
+		 * @brief	Sets the tick queries are answered for
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	tick	The tick.
+		 */
+
+		void SetTick(uint32_t tick);
+
+		/**
+		 * @fn	bool InputRecording::Save(const std::string& filePath) const;
+		 *
+		 * @brief	Saves the recording, one line per change of the tick, the mouse position, then k and b followed by
+		 * 			the id of each key and button held
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	filePath	Full pathname of the file.
+		 *
+		 * @returns	True if it succeeds, false if it fails.
+		 */
+
+		bool Save(const std::string& filePath) const;
+
+		/**
+		 * @fn	bool InputRecording::Load(const std::string& filePath);
+		 *
+		 * @brief	Loads a recording saved by Save
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	filePath	Full pathname of the file.
+		 *
+		 * @returns	True if it succeeds, false if it fails.
+		 */
+
+		bool Load(const std::string& filePath);
+
+		/**
+		 * @fn	size_t InputRecording::GetChangeCount() const
+		 *
+		 * @brief	Gets the number of stored changes
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The change count.
+		 */
+
+		size_t GetChangeCount() const { return m_Frames.size(); }
+
+	protected:
+		bool IsKeyPressedImpl(int keycode) override;
+		bool IsMouseButtonPressedImpl(int button) override;
+		float GetMouseXImpl() override;
+		float GetMouseYImpl() override;
+		std::pair<float, float> GetMousePosImpl() override;
+
+	private:
+
+		/** @brief	The state from a tick on, keys and buttons sorted */
+		struct Frame
+		{
+			uint32_t Tick = 0;
+			float MouseX = 0.0f;
+			float MouseY = 0.0f;
+			std::vector<int> Keys;
+			std::vector<int> Buttons;
+		};
+
+		/** @brief	Changes in tick order */
+		std::vector<Frame> m_Frames;
+
+		/** @brief	The change in effect for the current tick, -1 before the first */
+		int m_Current = -1;
+	};
+}
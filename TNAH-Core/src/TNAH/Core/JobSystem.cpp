@@ -0,0 +1,216 @@
+#include "tnahpch.h"
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace tnah {
+
+	namespace
+	{
+		struct WorkQueue
+		{
+			std::mutex Lock;
+			std::deque<Job> Jobs;
+		};
+
+		std::vector<std::unique_ptr<WorkQueue>> s_Queues;
+		std::vector<std::thread> s_Workers;
+		std::atomic<uint32_t> s_Queued = 0;
+		bool s_Running = false;
+		std::mutex s_SleepLock;
+		std::condition_variable s_Wake;
+
+		thread_local uint32_t t_Index = ~0u;
+	}
+
+	void JobSystem::Init(uint32_t workers)
+	{
+		if(!s_Queues.empty())
+			return;
+
+		t_Index = 0;
+		if(workers == 0)
+			workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+		if(workers == 0)
+			return;
+
+		for(uint32_t i = 0; i <= workers; i++)
+			s_Queues.push_back(std::make_unique<WorkQueue>());
+		s_Running = true;
+		for(uint32_t i = 1; i <= workers; i++)
+			s_Workers.emplace_back(workerLoop, i);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if(s_Queues.empty())
+		{
+			t_Index = ~0u;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_SleepLock);
+			s_Running = false;
+		}
+		s_Wake.notify_all();
+		for(auto& worker : s_Workers)
+			worker.join();
+
+		// The workers drain every queue before they stop, so nothing is left behind here
+		s_Workers.clear();
+		s_Queues.clear();
+		t_Index = ~0u;
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return s_Queues.empty() ? 1 : static_cast<uint32_t>(s_Queues.size());
+	}
+
+	bool JobSystem::IsJobThread()
+	{
+		return t_Index != ~0u;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		// Without workers every job runs on the thread that asked for it, so that thread is thread 0
+		if(s_Queues.empty())
+			return 0;
+		return t_Index < s_Queues.size() ? t_Index : static_cast<uint32_t>(s_Queues.size());
+	}
+
+	void JobSystem::Run(std::function<void()> function, JobCounter* counter, JobCounter* dependency)
+	{
+		Job job;
+		job.Function = std::move(function);
+		job.Counter = counter;
+		if(counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		if(dependency)
+		{
+			std::lock_guard<std::mutex> lock(dependency->m_Lock);
+			if(dependency->m_Count.load(std::memory_order_acquire) > 0)
+			{
+				dependency->m_Waiting.push_back(std::move(job));
+				return;
+			}
+		}
+		schedule(std::move(job));
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		const uint32_t index = t_Index;
+		const bool owned = index < s_Queues.size();
+		while(!counter.IsDone())
+		{
+			if(!owned || !runOne(index))
+				std::this_thread::yield();
+		}
+
+		// The last job may still be handing on the counter's waiting jobs, it is only free once that is done
+		std::lock_guard<std::mutex> lock(counter.m_Lock);
+	}
+
+	bool JobSystem::RunPending()
+	{
+		return t_Index < s_Queues.size() && runOne(t_Index);
+	}
+
+	void JobSystem::schedule(Job job)
+	{
+		if(s_Queues.empty())
+		{
+			execute(job);
+			return;
+		}
+
+		// Threads the system does not own hand their jobs to thread 0
+		const uint32_t index = t_Index < s_Queues.size() ? t_Index : 0;
+		{
+			std::lock_guard<std::mutex> lock(s_Queues[index]->Lock);
+			s_Queues[index]->Jobs.push_back(std::move(job));
+		}
+		s_Queued.fetch_add(1, std::memory_order_release);
+
+		// Taking the sleep lock means a worker about to sleep either sees the job or gets the notify
+		{
+			std::lock_guard<std::mutex> lock(s_SleepLock);
+		}
+		s_Wake.notify_one();
+	}
+
+	void JobSystem::execute(Job& job)
+	{
+		job.Function();
+
+		JobCounter* counter = job.Counter;
+		if(!counter)
+			return;
+
+		std::vector<Job> ready;
+		{
+			std::lock_guard<std::mutex> lock(counter->m_Lock);
+			if(counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				ready.swap(counter->m_Waiting);
+		}
+		for(auto& next : ready)
+			schedule(std::move(next));
+	}
+
+	bool JobSystem::runOne(uint32_t index)
+	{
+		Job job;
+		bool found = false;
+		{
+			WorkQueue& own = *s_Queues[index];
+			std::lock_guard<std::mutex> lock(own.Lock);
+			if(!own.Jobs.empty())
+			{
+				job = std::move(own.Jobs.back());
+				own.Jobs.pop_back();
+				found = true;
+			}
+		}
+
+		const size_t queues = s_Queues.size();
+		for(size_t i = 1; !found && i < queues; i++)
+		{
+			WorkQueue& other = *s_Queues[(index + i) % queues];
+			std::lock_guard<std::mutex> lock(other.Lock);
+			if(!other.Jobs.empty())
+			{
+				job = std::move(other.Jobs.front());
+				other.Jobs.pop_front();
+				found = true;
+			}
+		}
+
+		if(!found)
+			return false;
+
+		s_Queued.fetch_sub(1, std::memory_order_relaxed);
+		execute(job);
+		return true;
+	}
+
+	void JobSystem::workerLoop(uint32_t index)
+	{
+		t_Index = index;
+		while(true)
+		{
+			if(runOne(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_SleepLock);
+			s_Wake.wait(lock, [] { return s_Queued.load(std::memory_order_acquire) > 0 || !s_Running; });
+			if(!s_Running && s_Queued.load(std::memory_order_acquire) == 0)
+				return;
+		}
+	}
+}
@@ -0,0 +1,332 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace tnah {
+
+	class JobCounter;
+
+	/**
+	 * @struct	Job
+	 *
+	 * @brief	A function to run on the job system and the counter it counts down when it is done
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct Job
+	{
+		std::function<void()> Function;
+		JobCounter* Counter = nullptr;
+	};
+
+	/**
+	 * @class	JobCounter
+	 *
+	 * @brief	Counts the jobs run against it that have not finished yet. Other jobs can be held back until it
+	 * 			reaches zero, and JobSystem::Wait must be called before a counter on the stack goes out of scope.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		/**
+		 * @fn	bool JobCounter::IsDone() const
+		 *
+		 * @brief	Query if every job counted has finished
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	True if done, false if not.
+		 */
+
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+		/**
+		 * @fn	uint32_t JobCounter::GetCount() const
+		 *
+		 * @brief	Gets the number of jobs still to finish
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The count.
+		 */
+
+		uint32_t GetCount() const { return m_Count.load(std::memory_order_acquire); }
+
+	private:
+
+		/** @brief	The jobs still to finish */
+		std::atomic<uint32_t> m_Count = 0;
+
+		/** @brief	Guards the jobs waiting on this counter */
+		std::mutex m_Lock;
+
+		/** @brief	Jobs held back until the count reaches zero */
+		std::vector<Job> m_Waiting;
+
+		friend class JobSystem;
+	};
+
+	/**
+	 * @class	JobSystem
+	 *
+	 * @brief	Runs jobs over a pool of worker threads. Every thread has its own queue, it takes its newest job first
+	 * 			and steals the oldest ones from the others when it runs out. The thread that called Init is thread 0,
+	 * 			it has a queue too and runs jobs whenever it waits. Before Init every job runs straight away on the
+	 * 			thread that asked for it.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class JobSystem
+	{
+	public:
+
+		/**
+		 * @fn	static void JobSystem::Init(uint32_t workers = 0);
+		 *
+		 * @brief	Starts the worker threads, the calling thread becomes thread 0
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	workers	The number of workers, 0 for one less than the hardware threads.
+		 */
+
+		static void Init(uint32_t workers = 0);
+
+		/**
+		 * @fn	static void JobSystem::Shutdown();
+		 *
+		 * @brief	Finishes the queued jobs and stops the worker threads
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		static void Shutdown();
+
+		/**
+		 * @fn	static uint32_t JobSystem::GetThreadCount();
+		 *
+		 * @brief	Gets the number of threads that run jobs, the workers and thread 0
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The thread count, 1 before Init.
+		 */
+
+		static uint32_t GetThreadCount();
+
+		/**
+		 * @fn	static uint32_t JobSystem::GetThreadIndex();
+		 *
+		 * @brief	Gets the index of the calling thread, for picking per thread scratch space
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The index, 0 before Init and GetThreadCount() for threads the system does not own.
+		 */
+
+		static uint32_t GetThreadIndex();
+
+		/**
+		 * @fn	static bool JobSystem::IsJobThread();
+		 *
+		 * @brief	Checks if the calling thread is thread 0 or one of the workers. Thread 0 counts from Init even
+		 * 			when there are no workers.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	True if the system owns the thread.
+		 */
+
+		static bool IsJobThread();
+
+		/**
+		 * @fn	static void JobSystem::Run(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+		 *
+		 * @brief	Queues a job
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	function  	The function to run.
+		 * @param 	counter   	If not null, counts the job until it has run.
+		 * @param 	dependency	If not null, the job is only queued once this counter reaches zero.
+		 */
+
+		static void Run(std::function<void()> function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+		/**
+		 * @fn	static void JobSystem::Wait(JobCounter& counter);
+		 *
+		 * @brief	Runs queued jobs until the counter reaches zero
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	counter	The counter.
+		 */
+
+		static void Wait(JobCounter& counter);
+
+		/**
+		 * @fn	static bool JobSystem::RunPending();
+		 *
+		 * @brief	Runs one queued job on the calling thread, for loops that wait on something other than a counter
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	True if a job was run, false if there was none or the thread is not owned by the system.
+		 */
+
+		static bool RunPending();
+
+		/**
+		 * @fn	template<typename Function> static void JobSystem::ParallelFor(size_t count, size_t grain, const Function& function)
+		 *
+		 * @brief	Splits 0 to count into chunks of at least the grain and calls function(begin, end) for each one
+		 * 			across the threads, returning once every chunk is done. The calling thread takes the first chunk.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	count   	The number of items.
+		 * @param 	grain   	The fewest items worth a job of their own.
+		 * @param 	function	The function, called with the begin and end of a chunk.
+		 */
+
+		template<typename Function>
+		static void ParallelFor(size_t count, size_t grain, const Function& function)
+		{
+			if(count == 0)
+				return;
+
+			// A few chunks per thread so threads that finish early can steal from slow ones
+			const size_t threads = GetThreadCount();
+			const size_t chunk = std::max<size_t>(std::max<size_t>(grain, 1), (count + threads * 4 - 1) / (threads * 4));
+			if(threads == 1 || chunk >= count)
+			{
+				function(size_t(0), count);
+				return;
+			}
+
+			JobCounter counter;
+			for(size_t begin = chunk; begin < count; begin += chunk)
+			{
+				const size_t end = std::min(count, begin + chunk);
+				Run([&function, begin, end]() { function(begin, end); }, &counter);
+			}
+			function(size_t(0), chunk);
+			Wait(counter);
+		}
+
+		/**
+		 * @fn	template<typename Range, typename Function> static void JobSystem::ParallelForEach(const Range& range, size_t grain, const Function& function)
+		 *
+		 * @brief	Calls function(item) for every item of a range such as an entt view or group, across the threads.
+		 * 			The items are gathered first, so the function may read and write the components of its own
+		 * 			entity but must not add or remove components from the registry.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	range   	The range.
+		 * @param 	grain   	The fewest items worth a job of their own.
+		 * @param 	function	The function, called with each item.
+		 */
+
+		template<typename Range, typename Function>
+		static void ParallelForEach(const Range& range, size_t grain, const Function& function)
+		{
+			std::vector<std::decay_t<decltype(*std::begin(range))>> items;
+			for(auto item : range)
+				items.push_back(item);
+
+			ParallelFor(items.size(), grain, [&items, &function](size_t begin, size_t end)
+			{
+				for(size_t i = begin; i < end; i++)
+					function(items[i]);
+			});
+		}
+
+	private:
+
+		/**
+		 * @fn	static void JobSystem::schedule(Job job);
+		 *
+		 * @brief	Puts a job whose dependency is met on the queue of the calling thread, or runs it if there are
+		 * 			no workers
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	job	The job.
+		 */
+
+		static void schedule(Job job);
+
+		/**
+		 * @fn	static void JobSystem::execute(Job& job);
+		 *
+		 * @brief	Runs a job, then counts it down and queues the jobs that were waiting on its counter
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	job	The job.
+		 */
+
+		static void execute(Job& job);
+
+		/**
+		 * @fn	static bool JobSystem::runOne(uint32_t index);
+		 *
+		 * @brief	Runs the newest job of the thread's own queue, or steals the oldest job of another
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	index	The index of the calling thread.
+		 *
+		 * @returns	True if a job was run, false if every queue was empty.
+		 */
+
+		static bool runOne(uint32_t index);
+
+		/**
+		 * @fn	static void JobSystem::workerLoop(uint32_t index);
+		 *
+		 * @brief	Runs jobs on a worker thread, sleeping while there are none
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	index	The index of the worker.
+		 */
+
+		static void workerLoop(uint32_t index);
+	};
+}
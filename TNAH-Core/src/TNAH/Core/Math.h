@@ -2,6 +2,7 @@
 #define USE_MATH_DEFINES
 
 #include "TNAH/Core/Core.h"
+#include "TNAH/Core/Random.h"
 #pragma warning(push, 0)
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
@@ -252,8 +253,7 @@ namespace tnah {
 
 		static float Random()
 		{
-			float r = static_cast <float> (rand()) / static_cast <float> (RAND_MAX);
-			return r;
+			return tnah::Random::Float();
 		}
 
 		/**
@@ -271,8 +271,7 @@ namespace tnah {
 
 		static float Random(const float& max)
 		{
-			float r2 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX/max));
-			return r2;
+			return tnah::Random::Float(0.0f, max);
 		}
 
 		/**
@@ -291,8 +290,7 @@ namespace tnah {
 
 		static float Random(const float& min, const float& max)
 		{
-			float r3 = min + static_cast <float> (rand()) /( static_cast <float> (RAND_MAX/(max-min)));
-			return r3;
+			return tnah::Random::Float(min, max);
 		}
 	}
 
@@ -0,0 +1,130 @@
+#include "tnahpch.h"
+#include "Random.h"
+
+#include "TNAH/Core/JobSystem.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace tnah {
+
+	namespace
+	{
+		std::atomic<uint64_t> s_Seed = 0;
+		std::atomic<bool> s_Seeded = false;
+		std::atomic<uint32_t> s_Generation = 0;
+		std::atomic<uint32_t> s_OtherThreads = 0;
+		std::mutex s_SeedLock;
+
+		/** Threads the job system does not own take streams from here up, in the order they first draw */
+		constexpr uint32_t s_OtherStreams = 256;
+
+		uint64_t splitMix(uint64_t& state)
+		{
+			uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		struct ThreadEngine
+		{
+			RandomEngine Engine;
+			uint32_t Generation = ~0u;
+			uint32_t Stream = ~0u;
+			uint32_t OtherStream = ~0u;
+		};
+
+		thread_local ThreadEngine t_Engine;
+	}
+
+	void RandomEngine::Seed(uint64_t seed, uint64_t stream)
+	{
+		uint64_t state = seed;
+		uint64_t mix = splitMix(state) ^ stream;
+		for(auto& word : m_State)
+			word = splitMix(mix);
+	}
+
+	void RandomEngine::Jump()
+	{
+		static constexpr uint64_t s_Jump[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+
+		uint64_t state[4] = {};
+		for(uint64_t jump : s_Jump)
+		{
+			for(int bit = 0; bit < 64; bit++)
+			{
+				if(jump & (1ull << bit))
+				{
+					for(int i = 0; i < 4; i++)
+						state[i] ^= m_State[i];
+				}
+				(*this)();
+			}
+		}
+		for(int i = 0; i < 4; i++)
+			m_State[i] = state[i];
+	}
+
+	void Random::Seed(uint64_t seed)
+	{
+		std::lock_guard<std::mutex> lock(s_SeedLock);
+		s_Seed.store(seed);
+		s_Seeded.store(true);
+		s_Generation.fetch_add(1);
+		srand(static_cast<unsigned>(seed));
+	}
+
+	uint64_t Random::GetSeed()
+	{
+		if(!s_Seeded.load())
+		{
+			// The seed is stored before the flag, so anyone who sees the flag also sees the seed
+			std::lock_guard<std::mutex> lock(s_SeedLock);
+			if(!s_Seeded.load())
+			{
+				std::random_device device;
+				const uint64_t seed = (static_cast<uint64_t>(device()) << 32) | device();
+				s_Seed.store(seed);
+				s_Seeded.store(true);
+				srand(static_cast<unsigned>(seed));
+			}
+		}
+		return s_Seed.load();
+	}
+
+	RandomEngine& Random::GetEngine()
+	{
+		// Job threads use the stream of their index, thread 0 being stream 0, so the streams do not depend on which thread drew first
+		uint32_t stream;
+		if(JobSystem::IsJobThread())
+		{
+			stream = JobSystem::GetThreadIndex();
+		}
+		else
+		{
+			if(t_Engine.OtherStream == ~0u)
+				t_Engine.OtherStream = s_OtherStreams + s_OtherThreads.fetch_add(1);
+			stream = t_Engine.OtherStream;
+		}
+
+		const uint32_t generation = s_Generation.load(std::memory_order_relaxed);
+		if(t_Engine.Generation != generation || t_Engine.Stream != stream)
+		{
+			// Each stream is a jump further along, so no two threads ever draw the same run of numbers
+			t_Engine.Engine.Seed(GetSeed());
+			for(uint32_t i = 0; i < stream; i++)
+				t_Engine.Engine.Jump();
+			t_Engine.Generation = generation;
+			t_Engine.Stream = stream;
+		}
+		return t_Engine.Engine;
+	}
+
+	RandomEngine Random::CreateStream(uint64_t stream)
+	{
+		// Stream 0 is the one the threads jump from, so these start at 1
+		return RandomEngine(GetSeed(), stream + 1);
+	}
+}
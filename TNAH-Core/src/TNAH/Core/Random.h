@@ -0,0 +1,334 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace tnah {
+
+	/**
+	 * @class	RandomEngine
+	 *
+	 * @brief	A xoshiro256** generator. Small enough to keep one per thread and fast enough to call per cell,
+	 * 			it also meets the standard's bit generator requirements so it can drive the std distributions.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class RandomEngine
+	{
+	public:
+		using result_type = uint64_t;
+
+		/**
+		 * @fn	explicit RandomEngine::RandomEngine(uint64_t seed = 0, uint64_t stream = 0)
+		 *
+		 * @brief	Constructor
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	seed  	The seed.
+		 * @param 	stream	The stream of the seed to start on.
+		 */
+
+		explicit RandomEngine(uint64_t seed = 0, uint64_t stream = 0)
+		{
+			Seed(seed, stream);
+		}
+
+		/**
+		 * @fn	void RandomEngine::Seed(uint64_t seed, uint64_t stream = 0);
+		 *
+		 * @brief	Fills the state from the seed and the stream. Different streams start from unrelated states,
+		 * 			use Jump instead when they must be proven apart.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	seed  	The seed.
+		 * @param 	stream	The stream.
+		 */
+
+		void Seed(uint64_t seed, uint64_t stream = 0);
+
+		/**
+		 * @fn	void RandomEngine::Jump();
+		 *
+		 * @brief	Skips ahead 2^128 numbers, onto the next stream
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		void Jump();
+
+		/**
+		 * @fn	uint64_t RandomEngine::operator()()
+		 *
+		 * @brief	Gets the next number
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The number.
+		 */
+
+		uint64_t operator()()
+		{
+			const uint64_t result = rotl(m_State[1] * 5, 7) * 9;
+			const uint64_t t = m_State[1] << 17;
+			m_State[2] ^= m_State[0];
+			m_State[3] ^= m_State[1];
+			m_State[1] ^= m_State[2];
+			m_State[0] ^= m_State[3];
+			m_State[2] ^= t;
+			m_State[3] = rotl(m_State[3], 45);
+			return result;
+		}
+
+		/**
+		 * @fn	uint32_t RandomEngine::Below(uint32_t bound)
+		 *
+		 * @brief	Gets a number from 0 up to but not including the bound, with no bias and almost never more than
+		 * 			one draw
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	bound	The bound, must not be 0.
+		 *
+		 * @returns	The number.
+		 */
+
+		uint32_t Below(uint32_t bound)
+		{
+			uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+			uint32_t low = static_cast<uint32_t>(product);
+			if(low < bound)
+			{
+				const uint32_t threshold = (0u - bound) % bound;
+				while(low < threshold)
+				{
+					product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+					low = static_cast<uint32_t>(product);
+				}
+			}
+			return static_cast<uint32_t>(product >> 32);
+		}
+
+		/**
+		 * @fn	int RandomEngine::Range(int min, int max)
+		 *
+		 * @brief	Gets a number between the min and max, both included
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	min	The minimum.
+		 * @param 	max	The maximum.
+		 *
+		 * @returns	The number.
+		 */
+
+		int Range(int min, int max)
+		{
+			if(max <= min)
+				return min;
+			const uint32_t span = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1u;
+			// A span of 0 means every int is allowed
+			const uint32_t offset = span ? Below(span) : static_cast<uint32_t>((*this)() >> 32);
+			return static_cast<int>(static_cast<uint32_t>(min) + offset);
+		}
+
+		/**
+		 * @fn	float RandomEngine::Float()
+		 *
+		 * @brief	Gets a float from 0 up to but not including 1
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The float.
+		 */
+
+		float Float()
+		{
+			return static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+		}
+
+		/**
+		 * @fn	float RandomEngine::Float(float min, float max)
+		 *
+		 * @brief	Gets a float from the min up to the max
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	min	The minimum.
+		 * @param 	max	The maximum.
+		 *
+		 * @returns	The float.
+		 */
+
+		float Float(float min, float max)
+		{
+			return min + (max - min) * Float();
+		}
+
+		/**
+		 * @fn	double RandomEngine::Double()
+		 *
+		 * @brief	Gets a double from 0 up to but not including 1
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The double.
+		 */
+
+		double Double()
+		{
+			return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0);
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	private:
+		static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+		/** @brief	The generator state, never all zero */
+		uint64_t m_State[4];
+	};
+
+	/**
+	 * @class	Random
+	 *
+	 * @brief	The engine's random numbers. Every thread gets its own engine on its own stream of the global seed.
+	 * 			Threads of the job system use the stream of their thread index, the thread that called
+	 * 			JobSystem::Init being stream 0, and any other thread gets one past the job threads' streams in the
+	 * 			order they first draw. Setting the seed makes a run repeatable as long as the same threads draw the
+	 * 			same numbers. Seeding also seeds rand() for any library still using it.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class Random
+	{
+	public:
+
+		/**
+		 * @fn	static void Random::Seed(uint64_t seed);
+		 *
+		 * @brief	Sets the seed, every engine is reseeded the next time it is used
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	seed	The seed.
+		 */
+
+		static void Seed(uint64_t seed);
+
+		/**
+		 * @fn	static uint64_t Random::GetSeed();
+		 *
+		 * @brief	Gets the seed, picked from the random device and given to rand() the first time if none was set
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The seed.
+		 */
+
+		static uint64_t GetSeed();
+
+		/**
+		 * @fn	static RandomEngine& Random::GetEngine();
+		 *
+		 * @brief	Gets the engine of the calling thread
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The engine.
+		 */
+
+		static RandomEngine& GetEngine();
+
+		/**
+		 * @fn	static RandomEngine Random::CreateStream(uint64_t stream);
+		 *
+		 * @brief	Creates an engine of its own for something that must draw the same numbers whichever thread
+		 * 			runs it. Streams are kept apart from the ones the threads use.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	stream	The stream.
+		 *
+		 * @returns	The new engine.
+		 */
+
+		static RandomEngine CreateStream(uint64_t stream);
+
+		/**
+		 * @fn	static uint64_t Random::Next()
+		 *
+		 * @brief	Gets the next 64 random bits of the calling thread
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The bits.
+		 */
+
+		static uint64_t Next() { return GetEngine()(); }
+
+		/**
+		 * @fn	static int Random::Range(int min, int max)
+		 *
+		 * @brief	Gets a number between the min and max, both included
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	min	The minimum.
+		 * @param 	max	The maximum.
+		 *
+		 * @returns	The number.
+		 */
+
+		static int Range(int min, int max) { return GetEngine().Range(min, max); }
+
+		/**
+		 * @fn	static float Random::Float()
+		 *
+		 * @brief	Gets a float from 0 up to but not including 1
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The float.
+		 */
+
+		static float Float() { return GetEngine().Float(); }
+
+		/**
+		 * @fn	static float Random::Float(float min, float max)
+		 *
+		 * @brief	Gets a float from the min up to the max
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	min	The minimum.
+		 * @param 	max	The maximum.
+		 *
+		 * @returns	The float.
+		 */
+
+		static float Float(float min, float max) { return GetEngine().Float(min, max); }
+	};
+}
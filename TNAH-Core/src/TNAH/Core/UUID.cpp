@@ -1,16 +1,12 @@
 #include "tnahpch.h"
 #include "UUID.h"
 
-#include <random>
+#include "Random.h"
 
 namespace tnah {
 
-	static std::random_device s_RandomDevice;
-	static std::mt19937_64 eng(s_RandomDevice());
-	static std::uniform_int_distribution<uint64_t> s_UniformDistribution;
-
 	UUID::UUID()
-		: m_UUID(s_UniformDistribution(eng))
+		: m_UUID(Random::Next())
 	{
 	}
 
@@ -26,8 +26,9 @@ namespace tnah {
 		
 		if(object.HasComponent<TagComponent>())
 		{
-			auto& tag = object.GetComponent<TagComponent>();
-			DrawTextControl("Name", tag.Tag);
+			std::string name = object.GetComponent<TagComponent>().Tag;
+			if(DrawTextControl("Name", name))
+				object.SetTag(name);
 			ImGui::Separator();
 		}
 		
@@ -1,6 +1,7 @@
 #include "tnahpch.h"
 #include "RendererAPI.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
+#include "Platform/Headless/HeadlessRendererAPI.h"
 
 namespace tnah {
 
@@ -11,7 +12,7 @@ namespace tnah {
 	{
 		switch (s_API)
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return CreateScope<HeadlessRendererAPI>();
 		case RendererAPI::API::OpenGL:  return CreateScope<OpenGLRendererAPI>();
 		}
 
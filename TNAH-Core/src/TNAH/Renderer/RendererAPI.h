@@ -283,6 +283,21 @@ namespace tnah {
 
 		static API GetAPI() { return s_API; }
 
+		/**
+		 * @fn	static void RendererAPI::SetAPI(API api)
+		 *
+		 * @brief	Sets the api every render resource is created for. API::None creates headless resources that
+		 * 			hold their data but never touch a graphics context, so scenes can be loaded without a window.
+		 * 			Must be set before anything is created.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	api	The api.
+		 */
+
+		static void SetAPI(API api) { s_API = api; }
+
 		/**
 		 * @fn	static Scope<RendererAPI> RendererAPI::Create();
 		 *
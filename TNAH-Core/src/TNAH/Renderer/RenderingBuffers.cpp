@@ -4,6 +4,7 @@
 #include "TNAH/Renderer/Renderer.h"
 
 #include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/Headless/HeadlessBuffer.h"
 #include <glm/glm.hpp>
 
 namespace tnah {
@@ -53,7 +54,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessVertexBuffer>::Create();
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create();
 		}
 
@@ -65,7 +66,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return Ref<HeadlessVertexBuffer>::Create();
 			case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(vertices, size);
 		}
 
@@ -77,7 +78,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessVertexBuffer>::Create();
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(vertices, size);
 		}
 
@@ -90,7 +91,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return Ref<HeadlessIndexBuffer>::Create(size);
 			case RendererAPI::API::OpenGL:  return Ref<OpenGLIndexBuffer>::Create(indices, size);
 		}
 
@@ -102,7 +103,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return Ref<HeadlessIndexBuffer>::Create(size);
 			case RendererAPI::API::OpenGL:  return Ref<OpenGLIndexBuffer>::Create(indices, size);
 		}
 
@@ -114,7 +115,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessIndexBuffer>::Create(size);
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLIndexBuffer>::Create(size);
 		}
 
@@ -127,7 +128,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessFramebuffer>::Create(spec);
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLFramebuffer>::Create(spec, colorAttachments, depthAttachments);
 		}
 
@@ -139,7 +140,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessFramebuffer>::Create(spec);
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLFramebuffer>::Create(spec, colorAttachments, colorSpecs);
 		}
 
@@ -151,7 +152,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessFramebuffer>::Create(spec);
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLFramebuffer>::Create(spec, renderSpec);
 		}
 
@@ -163,7 +164,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessRenderbuffer>::Create();
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLRenderBuffer>::Create(renderSpec);
 		}
 
@@ -4,6 +4,7 @@
 
 #include "TNAH/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/Headless/HeadlessShader.h"
 
 namespace tnah {
 
@@ -14,7 +15,12 @@ namespace tnah {
 		{
 			switch (Renderer::GetAPI())
 			{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:
+			{
+				Ref<Shader> ref = Ref<HeadlessShader>::Create(filepath);
+				Renderer::RegisterShader(ref);
+				return ref;
+			}
 			case RendererAPI::API::OpenGL:  
 				Ref<Shader> ref = Ref<OpenGLShader>::Create(filepath);
 				Renderer::RegisterShader(ref);
@@ -33,7 +39,12 @@ namespace tnah {
 		{
 			switch (Renderer::GetAPI())
 			{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:
+			{
+				Ref<Shader> ref = Ref<HeadlessShader>::Create(vertexSrc, fragmentSrc);
+				Renderer::RegisterShader(ref);
+				return ref;
+			}
 			case RendererAPI::API::OpenGL:
 				Ref<Shader> ref = Ref<OpenGLShader>::Create(vertexSrc, fragmentSrc);
 				Renderer::RegisterShader(ref);
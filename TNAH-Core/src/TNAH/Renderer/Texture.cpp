@@ -3,6 +3,7 @@
 #include "TNAH/Renderer/Image.h"
 #include "TNAH/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Platform/Headless/HeadlessTexture.h"
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 	#define STB_IMAGE_IMPLEMENTATION
@@ -15,7 +16,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    return Ref<HeadlessTexture2D>::Create(format, width, height, data, properties);
 		case RendererAPI::API::OpenGL:  return Ref<OpenGLTexture2D>::Create(format, width, height, data, properties);
 		}
 
@@ -213,7 +214,7 @@ namespace tnah {
 		Ref<Texture2D> t = nullptr;
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    t = Ref<HeadlessTexture2D>::Create(width, height); break;
 			case RendererAPI::API::OpenGL:  t =  Ref<OpenGLTexture2D>::Create(width, height);
 		}
 
@@ -232,7 +233,7 @@ namespace tnah {
 		Ref<Texture2D> t = nullptr;
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    t = Ref<HeadlessTexture2D>::Create(path, textureName); break;
 			case RendererAPI::API::OpenGL:  t = Ref<OpenGLTexture2D>::Create(path, textureName, loadFromMemory, assimpTexture);
 		}
 		if(t != nullptr)
@@ -252,7 +253,7 @@ namespace tnah {
 		Ref<Texture3D> t = nullptr;
 		switch (Renderer::GetAPI())
 		{
-		case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+		case RendererAPI::API::None:    t = Ref<HeadlessTexture3D>::Create(textureName); break;
 		case RendererAPI::API::OpenGL:  t = Ref<OpenGLTexture3D>::Create(paths, textureName);
 		}
 
@@ -270,7 +271,7 @@ namespace tnah {
 		Ref<Texture3D> t = nullptr;
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    t = Ref<HeadlessTexture3D>::Create(textureName); break;
 			case RendererAPI::API::OpenGL:  t = Ref<OpenGLTexture3D>::Create(properties, textureName);
 		}
 
@@ -3,6 +3,7 @@
 
 #include "TNAH/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
+#include "Platform/Headless/HeadlessVertexArray.h"
 
 namespace tnah {
 
@@ -10,7 +11,7 @@ namespace tnah {
 	{
 		switch (Renderer::GetAPI())
 		{
-			case RendererAPI::API::None:    TNAH_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::None:    return new HeadlessVertexArray();
 			case RendererAPI::API::OpenGL:  return new OpenGLVertexArray();
 		}
 
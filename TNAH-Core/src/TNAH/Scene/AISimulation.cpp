@@ -0,0 +1,179 @@
+#include "tnahpch.h"
+#include "AISimulation.h"
+
+#include "Serializer.h"
+#include "TNAH/Core/InputRecording.h"
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Core/Random.h"
+#include "TNAH/Core/Timer.h"
+#include "TNAH/Renderer/RendererAPI.h"
+#include "Components/AI/AStar.h"
+#include "Components/AI/HPAStar.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace tnah {
+
+	static AISystemTiming Summarise(const char* name, std::vector<float>& samples)
+	{
+		AISystemTiming timing;
+		timing.Name = name;
+		if(samples.empty())
+			return timing;
+
+		std::sort(samples.begin(), samples.end());
+		const auto at = [&](float percentile)
+		{
+			return samples[static_cast<size_t>(percentile * static_cast<float>(samples.size() - 1))];
+		};
+		timing.P50 = at(0.5f);
+		timing.P90 = at(0.9f);
+		timing.P99 = at(0.99f);
+		timing.Max = samples.back();
+		double total = 0.0;
+		for(float sample : samples)
+			total += sample;
+		timing.Mean = static_cast<float>(total / static_cast<double>(samples.size()));
+		return timing;
+	}
+
+	std::string AISimulationReport::ToString() const
+	{
+		std::stringstream ss;
+		ss << "AI simulation, " << Ticks << " ticks, seed " << Seed << ", checksum " << std::hex << Checksum << std::dec << "\n";
+		ss << std::fixed << std::setprecision(3);
+		ss << std::left << std::setw(12) << "System" << std::right
+			<< std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+			<< std::setw(10) << "max" << std::setw(10) << "mean" << "\n";
+		for(const auto& system : Systems)
+		{
+			ss << std::left << std::setw(12) << system.Name << std::right
+				<< std::setw(10) << system.P50 << std::setw(10) << system.P90 << std::setw(10) << system.P99
+				<< std::setw(10) << system.Max << std::setw(10) << system.Mean << "\n";
+		}
+		return ss.str();
+	}
+
+	AISimulationReport AISimulation::Run(const AISimulationSettings& settings)
+	{
+		// The seed has to be set before loading, the scene draws random numbers while it is built
+		Random::Seed(settings.Seed);
+		Ref<Scene> scene = Serializer::LoadScene(settings.ScenePath);
+		if(!scene)
+		{
+			TNAH_CORE_ERROR("AI simulation could not load the scene {}", settings.ScenePath);
+			return {};
+		}
+		return Run(scene, settings);
+	}
+
+	AISimulationReport AISimulation::Run(Ref<Scene> scene, const AISimulationSettings& settings)
+	{
+		AISimulationReport report;
+		report.Seed = settings.Seed;
+
+		// An empty recording holds nothing down, so a run never reads the real devices
+		InputRecording recording;
+		if(!settings.InputPath.empty() && !recording.Load(settings.InputPath))
+			TNAH_CORE_WARN("AI simulation could not load the input recording {}", settings.InputPath);
+		Input::SetOverride(&recording);
+
+		// The viewer is the scene camera, the AI level of detail is measured from it
+		glm::vec3 viewerPosition = {};
+		glm::vec3 viewerForward = {0.0f, 0.0f, -1.0f};
+		auto& registry = scene->GetRegistry();
+		auto cameras = registry.view<TransformComponent, CameraComponent>();
+		for(auto entity : cameras)
+		{
+			auto& transform = cameras.get<TransformComponent>(entity);
+			viewerPosition = transform.Position;
+			viewerForward = transform.Forward;
+		}
+
+		std::array<std::vector<float>, AISystemCount> samples;
+		std::vector<float> totals;
+		for(auto& system : samples)
+			system.reserve(settings.Ticks);
+		totals.reserve(settings.Ticks);
+
+		// The grids are baked on the first tick, their hierarchy is built there rather than picked up whenever a job
+		// finishes and the path service runs a fixed number of slices from the start
+		const bool buildInBackground = AStar::GetBuildInBackground();
+		AStar::SetBuildInBackground(false);
+		AStar::SetPathSliceBudget(settings.PathSlices);
+		if(auto hierarchy = AStar::GetHierarchy())
+			hierarchy->WaitForBuild();
+
+		const Timestep tick(settings.TickLength);
+		for(uint32_t i = 0; i < settings.Ticks; i++)
+		{
+			recording.SetTick(i);
+
+			AIFrameTimings timings;
+			Timer timer;
+			scene->OnAIUpdate(tick, viewerPosition, viewerForward, &timings);
+			totals.push_back(timer.ElapsedMillis());
+			for(size_t system = 0; system < AISystemCount; system++)
+				samples[system].push_back(timings.Milliseconds[system]);
+		}
+		Input::SetOverride(nullptr);
+		AStar::SetBuildInBackground(buildInBackground);
+		AStar::SetPathSliceBudget(0);
+
+		for(size_t system = 0; system < AISystemCount; system++)
+			report.Systems.push_back(Summarise(GetAISystemName(static_cast<AISystem>(system)), samples[system]));
+		report.Systems.push_back(Summarise("Total", totals));
+		report.Ticks = settings.Ticks;
+
+		// FNV-1a over the bits of every agent position, in the order the registry stores them
+		uint64_t hash = 14695981039346656037ull;
+		auto agents = registry.view<AIComponent, TransformComponent>();
+		for(auto entity : agents)
+		{
+			const glm::vec3& position = agents.get<TransformComponent>(entity).Position;
+			uint32_t bits[3];
+			std::memcpy(bits, &position, sizeof(bits));
+			for(uint32_t word : bits)
+			{
+				for(int byte = 0; byte < 4; byte++)
+				{
+					hash ^= (word >> (byte * 8)) & 0xFF;
+					hash *= 1099511628211ull;
+				}
+			}
+		}
+		report.Checksum = hash;
+		return report;
+	}
+
+	int AISimulation::RunFromCommandLine(int argc, char** argv)
+	{
+		if(argc < 5)
+		{
+			TNAH_CORE_ERROR("Usage: --ai-sim <scene> <ticks> <seed> [input]");
+			return 1;
+		}
+
+		AISimulationSettings settings;
+		settings.ScenePath = argv[2];
+		settings.Ticks = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+		settings.Seed = std::strtoull(argv[4], nullptr, 10);
+		if(argc > 5)
+			settings.InputPath = argv[5];
+
+		// No window means no graphics context, the scene's render resources are made headless instead
+		RendererAPI::SetAPI(RendererAPI::API::None);
+		JobSystem::Init();
+		const AISimulationReport report = Run(settings);
+		JobSystem::Shutdown();
+
+		if(report.Ticks == 0)
+			return 1;
+		std::printf("%s", report.ToString().c_str());
+		return 0;
+	}
+}
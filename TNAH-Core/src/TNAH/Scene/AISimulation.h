@@ -0,0 +1,157 @@
+#pragma once
+#include "TNAH/Scene/Scene.h"
+
+namespace tnah {
+
+	/**
+	 * @struct	AISimulationSettings
+	 *
+	 * @brief	What an AI simulation run loads and how long it runs for
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct AISimulationSettings
+	{
+		/** @brief	The scene file to load, unused when a scene is given to the run */
+		std::string ScenePath;
+
+		/** @brief	The seed of every random number the run draws */
+		uint64_t Seed = 1;
+
+		/** @brief	The number of ticks to run */
+		uint32_t Ticks = 3600;
+
+		/** @brief	The fixed length of a tick in seconds */
+		float TickLength = 1.0f / 60.0f;
+
+		/** @brief	A recording of the input to replay, no input is held when empty */
+		std::string InputPath;
+
+		/** @brief	The path search slices run per tick, a fixed count keeps the paths found the same on any machine */
+		uint32_t PathSlices = 64;
+	};
+
+	/**
+	 * @struct	AISystemTiming
+	 *
+	 * @brief	The spread of the time one AI system took per tick, in milliseconds
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct AISystemTiming
+	{
+		const char* Name = "";
+		float P50 = 0.0f;
+		float P90 = 0.0f;
+		float P99 = 0.0f;
+		float Max = 0.0f;
+		float Mean = 0.0f;
+	};
+
+	/**
+	 * @struct	AISimulationReport
+	 *
+	 * @brief	The result of an AI simulation run. Two runs with the same settings have the same checksum, so a
+	 * 			change in it means the AI no longer behaves the same rather than just running faster or slower.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct AISimulationReport
+	{
+		/** @brief	The timing of each AI system, plus the whole tick last */
+		std::vector<AISystemTiming> Systems;
+
+		/** @brief	The number of ticks that were run */
+		uint32_t Ticks = 0;
+
+		/** @brief	The seed the run used */
+		uint64_t Seed = 0;
+
+		/** @brief	A hash of where every agent ended up */
+		uint64_t Checksum = 0;
+
+		/**
+		 * @fn	std::string AISimulationReport::ToString() const;
+		 *
+		 * @brief	Formats the report as a table, one system per line
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The report as a string.
+		 */
+
+		std::string ToString() const;
+	};
+
+	/**
+	 * @class	AISimulation
+	 *
+	 * @brief	Runs the AI of a scene headless for a fixed number of ticks with a fixed seed and recorded input,
+	 * 			so the cost of each AI system can be compared between builds on the same workload.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class AISimulation
+	{
+	public:
+
+		/**
+		 * @fn	static AISimulationReport AISimulation::Run(const AISimulationSettings& settings);
+		 *
+		 * @brief	Seeds the random numbers, loads the scene from the settings and runs it
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	settings	The settings of the run.
+		 *
+		 * @returns	The report, empty if the scene could not be loaded.
+		 */
+
+		static AISimulationReport Run(const AISimulationSettings& settings);
+
+		/**
+		 * @fn	static AISimulationReport AISimulation::Run(Ref<Scene> scene, const AISimulationSettings& settings);
+		 *
+		 * @brief	Runs an already loaded scene. The seed should be set before the scene is built for the run to
+		 * 			be repeatable.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	scene   	The scene.
+		 * @param 	settings	The settings of the run.
+		 *
+		 * @returns	The report.
+		 */
+
+		static AISimulationReport Run(Ref<Scene> scene, const AISimulationSettings& settings);
+
+		/**
+		 * @fn	static int AISimulation::RunFromCommandLine(int argc, char** argv);
+		 *
+		 * @brief	Runs the simulation given by "--ai-sim <scene> <ticks> <seed> [input]" and prints the report.
+		 * 			It is meant to be called from main before any application or window is made, so it switches
+		 * 			the renderer to the headless api and starts and stops the job system itself.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	argc	The number of command-line arguments.
+		 * @param 	argv	The command-line arguments, argv[1] being "--ai-sim".
+		 *
+		 * @returns	0 if the run finished, else 1.
+		 */
+
+		static int RunFromCommandLine(int argc, char** argv);
+	};
+}
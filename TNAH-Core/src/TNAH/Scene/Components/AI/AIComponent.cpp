@@ -7,33 +7,172 @@ namespace tnah {
     void AIComponent::OnUpdate(Timestep deltaTime, TransformComponent &trans)
     {
         currentPosition.position = {static_cast<int>(round(trans.Position.x)), static_cast<int>(round(trans.Position.z))};
+        m_PreferredVelocity = glm::vec2(0.0f);
+        m_GroundVelocity = glm::vec2(0.0f);
+        collectPath();
+        refineRoute();
         if(currentlyWandering)
+            m_Movement.Update(*this, deltaTime, trans);
+
+        checkBlocked(deltaTime.GetSeconds());
+        currentPosition.position = {static_cast<int>(round(trans.Position.x)), static_cast<int>(round(trans.Position.z))};
+    }
+
+    void AIComponent::SetSharedDestination(Int2 goal)
+    {
+        if(auto paths = AStar::GetPathService())
+            paths->Cancel(pathHandle);
+        pathHandle = 0;
+        currentPath.clear();
+        currentRoute = HPARoute();
+        destination.position = goal;
+        m_Movement.ChangeState<FollowFieldState>(*this);
+    }
+
+    void AIComponent::SetDestination(Int2 goal)
+    {
+        if(auto paths = AStar::GetPathService())
+            paths->Cancel(pathHandle);
+        pathHandle = 0;
+        currentPath.clear();
+        currentRoute = HPARoute();
+        destination.position = goal;
+        m_Movement.ChangeState<FollowPathState>(*this);
+        requestPath();
+    }
+
+    void AIComponent::FollowPathState::Execute(AIComponent& ai, Timestep deltaTime, TransformComponent& trans)
+    {
+        if(!ai.currentPath.empty())
         {
-            if(!currentPath.empty())
+            const auto path = ai.currentPath.front();
+            if(!ai.waypointClear(path.position))
             {
-                const auto path = currentPath.front();
-                if(!AStar::IsValid(path.position))
+                //Hold on the old path until the replan comes back, pick somewhere else if the destination itself is now blocked
+                if(!AStar::IsValid(ai.destination.position))
                 {
-                    if(!AStar::IsValid(destination.position))
-                    {
-                        currentPath.clear();
-                    }
-                    else
-                        currentPath = AStar::Algorithm(currentPosition, destination);
-                }
-                else if(AStar::Reached(currentPosition.position, path) || moveTo(trans.Position, glm::vec3(path.position.x, trans.Position.y, path.position.y), m_Velocity, deltaTime.GetSeconds(), trans.Rotation))
-                {
-                    currentPath.pop_front();
+                    ai.currentPath.clear();
+                    ai.currentRoute = HPARoute();
                 }
+                else if(!ai.pathHandle)
+                    ai.requestPath();
             }
-            else
+            else if(AStar::Reached(ai.currentPosition.position, path) || ai.moveTo(trans.Position, glm::vec3(path.position.x, trans.Position.y, path.position.y), ai.m_Velocity, deltaTime.GetSeconds(), trans.Rotation))
             {
-                destination = AStar::GenerateRandomPosition(currentPosition.position);
-                currentPath = AStar::Algorithm(currentPosition, destination);
+                ai.currentPath.pop_front();
             }
         }
+        else if(!ai.pathHandle)
+        {
+            ai.destination = AStar::GenerateRandomPosition(ai.currentPosition.position);
+            ai.requestPath();
+        }
+    }
 
-        currentPosition.position = {static_cast<int>(round(trans.Position.x)), static_cast<int>(round(trans.Position.z))};
+    void AIComponent::FollowFieldState::Execute(AIComponent& ai, MovementMachine& movement, Timestep deltaTime, TransformComponent& trans)
+    {
+        auto fields = AStar::GetFlowFields();
+        auto field = fields ? fields->Get(ai.destination.position) : nullptr;
+        Int2 next;
+        if(!field || !field->IsReachable(ai.currentPosition.position))
+        {
+            //The goal is gone or walled off, go back to wandering
+            movement.ChangeState<FollowPathState>(ai);
+            return;
+        }
+
+        //Sitting on the goal leaves nothing to sample
+        if(!field->GetNext(ai.currentPosition.position, next))
+            return;
+
+        ai.moveTo(trans.Position, glm::vec3(next.x, trans.Position.y, next.y), ai.m_Velocity, deltaTime.GetSeconds(), trans.Rotation);
+    }
+
+    void AIComponent::requestPath()
+    {
+        if(auto paths = AStar::GetPathService())
+            pathHandle = paths->Request(currentPosition.position, destination.position);
+    }
+
+    void AIComponent::collectPath()
+    {
+        if(!pathHandle)
+            return;
+
+        auto paths = AStar::GetPathService();
+        std::deque<Node> path;
+        if(!paths || paths->GetStatus(pathHandle) == PathStatus::Invalid)
+        {
+            //The grid was replaced while waiting, the request went with it
+            pathHandle = 0;
+        }
+        else if(paths->TakePath(pathHandle, path, currentRoute))
+        {
+            //A failed request leaves the path empty so a new destination is picked
+            currentPath = std::move(path);
+            if(auto grid = AStar::GetActiveGrid())
+                grid->SmoothPath(currentPath);
+            pathHandle = 0;
+        }
+    }
+
+    bool AIComponent::waypointClear(Int2 waypoint)
+    {
+        auto grid = AStar::GetActiveGrid();
+        if(!grid)
+            return false;
+
+        //Smoothed paths skip cells, so the whole line to the waypoint has to stay clear, not just the waypoint
+        if(clearChecked && clearVersion == grid->GetVersion() && clearWaypoint.CheckSame(waypoint))
+            return true;
+
+        //Moving obstacles are steered around by the crowd, only a static wall is worth replanning for straight away
+        if(!grid->HasLineOfSight(currentPosition.position, waypoint, m_AvoidanceActive))
+        {
+            clearChecked = false;
+            return false;
+        }
+
+        clearWaypoint = waypoint;
+        clearVersion = grid->GetVersion();
+        clearChecked = true;
+        return true;
+    }
+
+    void AIComponent::refineRoute()
+    {
+        if(currentRoute.Done() || currentPath.size() > 1)
+            return;
+
+        auto hierarchy = AStar::GetHierarchy();
+        if(hierarchy && hierarchy->RefineNext(currentRoute, currentPath))
+        {
+            AStar::GetActiveGrid()->SmoothPath(currentPath);
+        }
+        else
+        {
+            //The segment got blocked, replan the rest from wherever the agent ends up
+            currentRoute = HPARoute();
+            if(!pathHandle && AStar::IsValid(destination.position))
+                requestPath();
+        }
+    }
+
+    void AIComponent::checkBlocked(float deltaTime)
+    {
+        const float preferredSpeed = glm::length(m_PreferredVelocity);
+        if(!m_AvoidanceActive || currentPath.empty() || preferredSpeed <= 0.0f || glm::length(m_GroundVelocity) >= preferredSpeed * s_BlockedSpeedRatio)
+        {
+            m_BlockedTime = 0.0f;
+            return;
+        }
+
+        m_BlockedTime += deltaTime;
+        if(m_BlockedTime > s_BlockedReplanTime && !pathHandle)
+        {
+            m_BlockedTime = 0.0f;
+            requestPath();
+        }
     }
 
     bool AIComponent::moveTo(glm::vec3& curPos, const glm::vec3& targetPos, glm::vec3& curVelocity, float time, glm::vec3& rot)
@@ -45,9 +184,11 @@ namespace tnah {
         if (target.x == 0 && target.y == 0 && target.z == 0)
             return true;
 
-        //calc new velocity and new character position
+        //calc new velocity and new character position, the crowd steering bends it around other agents
         curVelocity = target * glm::length(curVelocity);
-        glm::vec3 displacement = curVelocity * time * m_MovementSpeed;
+        m_PreferredVelocity = glm::vec2(curVelocity.x, curVelocity.z) * m_MovementSpeed;
+        m_GroundVelocity = m_AvoidanceActive ? m_AvoidanceVelocity : m_PreferredVelocity;
+        glm::vec3 displacement = glm::vec3(m_GroundVelocity.x, 0.0f, m_GroundVelocity.y) * time;
         glm::vec3 vec = curPos + displacement;
 
         SetVelocity(curVelocity);
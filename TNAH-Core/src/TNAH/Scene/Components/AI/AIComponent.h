@@ -8,14 +8,19 @@
 #pragma once
 # define PI           3.14159265358979323846
 #include "AStar.h"
+#include "FlowField.h"
+#include "AILodScheduler.h"
+#include "PathRequestService.h"
 #include "Character.h"
+#include "StaticStateMachine.h"
 #include "TNAH/Core/Timestep.h"
+#include "TNAH/Core/Random.h"
 
 namespace tnah
 {
     inline double randFloat()
     {
-        return ((rand()) / (RAND_MAX + 1.0));
+        return Random::GetEngine().Double();
     }
 
     inline double randomClamped()
@@ -156,7 +161,211 @@ namespace tnah
          * @author chris
          */
         std::deque<Node> GetPositions() {return currentPath;}
+
+        /**
+         *
+         * @fn SetSharedDestination
+         * @brief Heads for a destination by following its flow field instead of requesting a path, for goals many agents share
+         * 
+         * @param goal
+         * @author chris
+         */
+        void SetSharedDestination(Int2 goal);
+
+        /**
+         *
+         * @fn SetDestination
+         * @brief Requests a path to a destination, dropping the current path and any flow field being followed
+         * 
+         * @param goal
+         * @author chris
+         */
+        void SetDestination(Int2 goal);
+
+        /**
+         *
+         * @fn ClearSharedDestination
+         * @brief Stops following the flow field and goes back to wandering
+         * 
+         * @author chris
+         */
+        void ClearSharedDestination() { if(HasSharedDestination()) m_Movement.ChangeState<FollowPathState>(*this); }
+
+        /**
+         *
+         * @fn HasSharedDestination
+         * @brief Checks if the agent is following a flow field
+         * 
+         * @return 
+         * @author chris
+         */
+        bool HasSharedDestination() const { return m_Movement.IsInState<FollowFieldState>(); }
+
+        /**
+         *
+         * @fn GetDestination
+         * @brief Gets the cell the agent is heading for
+         * 
+         * @return 
+         * @author chris
+         */
+        Int2 GetDestination() const { return destination.position; }
+
+        /**
+         *
+         * @fn GetPreferredVelocity
+         * @brief Gets the velocity on the x and z axes the agent wanted to move at in the last update, zero when it stood still
+         * 
+         * @return 
+         * @author chris
+         */
+        const glm::vec2& GetPreferredVelocity() const { return m_PreferredVelocity; }
+
+        /**
+         *
+         * @fn GetGroundVelocity
+         * @brief Gets the velocity on the x and z axes the agent actually moved at in the last update
+         * 
+         * @return 
+         * @author chris
+         */
+        const glm::vec2& GetGroundVelocity() const { return m_GroundVelocity; }
+
+        /**
+         *
+         * @fn SetAvoidanceVelocity
+         * @brief Sets the velocity from the crowd steering, used in place of the preferred one on the next update
+         * 
+         * @param velocity
+         * @author chris
+         */
+        void SetAvoidanceVelocity(const glm::vec2& velocity) { m_AvoidanceVelocity = velocity; m_AvoidanceActive = true; }
+
+        /**
+         *
+         * @fn GetMaxSpeed
+         * @brief Gets the fastest the agent moves
+         * 
+         * @return 
+         * @author chris
+         */
+        float GetMaxSpeed() const { return glm::length(m_Velocity) * m_MovementSpeed; }
+
+        /**
+         *
+         * @fn GetRadius
+         * @brief Gets the radius other agents keep clear of
+         * 
+         * @return 
+         * @author chris
+         */
+        float GetRadius() const { return m_Radius; }
+
+        /**
+         *
+         * @fn SetRadius
+         * @brief Sets the radius other agents keep clear of
+         * 
+         * @param radius
+         * @author chris
+         */
+        void SetRadius(float radius) { m_Radius = radius; }
+
+        /**
+         *
+         * @fn GetLodSettings
+         * @brief Gets the distances where the agent drops to a slower update tier
+         * 
+         * @return 
+         * @author chris
+         */
+        const AILodSettings& GetLodSettings() const { return m_LodSettings; }
+
+        /**
+         *
+         * @fn SetLodSettings
+         * @brief Sets the distances where the agent drops to a slower update tier
+         * 
+         * @param settings
+         * @author chris
+         */
+        void SetLodSettings(const AILodSettings& settings) { m_LodSettings = settings; }
+
+        /**
+         *
+         * @fn GetLodState
+         * @brief Gets the update tier scheduling of the agent
+         * 
+         * @return 
+         * @author chris
+         */
+        AILodState& GetLodState() { return m_LodState; }
     private:
+        struct FollowPathState;
+        struct FollowFieldState;
+        using MovementMachine = StaticStateMachine<AIComponent, FollowPathState, FollowFieldState>;
+
+        /**
+         * @struct FollowPathState
+         * @brief Walks the path from the path service, picking a random destination once it runs out
+         *
+         * @author chris
+         */
+        struct FollowPathState
+        {
+            void Execute(AIComponent& ai, Timestep deltaTime, TransformComponent& trans);
+        };
+
+        /**
+         * @struct FollowFieldState
+         * @brief Steps along the flow field of a destination shared with other agents, going back to a path once
+         * the field no longer reaches the agent
+         *
+         * @author chris
+         */
+        struct FollowFieldState
+        {
+            void Execute(AIComponent& ai, MovementMachine& movement, Timestep deltaTime, TransformComponent& trans);
+        };
+
+        /**
+         *
+         * @fn requestPath
+         * @brief Asks the path service for a path from the current position to the destination
+         * 
+         * @author chris
+         */
+        void requestPath();
+
+        /**
+         *
+         * @fn collectPath
+         * @brief Swaps in the requested path once the path service has finished it
+         * 
+         * @author chris
+         */
+        void collectPath();
+
+        /**
+         *
+         * @fn waypointClear
+         * @brief Checks the straight line to the next waypoint, only looking again once the waypoint or the grid changes
+         * 
+         * @param waypoint
+         * @return 
+         * @author chris
+         */
+        bool waypointClear(Int2 waypoint);
+
+        /**
+         *
+         * @fn refineRoute
+         * @brief Refines the next segment of the hierarchical route once the current path is nearly walked
+         * 
+         * @author chris
+         */
+        void refineRoute();
+
         /**
          *
          * @fn moveTo
@@ -172,6 +381,16 @@ namespace tnah
          */
         bool moveTo(glm::vec3& curPos, const glm::vec3& targetPos, glm::vec3& curVelocity, float time, glm::vec3& rot);
 
+        /**
+         *
+         * @fn checkBlocked
+         * @brief Replans once the crowd steering has held the agent well below the speed it wants for too long
+         * 
+         * @param deltaTime
+         * @author chris
+         */
+        void checkBlocked(float deltaTime);
+
     private:
         /** Target position of the object */
         glm::vec3 m_TargetPosition = {};
@@ -192,6 +411,39 @@ namespace tnah
         Node destination;
         /**  The current path*/
         std::deque<Node> currentPath = {};
+        /** The path requested from the path service, 0 if none is pending */
+        PathHandle pathHandle = 0;
+        /** The rest of a hierarchical route, refined into the current path as it runs out */
+        HPARoute currentRoute = {};
+        /** The waypoint last found to be in clear sight */
+        Int2 clearWaypoint = {0, 0};
+        /** The grid version the clear waypoint was checked against */
+        uint64_t clearVersion = 0;
+        /** If the clear waypoint is still worth trusting */
+        bool clearChecked = false;
+        /** If the agent is following a path or the flow field to the destination */
+        MovementMachine m_Movement;
+        /** The velocity the agent wanted to move at in the last update */
+        glm::vec2 m_PreferredVelocity = glm::vec2(0.0f);
+        /** The velocity the agent moved at in the last update */
+        glm::vec2 m_GroundVelocity = glm::vec2(0.0f);
+        /** The velocity given by the crowd steering */
+        glm::vec2 m_AvoidanceVelocity = glm::vec2(0.0f);
+        /** If the crowd steering is running, moving obstacles are then left to it instead of replanning around them */
+        bool m_AvoidanceActive = false;
+        /** How long the agent has been held up by the crowd */
+        float m_BlockedTime = 0.0f;
+        /** Radius other agents keep clear of */
+        float m_Radius = 0.4f;
+        /** Distances where the agent drops to a slower update tier */
+        AILodSettings m_LodSettings;
+        /** Update tier scheduling */
+        AILodState m_LodState;
+
+        /** Fraction of the preferred speed below which the agent counts as held up */
+        static constexpr float s_BlockedSpeedRatio = 0.1f;
+        /** Seconds held up before replanning */
+        static constexpr float s_BlockedReplanTime = 1.0f;
 
         inline static std::string s_SearchString = "AiCharacter Component";
         /** @brief	Type identifiers for the component */
@@ -0,0 +1,59 @@
+﻿#include "tnahpch.h"
+#include "AILodScheduler.h"
+
+namespace tnah
+{
+    void AILodScheduler::BeginFrame(const glm::vec3& viewer, const glm::vec3& forward)
+    {
+        m_Viewer = viewer;
+        m_Forward = forward;
+        m_Frame++;
+        m_Stats = AILodStats();
+    }
+
+    bool AILodScheduler::Schedule(const AILodSettings& settings, AILodState& state, const glm::vec3& position, float deltaTime)
+    {
+        const uint8_t tier = tierFor(settings, state, position);
+        if(!state.Assigned || tier != state.Tier)
+        {
+            state.Tier = tier;
+            state.Phase = m_NextPhase[tier]++;
+            state.Assigned = true;
+        }
+
+        const uint32_t period = 1u << state.Tier;
+        state.Accumulated += deltaTime;
+        state.Ticking = ((m_Frame + state.Phase) & (period - 1)) == 0;
+        state.TickTime = 0.0f;
+        if(state.Ticking)
+        {
+            state.TickTime = state.Accumulated;
+            state.Accumulated = 0.0f;
+            m_Stats.Ticked[state.Tier]++;
+        }
+
+        m_Stats.Agents[state.Tier]++;
+        return state.Ticking;
+    }
+
+    uint8_t AILodScheduler::tierFor(const AILodSettings& settings, const AILodState& state, const glm::vec3& position) const
+    {
+        const glm::vec3 offset = position - m_Viewer;
+        const float distance = glm::length(offset);
+        const float thresholds[s_TierCount - 1] = { settings.FullRateDistance, settings.HalfRateDistance, settings.QuarterRateDistance };
+
+        // Dropping to a slower tier needs the agent to be clearly past the line, speeding back up does not
+        uint8_t tier = 0;
+        for(uint8_t i = 0; i < s_TierCount - 1; i++)
+        {
+            const float margin = (state.Assigned && i < state.Tier) ? 0.0f : s_Hysteresis;
+            if(distance > thresholds[i] + margin)
+                tier = i + 1;
+        }
+
+        if(settings.DemoteHidden && distance > 0.0f && glm::dot(offset / distance, m_Forward) < s_ViewCone)
+            tier = std::min<uint8_t>(tier + 1, s_TierCount - 1);
+
+        return tier;
+    }
+}
@@ -0,0 +1,147 @@
+﻿/*****************************************************************//**
+ * @file   AILodScheduler.h
+ * @brief  Level of detail for AI updates, far and unseen agents tick less often
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+
+namespace tnah
+{
+    /**
+     * @struct AILodSettings
+     * @brief Distances from the viewer where an agent drops to the next update tier. Agents within the first distance
+     * tick every frame, then every 2nd, 4th and 8th frame beyond the last
+     *
+     * @author chris
+     */
+    struct AILodSettings
+    {
+        /** Tick every frame within this distance */
+        float FullRateDistance = 25.0f;
+        /** Tick every 2nd frame within this distance */
+        float HalfRateDistance = 60.0f;
+        /** Tick every 4th frame within this distance, every 8th beyond */
+        float QuarterRateDistance = 120.0f;
+        /** If agents outside the viewer's cone drop one more tier */
+        bool DemoteHidden = true;
+    };
+
+    /**
+     * @struct AILodState
+     * @brief Per agent scheduling state, kept by the agent between frames
+     *
+     * @author chris
+     */
+    struct AILodState
+    {
+        /** Current tier, 0 is every frame */
+        uint8_t Tier = 0;
+        /** Frame offset within the tier's period, spreads the tier's agents over the frames */
+        uint32_t Phase = 0;
+        /** Time gathered since the last tick */
+        float Accumulated = 0.0f;
+        /** If the agent ticks this frame */
+        bool Ticking = true;
+        /** Time to tick by this frame */
+        float TickTime = 0.0f;
+        /** If the agent has been scheduled before */
+        bool Assigned = false;
+    };
+
+    /**
+     * @struct AILodStats
+     * @brief Agents in each tier and how many of them ticked in the last frame
+     *
+     * @author chris
+     */
+    struct AILodStats
+    {
+        std::array<uint32_t, 4> Agents = {};
+        std::array<uint32_t, 4> Ticked = {};
+    };
+
+    /**
+     * @class AILodScheduler
+     * @brief Puts each agent in an update tier from its distance to the viewer and whether the viewer faces it, and
+     * decides which agents tick each frame. Agents joining a tier take the next phase in turn so each frame ticks an
+     * even share, and an agent that ticks gets all the time gathered since its last tick
+     *
+     * @author chris
+     */
+    class AILodScheduler : public RefCounted
+    {
+    public:
+        AILodScheduler() = default;
+        ~AILodScheduler() = default;
+
+        /**
+         *
+         * @fn BeginFrame
+         * @brief Starts a frame, clearing the stats
+         *
+         * @param viewer position of the camera or player
+         * @param forward direction the viewer faces
+         * @author chris
+         */
+        void BeginFrame(const glm::vec3& viewer, const glm::vec3& forward);
+
+        /**
+         *
+         * @fn Schedule
+         * @brief Updates the tier of an agent and works out if it ticks this frame
+         *
+         * @param settings the agent's tier distances
+         * @param state the agent's scheduling state, Ticking and TickTime are set
+         * @param position
+         * @param deltaTime
+         * @return if the agent ticks
+         * @author chris
+         */
+        bool Schedule(const AILodSettings& settings, AILodState& state, const glm::vec3& position, float deltaTime);
+
+        /**
+         *
+         * @fn GetStats
+         * @brief Gets the tier counts of the last frame
+         *
+         * @return const AILodStats&
+         * @author chris
+         */
+        const AILodStats& GetStats() const { return m_Stats; }
+
+        /** Number of tiers */
+        static constexpr uint8_t s_TierCount = 4;
+
+    private:
+        /**
+         *
+         * @fn tierFor
+         * @brief Picks the tier for an agent, holding its current tier until it is clearly past a threshold
+         *
+         * @param settings
+         * @param state
+         * @param position
+         * @return the tier
+         * @author chris
+         */
+        uint8_t tierFor(const AILodSettings& settings, const AILodState& state, const glm::vec3& position) const;
+
+        /** Where the viewer is */
+        glm::vec3 m_Viewer = glm::vec3(0.0f);
+        /** Where the viewer faces */
+        glm::vec3 m_Forward = glm::vec3(0.0f, 0.0f, -1.0f);
+        /** Frames begun */
+        uint32_t m_Frame = 0;
+        /** Next phase to hand out in each tier */
+        std::array<uint32_t, s_TierCount> m_NextPhase = {};
+        /** Counts of the current frame */
+        AILodStats m_Stats;
+
+        /** Distance past a threshold before an agent drops a tier, stops agents on the line flickering between tiers */
+        static constexpr float s_Hysteresis = 2.0f;
+        /** Cosine of the half angle of the viewer's cone */
+        static constexpr float s_ViewCone = 0.5f;
+    };
+}
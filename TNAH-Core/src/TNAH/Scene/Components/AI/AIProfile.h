@@ -0,0 +1,53 @@
+﻿/*****************************************************************//**
+ * @file   AIProfile.h
+ * @brief  Per system timings of one AI update
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+
+namespace tnah
+{
+    /**
+     * @enum AISystem
+     * @brief The systems an AI update runs, in the order it runs them
+     *
+     * @author chris
+     */
+    enum class AISystem : uint8_t
+    {
+        Emotion, Lod, Affordance, Perception, Crowd, Behaviour, Agents, Paths, Count
+    };
+
+    /** Number of timed AI systems */
+    constexpr size_t AISystemCount = static_cast<size_t>(AISystem::Count);
+
+    /**
+     * @fn GetAISystemName
+     * @brief Gets the name of a system for reports
+     *
+     * @param system
+     * @return const char*
+     * @author chris
+     */
+    inline const char* GetAISystemName(AISystem system)
+    {
+        static constexpr const char* names[AISystemCount] = { "Emotion", "Lod", "Affordance", "Perception", "Crowd", "Behaviour", "Agents", "Paths" };
+        return system < AISystem::Count ? names[static_cast<size_t>(system)] : "Unknown";
+    }
+
+    /**
+     * @struct AIFrameTimings
+     * @brief Milliseconds each system took in one update
+     *
+     * @author chris
+     */
+    struct AIFrameTimings
+    {
+        std::array<float, AISystemCount> Milliseconds = {};
+
+        float& operator[](AISystem system) { return Milliseconds[static_cast<size_t>(system)]; }
+        float operator[](AISystem system) const { return Milliseconds[static_cast<size_t>(system)]; }
+    };
+}
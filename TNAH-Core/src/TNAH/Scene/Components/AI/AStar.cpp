@@ -1,256 +1,866 @@
 ﻿#include "tnahpch.h"
 #include "AStar.h"
+#include "FlowField.h"
+#include "HPAStar.h"
+#include "PathRequestService.h"
+#include "TNAH/Core/Random.h"
+#include "TNAH/Core/JobSystem.h"
+
+#include <limits>
 
 namespace tnah
 {
-        //Just checking it is in bounds atm not for any obstacles
-         bool AStar::IsValid(Int2 point)
+#pragma region AStarSearchContext
+
+        void AStarSearchContext::Begin(size_t cellCount, int startIndex, int destinationIndex)
         {
-            if(usedPositions[point.x][point.y])
-                return false;
-            
-            if (point.x < startingPos.x || point.y < startingPos.y || point.x > startingPos.x + size.x || point.y > startingPos.y + size.y)
+            m_StartIndex = startIndex;
+            m_DestinationIndex = destinationIndex;
+            m_Expansions = 0;
+
+            if(m_Cells.size() != cellCount)
             {
-                return false;
+                m_Cells.assign(cellCount, AStarCell());
+                m_OpenList.reserve(cellCount);
+                m_Generation = 0;
             }
-            else
-                return true;
+
+            // A new generation invalidates every cell touched by the previous search without visiting them
+            if(++m_Generation == 0)
+            {
+                for(auto& cell : m_Cells)
+                    cell.generation = 0;
+                m_Generation = 1;
+            }
+            m_OpenList.clear();
         }
 
-         void AStar::Update()
+        AStarCell& AStarSearchContext::Touch(int index)
         {
-            for(Int2 values : usedPositionsHolder)
+            AStarCell& cell = m_Cells[index];
+            if(cell.generation != m_Generation)
             {
-                usedPositions[values.x][values.y] = false;
+                cell = AStarCell();
+                cell.generation = m_Generation;
             }
+            return cell;
+        }
 
-             usedPositionsHolder.clear();
+        bool AStarSearchContext::OpenLess(int left, int right) const
+        {
+            const AStarCell& l = m_Cells[left];
+            const AStarCell& r = m_Cells[right];
+            if(l.f != r.f)
+                return l.f < r.f;
+            return l.h < r.h;
         }
-        
-         bool AStar::Reached(Int2 point, Node destination)
+
+        void AStarSearchContext::OpenPush(int index)
         {
-            if (point.CheckSame(destination.position))
+            m_Cells[index].heapIndex = (int)m_OpenList.size();
+            m_OpenList.push_back(index);
+            SiftUp(m_Cells[index].heapIndex);
+        }
+
+        int AStarSearchContext::OpenPop()
+        {
+            const int top = m_OpenList.front();
+            m_Cells[top].heapIndex = -1;
+
+            const int last = m_OpenList.back();
+            m_OpenList.pop_back();
+            if(!m_OpenList.empty())
             {
+                m_OpenList[0] = last;
+                m_Cells[last].heapIndex = 0;
+                SiftDown(0);
+            }
+            return top;
+        }
 
-                return true;
+        void AStarSearchContext::OpenDecrease(int index)
+        {
+            SiftUp(m_Cells[index].heapIndex);
+        }
+
+        void AStarSearchContext::SiftUp(int heapPos)
+        {
+            const int index = m_OpenList[heapPos];
+            while(heapPos > 0)
+            {
+                const int parentPos = (heapPos - 1) / 2;
+                if(!OpenLess(index, m_OpenList[parentPos]))
+                    break;
+
+                m_OpenList[heapPos] = m_OpenList[parentPos];
+                m_Cells[m_OpenList[heapPos]].heapIndex = heapPos;
+                heapPos = parentPos;
             }
+            m_OpenList[heapPos] = index;
+            m_Cells[index].heapIndex = heapPos;
+        }
 
-            return false;
+        void AStarSearchContext::SiftDown(int heapPos)
+        {
+            const int count = (int)m_OpenList.size();
+            const int index = m_OpenList[heapPos];
+            while(true)
+            {
+                int child = heapPos * 2 + 1;
+                if(child >= count)
+                    break;
+
+                if(child + 1 < count && OpenLess(m_OpenList[child + 1], m_OpenList[child]))
+                    child++;
+
+                if(!OpenLess(m_OpenList[child], index))
+                    break;
+
+                m_OpenList[heapPos] = m_OpenList[child];
+                m_Cells[m_OpenList[heapPos]].heapIndex = heapPos;
+                heapPos = child;
+            }
+            m_OpenList[heapPos] = index;
+            m_Cells[index].heapIndex = heapPos;
         }
 
-         double AStar::heuristic(Int2 point, Node destination)
+#pragma endregion AStarSearchContext
+
+#pragma region AStarGrid
+
+        AStarGrid::AStarGrid(Int2 startingPosition, Int2 xySize)
+            : m_StartingPos(startingPosition), m_Size(xySize)
         {
-            double H = (sqrt((point.x - destination.position.x)*(point.x - destination.position.x)
-                + (point.y - destination.position.y)*(point.y - destination.position.y)));
-            return H;
+            const size_t cellCount = GetCellCount();
+            const size_t words = (cellCount + 63) / 64;
+            m_UsedBits.assign(words, 0);
+            m_StaticBits.assign(words, 0);
+            m_PermanentBits.assign(words, 0);
+            m_DynamicCounts.assign(cellCount, 0);
+            m_FreeCells.resize(cellCount);
+            m_FreeSlots.resize(cellCount);
+            for(size_t i = 0; i < cellCount; i++)
+            {
+                m_FreeCells[i] = static_cast<int>(i);
+                m_FreeSlots[i] = static_cast<int>(i);
+            }
+            m_MainContext.Begin(cellCount);
         }
-        
-         void AStar::Init(Int2 startingPosition, Int2 xySize)
+
+        void AStarGrid::Update()
+        {
+            for(int index : m_UsedPositionsHolder)
+            {
+                removeDynamic(index);
+            }
+
+            m_UsedPositionsHolder.clear();
+        }
+
+        void AStarGrid::AddUsedPosition(Int2 position, bool dynamic)
         {
-            startingPos = startingPosition;
-            size = xySize;
-            initilised = true;
-            for (int x = startingPos.x; x < startingPos.x + size.x; x++) {
-                for (int y = startingPos.y; y < startingPos.y + size.y; y++) {
-                    astarMap[x][y].f= FLT_MAX;
-                    astarMap[x][y].g = FLT_MAX;
-                    astarMap[x][y].h = FLT_MAX;
-                    astarMap[x][y].parent =  {-1, -1};
-                    astarMap[x][y].position = {x, y};
+            if(!InBounds(position))
+                return;
+
+            const int index = ToIndex(position);
+            if(dynamic)
+            {
+                addDynamic(index);
+                m_UsedPositionsHolder.push_back(index);
+            }
+            else
+            {
+                m_PermanentBits[index >> 6] |= 1ull << (index & 63);
+                m_StaticBits[index >> 6] |= 1ull << (index & 63);
+                refreshCell(index);
+            }
+        }
+
+        void AStarGrid::BakeStaticObstacle(uint32_t id, Int2 position)
+        {
+            if(m_SkippedObstacles.count(id))
+                return;
+
+            const int index = InBounds(position) ? ToIndex(position) : -1;
+            auto inserted = m_BakedObstacles.try_emplace(id, index);
+            if(!inserted.second)
+            {
+                if(inserted.first->second == index)
+                    return;
+
+                removeStatic(inserted.first->second);
+                inserted.first->second = index;
+            }
+
+            addStatic(index);
+        }
+
+        void AStarGrid::UnbakeStaticObstacle(uint32_t id)
+        {
+            m_SkippedObstacles.erase(id);
+            const auto it = m_BakedObstacles.find(id);
+            if(it == m_BakedObstacles.end())
+                return;
+
+            removeStatic(it->second);
+            m_BakedObstacles.erase(it);
+        }
+
+        void AStarGrid::BakeStaticCells(const std::vector<uint64_t>& blocked)
+        {
+            const size_t words = std::min(blocked.size(), m_StaticBits.size());
+            for(size_t word = 0; word < words; word++)
+            {
+                m_PermanentBits[word] |= blocked[word];
+                const uint64_t added = blocked[word] & ~m_StaticBits[word];
+                m_StaticBits[word] |= added;
+                for(int bit = 0; added != 0 && bit < 64; bit++)
+                {
+                    const int index = static_cast<int>(word * 64) + bit;
+                    if(((added >> bit) & 1) && index < static_cast<int>(GetCellCount()))
+                        refreshCell(index);
                 }
             }
         }
-        
-         std::deque<Node> AStar::Algorithm(Node point, Node destination)
+
+        void AStarGrid::SetDynamicObstacle(uint32_t id, Int2 position)
         {
-            if(!initilised)
+            const int index = InBounds(position) ? ToIndex(position) : -1;
+            auto inserted = m_DynamicObstacles.try_emplace(id);
+            DynamicObstacle& obstacle = inserted.first->second;
+            obstacle.Frame = m_ObstacleFrame;
+
+            if(inserted.second)
             {
-                return {};    
+                obstacle.Index = index;
+                addDynamic(index);
             }
-            
-            if(!IsValid(destination.position))
+            else if(obstacle.Index != index)
             {
-                return {};
+                removeDynamic(obstacle.Index);
+                addDynamic(index);
+                obstacle.Index = index;
             }
-            if(!IsValid(point.position))
+        }
+
+        void AStarGrid::EndObstacleFrame()
+        {
+            for(auto it = m_DynamicObstacles.begin(); it != m_DynamicObstacles.end();)
             {
-                return {};
+                if(it->second.Frame != m_ObstacleFrame)
+                {
+                    removeDynamic(it->second.Index);
+                    it = m_DynamicObstacles.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
-            if(Reached(point.position, destination))
+        }
+
+        bool AStarGrid::GetChangedCells(uint64_t sinceVersion, std::vector<AStarCellChange>& changes) const
+        {
+            if(sinceVersion < m_HistoryStart)
+                return false;
+
+            const auto first = std::upper_bound(m_Changes.begin(), m_Changes.end(), sinceVersion,
+                [](uint64_t version, const AStarCellChange& change) { return version < change.Version; });
+            changes.insert(changes.end(), first, m_Changes.end());
+            return true;
+        }
+
+        void AStarGrid::addDynamic(int index)
+        {
+            if(index < 0)
+                return;
+
+            if(m_DynamicCounts[index] != std::numeric_limits<uint16_t>::max())
+                m_DynamicCounts[index]++;
+            refreshCell(index);
+        }
+
+        void AStarGrid::removeDynamic(int index)
+        {
+            if(index < 0 || m_DynamicCounts[index] == 0)
+                return;
+
+            m_DynamicCounts[index]--;
+            refreshCell(index);
+        }
+
+        void AStarGrid::addStatic(int index)
+        {
+            if(index < 0)
+                return;
+
+            uint16_t& count = m_ObstacleCounts[index];
+            if(count != std::numeric_limits<uint16_t>::max())
+                count++;
+            m_StaticBits[index >> 6] |= 1ull << (index & 63);
+            refreshCell(index);
+        }
+
+        void AStarGrid::removeStatic(int index)
+        {
+            const auto it = index < 0 ? m_ObstacleCounts.end() : m_ObstacleCounts.find(index);
+            if(it == m_ObstacleCounts.end())
+                return;
+
+            if(--it->second > 0)
+                return;
+
+            // The walkability bake and static AddUsedPosition calls keep the cell blocked
+            m_ObstacleCounts.erase(it);
+            if(!testBit(m_PermanentBits, index))
+                m_StaticBits[index >> 6] &= ~(1ull << (index & 63));
+            refreshCell(index);
+        }
+
+        void AStarGrid::refreshCell(int index)
+        {
+            const bool used = testBit(m_StaticBits, index) || m_DynamicCounts[index] > 0;
+            if(used == testBit(m_UsedBits, index))
+                return;
+
+            m_UsedBits[index >> 6] ^= 1ull << (index & 63);
+            m_Version++;
+
+            // Keep the free list dense, a cell that becomes used swaps the last free cell into its slot
+            if(used)
+            {
+                const int slot = m_FreeSlots[index];
+                const int last = m_FreeCells.back();
+                m_FreeCells[slot] = last;
+                m_FreeSlots[last] = slot;
+                m_FreeCells.pop_back();
+                m_FreeSlots[index] = -1;
+            }
+            else
+            {
+                m_FreeSlots[index] = static_cast<int>(m_FreeCells.size());
+                m_FreeCells.push_back(index);
+            }
+
+            AStarCellChange change;
+            change.Version = m_Version;
+            change.Index = index;
+            change.Used = used;
+            m_Changes.push_back(change);
+            if(m_Changes.size() > s_MaxChangeHistory)
+            {
+                m_HistoryStart = m_Changes.front().Version;
+                m_Changes.pop_front();
+            }
+        }
+
+        std::deque<Node> AStarGrid::FindPath(Int2 start, Int2 destination)
+        {
+            return FindPath(start, destination, m_MainContext);
+        }
+
+        std::deque<Node> AStarGrid::FindPath(Int2 start, Int2 destination, AStarSearchContext& context) const
+        {
+            if(BeginSearch(start, destination, context) == AStarSearchStatus::Failed)
             {
                 return {};
             }
 
-            for (int x = startingPos.x; x < startingPos.x + size.x; x++) {
-                for (int y = startingPos.y; y < startingPos.y + size.y; y++) {
-                    astarMap[x][y].f= FLT_MAX;
-                    astarMap[x][y].g = FLT_MAX;
-                    astarMap[x][y].h = FLT_MAX;
-                    astarMap[x][y].parent =  {-1, -1};
-                    astarMap[x][y].position = {x, y};
-                    closedList[x][y] = false;
-                }
+            if(ContinueSearch(context, std::numeric_limits<size_t>::max()) == AStarSearchStatus::Found)
+            {
+                return GetSearchPath(context);
             }
             
-            Int2 position = point.position;
-            astarMap[position.x][position.y].f = 0.0;
-            astarMap[position.x][position.y].g = 0.0;
-            astarMap[position.x][position.y].h = 0.0;
-            astarMap[position.x][position.y].parent = position;
-
-            std::vector<Node> searchList;  
-            searchList.emplace_back(astarMap[position.x][position.y]);
-
-            while (!searchList.empty()) {
-                Node node;
-                do {
-                    float t = FLT_MAX;
-                    std::vector<Node>::iterator iteratorNode;
-                    for (std::vector<Node>::iterator it = searchList.begin();
-                        it != searchList.end(); it = next(it)) {
-                        Node n = *it;
-                        if (n.f < t) {
-                            t = n.f;
-                            iteratorNode = it;
-                        }
-                        }
-                    node = *iteratorNode;
-                    searchList.erase(iteratorNode);
-                } while (IsValid(node.position) == false);
-
-                position = node.position;
-                
-                closedList[position.x][position.y] = true;
-                
-                for (int x = -1; x <= 1; x++) {
-                    for (int y = -1; y <= 1; y++) {
-                        if (IsValid(Int2(position.x + x, position.y + y))) {
-                            if (Reached(Int2(position.x + x, position.y + y), destination))
-                            {
-                                astarMap[position.x + x][position.y + y].parent = {position.x, position.y};
-                                return makePath(astarMap, destination);
-                            }
-                            else if (closedList[position.x + x][position.y + y] == false)
-                            {
-                                float gNew;
-
-                                if(x == y){
-                                    gNew = node.g + 1.5f;
-                                }
-                                else {
-                                    gNew = node.g + 1.0f;
-                                }
-
-                                const float heuristicNew = (float)heuristic(Int2((int)position.x + x, (int)position.y + y), destination);
-                                const float fNew = gNew + heuristicNew;
-                                if (astarMap[position.x + x][position.y + y].f == FLT_MAX || astarMap[position.x + x][position.y + y].f > fNew)
-                                {
-                                    astarMap[position.x + x][position.y + y].f = fNew;
-                                    astarMap[position.x + x][position.y + y].g = gNew;
-                                    astarMap[position.x + x][position.y + y].h = heuristicNew;
-                                    astarMap[position.x + x][position.y + y].parent = {position.x, position.y};
-                                    searchList.emplace_back(astarMap[position.x + x][position.y + y]);
-                                }
-                            }
-                        }
-                    }
+            return {};
+        }
+
+        AStarSearchStatus AStarGrid::BeginSearch(Int2 start, Int2 destination, AStarSearchContext& context) const
+        {
+            if(!IsValid(destination) || !IsValid(start) || start.CheckSame(destination))
+            {
+                context.Begin(GetCellCount());
+                return AStarSearchStatus::Failed;
+            }
+
+            const int startIndex = ToIndex(start);
+            context.Begin(GetCellCount(), startIndex, ToIndex(destination));
+
+            AStarCell& first = context.Touch(startIndex);
+            first.g = 0.0f;
+            first.h = (float)AStar::heuristic(start, Node(destination));
+            first.f = first.h;
+            first.parent = startIndex;
+            context.OpenPush(startIndex);
+            return AStarSearchStatus::Searching;
+        }
+
+        AStarSearchStatus AStarGrid::ContinueSearch(AStarSearchContext& context, size_t maxExpansions) const
+        {
+            const int destinationIndex = context.GetDestinationIndex();
+            if(destinationIndex < 0)
+                return AStarSearchStatus::Failed;
+
+            const Node goal(ToPosition(destinationIndex));
+            for(size_t expansions = 0; expansions < maxExpansions; expansions++)
+            {
+                if(context.OpenEmpty())
+                    return AStarSearchStatus::Failed;
+
+                const int current = context.OpenPop();
+                context.Cell(current).closed = true;
+                context.CountExpansion();
+
+                if(current == destinationIndex)
+                {
+                    return AStarSearchStatus::Found;
+                }
+
+                if(m_SearchMode == AStarSearchMode::JumpPoint)
+                    expandJumpPoints(current, context, goal);
+                else
+                    expandNeighbours(current, context, goal);
+            }
+
+            return context.OpenEmpty() ? AStarSearchStatus::Failed : AStarSearchStatus::Searching;
+        }
+
+        void AStarGrid::expandNeighbours(int current, AStarSearchContext& context, const Node& goal) const
+        {
+            const Int2 position = ToPosition(current);
+            for (int x = -1; x <= 1; x++)
+            {
+                for (int y = -1; y <= 1; y++)
+                {
+                    if(x == 0 && y == 0)
+                        continue;
+
+                    const Int2 neighbour(position.x + x, position.y + y);
+                    if (!IsValid(neighbour))
+                        continue;
+
+                    relax(current, ToIndex(neighbour), (x != 0 && y != 0) ? 1.5f : 1.0f, context, goal);
                 }
             }
-            
-                return {};
         }
 
-         std::deque<Node> AStar::makePath(std::unordered_map<int, std::unordered_map<int, Node>> map, Node destination) 
-         {
-            int x = destination.position.x;
-            int y = destination.position.y;
-            std::stack<Node> path;
+        void AStarGrid::expandJumpPoints(int current, AStarSearchContext& context, const Node& goal) const
+        {
+            const Int2 position = ToPosition(current);
+            const int parentIndex = context.Cell(current).parent;
+            auto walkable = [this](int x, int y) { return IsValid(Int2(x, y)); };
+            auto jumpTo = [&](int dx, int dy)
+            {
+                const int jumpPoint = jump(position, dx, dy, context.GetDestinationIndex());
+                if(jumpPoint < 0)
+                    return;
+
+                const Int2 target = ToPosition(jumpPoint);
+                const int steps = std::max(std::abs(target.x - position.x), std::abs(target.y - position.y));
+                relax(current, jumpPoint, steps * ((dx != 0 && dy != 0) ? 1.5f : 1.0f), context, goal);
+            };
+
+            // The start has no direction to prune with
+            if(parentIndex == current)
+            {
+                for(int dx = -1; dx <= 1; dx++)
+                    for(int dy = -1; dy <= 1; dy++)
+                        if(dx != 0 || dy != 0)
+                            jumpTo(dx, dy);
+                return;
+            }
+
+            const Int2 parent = ToPosition(parentIndex);
+            const int dx = (position.x > parent.x) - (position.x < parent.x);
+            const int dy = (position.y > parent.y) - (position.y < parent.y);
+            const int x = position.x;
+            const int y = position.y;
+
+            // Natural neighbours carry on in the travel direction, forced ones wrap around obstacles beside the path
+            if(dx != 0 && dy != 0)
+            {
+                jumpTo(dx, dy);
+                jumpTo(dx, 0);
+                jumpTo(0, dy);
+                if(!walkable(x - dx, y))
+                    jumpTo(-dx, dy);
+                if(!walkable(x, y - dy))
+                    jumpTo(dx, -dy);
+            }
+            else if(dx != 0)
+            {
+                jumpTo(dx, 0);
+                if(!walkable(x, y + 1))
+                    jumpTo(dx, 1);
+                if(!walkable(x, y - 1))
+                    jumpTo(dx, -1);
+            }
+            else
+            {
+                jumpTo(0, dy);
+                if(!walkable(x + 1, y))
+                    jumpTo(1, dy);
+                if(!walkable(x - 1, y))
+                    jumpTo(-1, dy);
+            }
+        }
+
+        int AStarGrid::jump(Int2 from, int dx, int dy, int destinationIndex) const
+        {
+            auto walkable = [this](int x, int y) { return IsValid(Int2(x, y)); };
+            int x = from.x;
+            int y = from.y;
+            while(true)
+            {
+                x += dx;
+                y += dy;
+                if(!walkable(x, y))
+                    return -1;
+
+                const int index = ToIndex(Int2(x, y));
+                if(index == destinationIndex)
+                    return index;
+
+                if(dx != 0 && dy != 0)
+                {
+                    if((!walkable(x - dx, y) && walkable(x - dx, y + dy)) || (!walkable(x, y - dy) && walkable(x + dx, y - dy)))
+                        return index;
+
+                    // A diagonal step is a jump point if either straight scan from it finds one
+                    if(jump(Int2(x, y), dx, 0, destinationIndex) >= 0 || jump(Int2(x, y), 0, dy, destinationIndex) >= 0)
+                        return index;
+                }
+                else if(dx != 0)
+                {
+                    if((!walkable(x, y + 1) && walkable(x + dx, y + 1)) || (!walkable(x, y - 1) && walkable(x + dx, y - 1)))
+                        return index;
+                }
+                else
+                {
+                    if((!walkable(x + 1, y) && walkable(x + 1, y + dy)) || (!walkable(x - 1, y) && walkable(x - 1, y + dy)))
+                        return index;
+                }
+            }
+        }
+
+        void AStarGrid::relax(int current, int next, float cost, AStarSearchContext& context, const Node& goal) const
+        {
+            AStarCell& cell = context.Touch(next);
+            if(cell.closed)
+                return;
+
+            const float gNew = context.Cell(current).g + cost;
+            if(gNew < cell.g)
+            {
+                cell.g = gNew;
+                cell.h = (float)AStar::heuristic(ToPosition(next), goal);
+                cell.f = gNew + cell.h;
+                cell.parent = current;
+
+                if(cell.heapIndex < 0)
+                    context.OpenPush(next);
+                else
+                    context.OpenDecrease(next);
+            }
+        }
+
+        std::deque<Node> AStarGrid::makePath(int destinationIndex, AStarSearchContext& context) const
+        {
             std::deque<Node> usablePath;
+            int index = destinationIndex;
+            const size_t cellCount = GetCellCount();
+            const Node goal(ToPosition(destinationIndex));
 
-            while (!(map[x][y].parent.x == x && map[x][y].parent.y == y))
+            // The start cell is its own parent, the step limit guards against a corrupt parent chain
+            for(size_t steps = 0; steps <= cellCount; steps++)
             {
-                if(x == 0 && y == 0)
+                const AStarCell& cell = context.Cell(index);
+                const Int2 position = ToPosition(index);
+                const Int2 parent = ToPosition(cell.parent);
+                const int dx = (position.x > parent.x) - (position.x < parent.x);
+                const int dy = (position.y > parent.y) - (position.y < parent.y);
+                const int gap = std::max(std::abs(position.x - parent.x), std::abs(position.y - parent.y));
+
+                Node node(position);
+                node.parent = gap > 1 ? Int2(position.x - dx, position.y - dy) : parent;
+                node.f = cell.f;
+                node.g = cell.g;
+                node.h = cell.h;
+                usablePath.push_front(node);
+
+                if(cell.parent == index)
+                    return usablePath;
+
+                // Jump points are linked in straight or diagonal runs, fill in the cells skipped over
+                const float stepCost = (dx != 0 && dy != 0) ? 1.5f : 1.0f;
+                const float parentG = context.Cell(cell.parent).g;
+                for(int step = gap - 1; step >= 1; step--)
                 {
-                    return {};
+                    Node between(Int2(parent.x + dx * step, parent.y + dy * step));
+                    between.parent = Int2(between.position.x - dx, between.position.y - dy);
+                    between.g = parentG + step * stepCost;
+                    between.h = (float)AStar::heuristic(between.position, goal);
+                    between.f = between.g + between.h;
+                    usablePath.push_front(between);
                 }
-                path.push(map[x][y]);
-                int tempX = map[x][y].parent.x;
-                int tempY = map[x][y].parent.y;
-                x = tempX;
-                y = tempY;
 
+                index = cell.parent;
             }
-            path.push(map[x][y]);
 
-            while (!path.empty()) {
-                Node top = path.top();
-                path.pop();
-                usablePath.push_back(top);
+            return {};
+        }
+
+        void AStarGrid::SolveBatch(PathRequest* requests, size_t count)
+        {
+            if(count == 0)
+                return;
+
+            // Contexts are created up front so the jobs never touch the vector itself, the lock only covers the
+            // first batch after the job system starts
+            {
+                std::lock_guard<std::mutex> lock(m_WorkerContextsLock);
+                const size_t threads = JobSystem::GetThreadCount();
+                if(m_WorkerContexts.size() < threads)
+                    m_WorkerContexts.resize(threads);
             }
-            return usablePath;
-  
+
+            JobSystem::ParallelFor(count, 1, [this, requests](size_t begin, size_t end)
+            {
+                // A job thread runs one chunk at a time so its context is its own, threads the job system does not
+                // own may be several batches at once and search with a context of their own
+                if(JobSystem::IsJobThread())
+                {
+                    AStarSearchContext& context = m_WorkerContexts[JobSystem::GetThreadIndex()];
+                    for(size_t i = begin; i < end; i++)
+                        requests[i].Path = FindPath(requests[i].Start, requests[i].Destination, context);
+                }
+                else
+                {
+                    AStarSearchContext context;
+                    for(size_t i = begin; i < end; i++)
+                        requests[i].Path = FindPath(requests[i].Start, requests[i].Destination, context);
+                }
+            });
         }
 
-         Node AStar::GenerateRandomPosition(Int2 currentPosition)
+        bool AStarGrid::HasLineOfSight(Int2 from, Int2 to, bool staticOnly) const
         {
-             bool notFound = false;
-            while(!notFound)
+            auto passable = [this, staticOnly](Int2 point)
             {
-                std::random_device d;
-                std::mt19937 gen(d());
-                std::uniform_int_distribution<int> xRand(startingPos.x,  startingPos.x + size.x-1);
-                std::uniform_int_distribution<int> yRand(startingPos.y,  startingPos.y + size.y-1);
-                Int2 newPos(xRand(gen), yRand(gen));
-                
-                if(!newPos.CheckSame(currentPosition) && IsValid(newPos))
+                return staticOnly ? InBounds(point) && !IsStaticIndex(ToIndex(point)) : IsValid(point);
+            };
+
+            // Supercover traversal, steps along whichever axis the line crosses into next
+            int dx = std::abs(to.x - from.x);
+            int dy = std::abs(to.y - from.y);
+            const int sx = to.x > from.x ? 1 : -1;
+            const int sy = to.y > from.y ? 1 : -1;
+            int error = dx - dy;
+            dx *= 2;
+            dy *= 2;
+
+            Int2 cell = from;
+            while(true)
+            {
+                if(!passable(cell))
+                    return false;
+                if(cell.CheckSame(to))
+                    return true;
+
+                if(error > 0)
                 {
-                    return newPos;
-                    notFound = true;   
+                    cell.x += sx;
+                    error -= dy;
+                }
+                else if(error < 0)
+                {
+                    cell.y += sy;
+                    error += dx;
+                }
+                else
+                {
+                    // The line passes exactly through a corner
+                    if(!passable(Int2(cell.x + sx, cell.y)) || !passable(Int2(cell.x, cell.y + sy)))
+                        return false;
+
+                    cell.x += sx;
+                    cell.y += sy;
+                    error += dx - dy;
                 }
             }
-            return Int2(0, 0);
         }
-         std::unordered_map<int, std::unordered_map<int, Node>> AStar::GetMapPoints()
+
+        void AStarGrid::SmoothPath(std::deque<Node>& path) const
         {
-            if(!generated)
+            if(path.size() < 3)
+                return;
+
+            std::deque<Node> smoothed;
+            smoothed.push_back(path.front());
+            for(size_t i = 2; i < path.size(); i++)
             {
-                for (int x = startingPos.x; x < startingPos.x + size.x; x++) {
-                    for (int y = startingPos.y; y < startingPos.y + size.y; y++) {
-                        astarMap[x][y].parent =  {-1, -1};
-                        astarMap[x][y].position = {x, y};
-                    }
+                if(!HasLineOfSight(smoothed.back().position, path[i].position))
+                {
+                    Node corner = path[i - 1];
+                    corner.parent = smoothed.back().position;
+                    smoothed.push_back(corner);
                 }
-                generated = true;
             }
 
-            return astarMap;
+            Node last = path.back();
+            last.parent = smoothed.back().position;
+            smoothed.push_back(last);
+            path = std::move(smoothed);
         }
 
-         std::unordered_map<int, std::unordered_map<int, bool>> AStar::GetUsedPoints()
+        Node AStarGrid::GenerateRandomPosition(Int2 currentPosition) const
         {
-            return usedPositions;
+            // Draw straight from the free cells, skipping the slot of the current position if it is one of them
+            const int current = InBounds(currentPosition) ? m_FreeSlots[ToIndex(currentPosition)] : -1;
+            const uint32_t count = static_cast<uint32_t>(m_FreeCells.size()) - (current >= 0 ? 1 : 0);
+            if(count == 0)
+                return Int2(0, 0);
+
+            int slot = static_cast<int>(Random::GetEngine().Below(count));
+            if(current >= 0 && slot >= current)
+                slot++;
+            return ToPosition(m_FreeCells[slot]);
         }
 
-         void AStar::AddUsedPosition(Int2 position, bool dynamic)
+#pragma endregion AStarGrid
+
+#pragma region AStar
+
+    Ref<PathRequestService> AStar::s_PathService = nullptr;
+    Ref<HPAStarGraph> AStar::s_Hierarchy = nullptr;
+    Ref<FlowFieldCache> AStar::s_FlowFields = nullptr;
+
+         bool AStar::IsValid(Int2 point)
         {
-            usedPositions[position.x][position.y] = true;
+            if(!s_ActiveGrid)
+                return false;
 
-            if(dynamic)
-                usedPositionsHolder.push_back(position);
-            
-            /*usedPositions[position.x-1][position.y] = true;
-            usedPositions[position.x+1][position.y] = true;
-            usedPositions[position.x][position.y-1] = true;
-            usedPositions[position.x][position.y+1] = true;*/
+            return s_ActiveGrid->IsValid(point);
+        }
+
+         void AStar::Update()
+        {
+            if(s_ActiveGrid)
+                s_ActiveGrid->Update();
+        }
+        
+         bool AStar::Reached(Int2 point, Node destination)
+        {
+            if (point.CheckSame(destination.position))
+            {
+
+                return true;
+            }
+
+            return false;
+        }
+
+         double AStar::heuristic(Int2 point, Node destination)
+        {
+            double H = (sqrt((point.x - destination.position.x)*(point.x - destination.position.x)
+                + (point.y - destination.position.y)*(point.y - destination.position.y)));
+            return H;
+        }
+        
+         void AStar::Init(Int2 startingPosition, Int2 xySize)
+        {
+            SetActiveGrid(Ref<AStarGrid>::Create(startingPosition, xySize));
+        }
+
+         void AStar::SetActiveGrid(const Ref<AStarGrid>& grid)
+        {
+            s_ActiveGrid = grid;
+            s_Hierarchy = nullptr;
+            s_PathService = nullptr;
+            s_FlowFields = nullptr;
+            if(!grid)
+                return;
+
+            // The hierarchy builds in the background, long requests use the flat search until it is ready
+            if(std::max(grid->GetSize().x, grid->GetSize().y) >= s_HierarchyMinSize)
+            {
+                s_Hierarchy = Ref<HPAStarGraph>::Create(grid);
+                if(s_BuildInBackground)
+                    s_Hierarchy->BuildAsync();
+                else
+                    s_Hierarchy->Build();
+            }
+            s_PathService = Ref<PathRequestService>::Create(grid, s_Hierarchy);
+            s_PathService->SetSliceBudget(s_PathSliceBudget);
+            s_FlowFields = Ref<FlowFieldCache>::Create(grid);
+        }
+
+         void AStar::SetPathSliceBudget(uint32_t slices)
+        {
+            s_PathSliceBudget = slices;
+            if(s_PathService)
+                s_PathService->SetSliceBudget(slices);
+        }
+
+         Ref<PathRequestService> AStar::GetPathService()
+        {
+            return s_PathService;
+        }
+
+         Ref<HPAStarGraph> AStar::GetHierarchy()
+        {
+            return s_Hierarchy;
+        }
+
+         Ref<FlowFieldCache> AStar::GetFlowFields()
+        {
+            return s_FlowFields;
+        }
+        
+         std::deque<Node> AStar::Algorithm(Node point, Node destination)
+        {
+            if(!s_ActiveGrid)
+            {
+                return {};    
+            }
+
+            return s_ActiveGrid->FindPath(point.position, destination.position);
+        }
+
+         Node AStar::GenerateRandomPosition(Int2 currentPosition)
+        {
+            if(!s_ActiveGrid)
+                return currentPosition;
+
+            return s_ActiveGrid->GenerateRandomPosition(currentPosition);
+        }
+
+         void AStar::SetSearchMode(AStarSearchMode mode)
+        {
+            if(s_ActiveGrid)
+                s_ActiveGrid->SetSearchMode(mode);
+        }
+
+         void AStar::AddUsedPosition(Int2 position, bool dynamic)
+        {
+            if(s_ActiveGrid)
+                s_ActiveGrid->AddUsedPosition(position, dynamic);
         }
         
      Int2 AStar::GetStartingPos()
         {
-            return startingPos;
+            if(!s_ActiveGrid)
+                return {0, 0};
+
+            return s_ActiveGrid->GetStartingPos();
         }
 
      Int2 AStar::GetEndPosition()
         {
-            return Int2(startingPos.x + size.x, startingPos.y + size.y);
+            if(!s_ActiveGrid)
+                return {0, 0};
+
+            return s_ActiveGrid->GetEndPosition();
         }
+
+#pragma endregion AStar
 }
\ No newline at end of file
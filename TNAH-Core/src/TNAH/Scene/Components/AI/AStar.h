@@ -6,7 +6,10 @@
  * @date   November 2021
  *********************************************************************/
 #pragma once
-#include <stack>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <cfloat>
 
 namespace tnah
 {
@@ -62,6 +65,848 @@ namespace tnah
         return left.f < right.f;
     }
     
+    /**
+     * @struct AStarCell
+     * @brief Per cell scratch data used while searching the dense grid
+     *
+     * @author chris
+     */
+    struct AStarCell
+    {
+        /** Cost from the start */
+        float g = FLT_MAX;
+        /** Estimated total cost */
+        float f = FLT_MAX;
+        /** Heuristic to the destination */
+        float h = FLT_MAX;
+        /** Index of the parent cell, -1 if none */
+        int parent = -1;
+        /** Position in the open list heap, -1 if not in the open list */
+        int heapIndex = -1;
+        /** The search this cell was last touched by */
+        uint32_t generation = 0;
+        /** If the cell has been expanded this search */
+        bool closed = false;
+    };
+
+    /**
+     * @class AStarSearchContext
+     * @brief The scratch memory for a single search. Each thread searching a grid needs its own context,
+     * contexts can be reused for any number of searches on grids of the same size.
+     *
+     * @author chris
+     */
+    class AStarSearchContext
+    {
+    public:
+        /**
+         *
+         * @fn Begin
+         * @brief Starts a new search, sizing the context to the grid and invalidating the previous search
+         * 
+         * @param cellCount
+         * @param startIndex
+         * @param destinationIndex
+         * @author chris
+         */
+        void Begin(size_t cellCount, int startIndex = -1, int destinationIndex = -1);
+
+        /**
+         *
+         * @fn GetStartIndex
+         * @brief Gets the cell the current search started from
+         *
+         * @return int
+         * @author chris
+         */
+        int GetStartIndex() const { return m_StartIndex; }
+
+        /**
+         *
+         * @fn GetDestinationIndex
+         * @brief Gets the cell the current search is looking for
+         *
+         * @return int
+         * @author chris
+         */
+        int GetDestinationIndex() const { return m_DestinationIndex; }
+
+        /**
+         *
+         * @fn CountExpansion
+         * @brief Counts a cell taken off the open list
+         *
+         * @author chris
+         */
+        void CountExpansion() { m_Expansions++; }
+
+        /**
+         *
+         * @fn GetExpansions
+         * @brief Gets the number of cells expanded by the current search
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetExpansions() const { return m_Expansions; }
+
+        /**
+         *
+         * @fn Touch
+         * @brief Resets the cell if it was last used by an older search and returns it
+         *
+         * @param index
+         * @return AStarCell&
+         * @author chris
+         */
+        AStarCell& Touch(int index);
+
+        /**
+         *
+         * @fn Cell
+         * @brief Gets a cell already touched by the current search
+         *
+         * @param index
+         * @return AStarCell&
+         * @author chris
+         */
+        AStarCell& Cell(int index) { return m_Cells[index]; }
+
+        /**
+         *
+         * @fn OpenEmpty
+         * @brief Checks if the open list is empty
+         *
+         * @return bool
+         * @author chris
+         */
+        bool OpenEmpty() const { return m_OpenList.empty(); }
+
+        /**
+         *
+         * @fn OpenPush
+         * @brief Adds the cell to the open list heap
+         *
+         * @param index
+         * @author chris
+         */
+        void OpenPush(int index);
+
+        /**
+         *
+         * @fn OpenPop
+         * @brief Removes and returns the open cell with the lowest f
+         *
+         * @return int
+         * @author chris
+         */
+        int OpenPop();
+
+        /**
+         *
+         * @fn OpenDecrease
+         * @brief Moves a cell up the heap after its f value was lowered
+         *
+         * @param index
+         * @author chris
+         */
+        void OpenDecrease(int index);
+
+    private:
+        /**
+         *
+         * @fn OpenLess
+         * @brief Heap ordering, lower f first and lower h on ties
+         *
+         * @param left
+         * @param right
+         * @return bool
+         * @author chris
+         */
+        bool OpenLess(int left, int right) const;
+
+        /**
+         *
+         * @fn SiftUp
+         * @brief Restores the heap order upwards from the given heap slot
+         *
+         * @param heapPos
+         * @author chris
+         */
+        void SiftUp(int heapPos);
+
+        /**
+         *
+         * @fn SiftDown
+         * @brief Restores the heap order downwards from the given heap slot
+         *
+         * @param heapPos
+         * @author chris
+         */
+        void SiftDown(int heapPos);
+
+        /** The dense row major grid of search cells */
+        std::vector<AStarCell> m_Cells;
+        /** The open list as a binary heap of cell indices */
+        std::vector<int> m_OpenList;
+        /** The current search generation, cells with an older generation are treated as unvisited */
+        uint32_t m_Generation = 0;
+        /** The cell the current search started from */
+        int m_StartIndex = -1;
+        /** The cell the current search is looking for */
+        int m_DestinationIndex = -1;
+        /** Cells expanded by the current search */
+        size_t m_Expansions = 0;
+    };
+
+    /**
+     * @enum AStarSearchMode
+     * @brief How a grid expands cells while searching, both give paths of the same cost
+     *
+     * @author chris
+     */
+    enum class AStarSearchMode
+    {
+        /** Every walkable neighbour is expanded */
+        AStar,
+        /** Jump point search, only cells where the path may have to turn are expanded */
+        JumpPoint
+    };
+
+    /**
+     * @struct AStarCellChange
+     * @brief A cell that became used or free, recorded so listeners can update only what changed
+     *
+     * @author chris
+     */
+    struct AStarCellChange
+    {
+        /** The occupancy version the change produced */
+        uint64_t Version = 0;
+        /** Row major index of the cell */
+        int Index = -1;
+        /** If the cell is now used */
+        bool Used = false;
+    };
+
+    /**
+     * @enum AStarSearchStatus
+     * @brief The state of a search that is run in slices
+     *
+     * @author chris
+     */
+    enum class AStarSearchStatus
+    {
+        Searching, Found, Failed
+    };
+
+    /**
+     * @struct PathRequest
+     * @brief A single path query used by AStarGrid::SolveBatch
+     *
+     * @author chris
+     */
+    struct PathRequest
+    {
+        PathRequest() = default;
+        PathRequest(Int2 start, Int2 destination) : Start(start), Destination(destination) {}
+
+        /** Where the path starts */
+        Int2 Start;
+        /** Where the path should end */
+        Int2 Destination;
+        /** The resulting path, empty if no path was found */
+        std::deque<Node> Path = {};
+    };
+
+    /**
+     * @class AStarGrid
+     * @brief A pathfinding grid. The grid itself is only read while searching, so any number of searches can run
+     * on it at once as long as each uses its own AStarSearchContext and obstacles are not changed meanwhile.
+     * Occupancy is a packed bitset made from a static layer that is baked once and a dynamic layer that is only
+     * touched when an obstacle moves into a different cell.
+     *
+     * @author chris
+     */
+    class AStarGrid : public RefCounted
+    {
+    public:
+        AStarGrid(Int2 startingPosition = {0, 0}, Int2 xySize = {10, 10});
+        ~AStarGrid() = default;
+
+        /**
+         *
+         * @fn IsValid
+         * @brief Checks if the given point is in the grid and not used by an obstacle
+         * 
+         * @param point
+         * @return bool
+         * @author chris
+         */
+        bool IsValid(Int2 point) const { return InBounds(point) && !testBit(m_UsedBits, ToIndex(point)); }
+
+        /**
+         *
+         * @fn InBounds
+         * @brief Checks if the point lies inside the grid
+         *
+         * @param point
+         * @return bool
+         * @author chris
+         */
+        bool InBounds(Int2 point) const
+        {
+            return point.x >= m_StartingPos.x && point.y >= m_StartingPos.y
+                && point.x < m_StartingPos.x + m_Size.x && point.y < m_StartingPos.y + m_Size.y;
+        }
+
+        /**
+         *
+         * @fn IsUsed
+         * @brief Checks if an obstacle currently occupies the point
+         *
+         * @param point
+         * @return bool
+         * @author chris
+         */
+        bool IsUsed(Int2 point) const { return InBounds(point) && testBit(m_UsedBits, ToIndex(point)); }
+
+        /**
+         *
+         * @fn IsUsedIndex
+         * @brief Checks if an obstacle occupies the cell at the row major index, the index must be in the grid
+         *
+         * @param index
+         * @return bool
+         * @author chris
+         */
+        bool IsUsedIndex(int index) const { return testBit(m_UsedBits, index); }
+
+        /**
+         *
+         * @fn IsStaticIndex
+         * @brief Checks if the static layer blocks the cell at the row major index, the index must be in the grid
+         *
+         * @param index
+         * @return bool
+         * @author chris
+         */
+        bool IsStaticIndex(int index) const { return testBit(m_StaticBits, index); }
+
+        /**
+         *
+         * @fn Update
+         * @brief Clears the positions added with AddUsedPosition as dynamic, called once per frame after all searches are done
+         * 
+         * @author chris
+         */
+        void Update();
+
+        /**
+         *
+         * @fn AddUsedPosition
+         * @brief Marks the position as used, a dynamic position is freed again by the next Update
+         * 
+         * @param position
+         * @param dynamic
+         * @author chris
+         */
+        void AddUsedPosition(Int2 position, bool dynamic);
+
+        /**
+         *
+         * @fn BeginObstacleFrame
+         * @brief Starts a round of obstacle registration, dynamic obstacles not set before EndObstacleFrame are removed
+         *
+         * @author chris
+         */
+        void BeginObstacleFrame() { m_ObstacleFrame++; }
+
+        /**
+         *
+         * @fn BakeStaticObstacle
+         * @brief Bakes a static obstacle into the static layer, an obstacle baked again only changes the grid if it moved cell
+         *
+         * @param id unique id of the obstacle
+         * @param position
+         * @author chris
+         */
+        void BakeStaticObstacle(uint32_t id, Int2 position);
+
+        /**
+         *
+         * @fn UnbakeStaticObstacle
+         * @brief Removes a baked static obstacle, its cell is freed unless another obstacle or the walkability bake still blocks it
+         *
+         * @param id unique id of the obstacle
+         * @author chris
+         */
+        void UnbakeStaticObstacle(uint32_t id);
+
+        /**
+         *
+         * @fn SkipStaticObstacle
+         * @brief Marks a static obstacle as already stamped by the walkability bake, BakeStaticObstacle ignores it from then on
+         *
+         * @param id unique id of the obstacle
+         * @author chris
+         */
+        void SkipStaticObstacle(uint32_t id) { m_SkippedObstacles.insert(id); }
+
+        /**
+         *
+         * @fn BakeStaticCells
+         * @brief Adds every cell set in the bitset to the static layer, used to apply baked walkability
+         *
+         * @param blocked one bit per cell in row major order
+         * @author chris
+         */
+        void BakeStaticCells(const std::vector<uint64_t>& blocked);
+
+        /**
+         *
+         * @fn GetUsedCells
+         * @brief Gets the occupancy of every cell, static and dynamic layers together
+         *
+         * @return one bit per cell in row major order
+         * @author chris
+         */
+        const std::vector<uint64_t>& GetUsedCells() const { return m_UsedBits; }
+
+        /**
+         *
+         * @fn SetDynamicObstacle
+         * @brief Places a dynamic obstacle, the grid only changes if it moved into a different cell
+         *
+         * @param id unique id of the obstacle
+         * @param position
+         * @author chris
+         */
+        void SetDynamicObstacle(uint32_t id, Int2 position);
+
+        /**
+         *
+         * @fn EndObstacleFrame
+         * @brief Removes the dynamic obstacles that were not set since BeginObstacleFrame
+         *
+         * @author chris
+         */
+        void EndObstacleFrame();
+
+        /**
+         *
+         * @fn GetChangedCells
+         * @brief Gets the cells that became used or free after the given version, oldest first
+         *
+         * @param sinceVersion
+         * @param changes
+         * @return false if the history no longer reaches back that far and everything has to be treated as changed
+         * @author chris
+         */
+        bool GetChangedCells(uint64_t sinceVersion, std::vector<AStarCellChange>& changes) const;
+
+        /**
+         *
+         * @fn FindPath
+         * @brief Finds a path using the given scratch context, safe to call from several threads with different contexts
+         *
+         * @param start
+         * @param destination
+         * @param context
+         * @return std::deque<Node>
+         * @author chris
+         */
+        std::deque<Node> FindPath(Int2 start, Int2 destination, AStarSearchContext& context) const;
+
+        /**
+         *
+         * @fn FindPath
+         * @brief Finds a path using the grids own context, main thread only
+         *
+         * @param start
+         * @param destination
+         * @return std::deque<Node>
+         * @author chris
+         */
+        std::deque<Node> FindPath(Int2 start, Int2 destination);
+
+        /**
+         *
+         * @fn BeginSearch
+         * @brief Starts a search that can be run a slice at a time with ContinueSearch
+         *
+         * @param start
+         * @param destination
+         * @param context
+         * @return Failed if the search can never succeed, otherwise Searching
+         * @author chris
+         */
+        AStarSearchStatus BeginSearch(Int2 start, Int2 destination, AStarSearchContext& context) const;
+
+        /**
+         *
+         * @fn ContinueSearch
+         * @brief Expands at most the given number of cells of a search started with BeginSearch
+         *
+         * @param context
+         * @param maxExpansions
+         * @return Found once the destination is reached, Failed once the open list runs out, otherwise Searching
+         * @author chris
+         */
+        AStarSearchStatus ContinueSearch(AStarSearchContext& context, size_t maxExpansions) const;
+
+        /**
+         *
+         * @fn GetSearchPath
+         * @brief Gets the path of a search that returned Found
+         *
+         * @param context
+         * @return std::deque<Node>
+         * @author chris
+         */
+        std::deque<Node> GetSearchPath(AStarSearchContext& context) const { return makePath(context.GetDestinationIndex(), context); }
+
+        /**
+         *
+         * @fn SolveBatch
+         * @brief Solves every request, spreading them over the job system. The results are identical to solving them one by one.
+         * Several threads may solve batches on the same grid at once, threads the job system does not own search with their own context.
+         *
+         * @param requests
+         * @param count
+         * @author chris
+         */
+        void SolveBatch(PathRequest* requests, size_t count);
+
+        /**
+         *
+         * @fn SolveBatch
+         * @brief Solves every request in the vector
+         *
+         * @param requests
+         * @author chris
+         */
+        void SolveBatch(std::vector<PathRequest>& requests) { SolveBatch(requests.data(), requests.size()); }
+
+        /**
+         *
+         * @fn GenerateRandomPosition
+         * @brief Picks a random free cell other than the current position, in constant time from the free list
+         * 
+         * @param currentPosition
+         * @return the cell, 0,0 if there is no other free cell
+         * @author chris
+         */
+        Node GenerateRandomPosition(Int2 currentPosition) const;
+
+        /**
+         *
+         * @fn HasLineOfSight
+         * @brief Checks if every cell a straight line between two cell centres passes through is valid. A line through a
+         * cell corner needs both cells beside the corner to be valid
+         *
+         * @param from
+         * @param to
+         * @param staticOnly only looks at the static layer, for agents that steer around moving obstacles themselves
+         * @return bool
+         * @author chris
+         */
+        bool HasLineOfSight(Int2 from, Int2 to, bool staticOnly = false) const;
+
+        /**
+         *
+         * @fn SmoothPath
+         * @brief Pulls the path tight, keeping only the corners where a straight line to the next kept node would cross a used cell
+         *
+         * @param path
+         * @author chris
+         */
+        void SmoothPath(std::deque<Node>& path) const;
+
+        /**
+         *
+         * @fn GetStartingPos
+         * @brief Gets the starting position
+         * 
+         * @return 
+         * @author chris
+         */
+        Int2 GetStartingPos() const { return m_StartingPos; }
+
+        /**
+         *
+         * @fn GetEndPosition
+         * @brief Gets the end position
+         * 
+         * @return 
+         * @author chris
+         */
+        Int2 GetEndPosition() const { return Int2(m_StartingPos.x + m_Size.x, m_StartingPos.y + m_Size.y); }
+
+        /**
+         *
+         * @fn GetSize
+         * @brief Gets the size of the grid
+         *
+         * @return
+         * @author chris
+         */
+        Int2 GetSize() const { return m_Size; }
+
+        /**
+         *
+         * @fn GetCellCount
+         * @brief Gets the number of cells in the grid
+         *
+         * @return
+         * @author chris
+         */
+        size_t GetCellCount() const { return static_cast<size_t>(m_Size.x) * static_cast<size_t>(m_Size.y); }
+
+        /**
+         *
+         * @fn ToIndex
+         * @brief Converts a grid position into its row major index
+         *
+         * @param point
+         * @return int
+         * @author chris
+         */
+        int ToIndex(Int2 point) const { return (point.y - m_StartingPos.y) * m_Size.x + (point.x - m_StartingPos.x); }
+
+        /**
+         *
+         * @fn ToPosition
+         * @brief Converts a row major index back into a grid position
+         *
+         * @param index
+         * @return Int2
+         * @author chris
+         */
+        Int2 ToPosition(int index) const { return Int2(m_StartingPos.x + index % m_Size.x, m_StartingPos.y + index / m_Size.x); }
+
+        /**
+         *
+         * @fn GetVersion
+         * @brief Gets the occupancy version, it is bumped every time a cell becomes used or free and works as the tick for GetChangedCells
+         *
+         * @return uint64_t
+         * @author chris
+         */
+        uint64_t GetVersion() const { return m_Version; }
+
+        /**
+         *
+         * @fn SetSearchMode
+         * @brief Sets how searches on this grid expand cells
+         *
+         * @param mode
+         * @author chris
+         */
+        void SetSearchMode(AStarSearchMode mode) { m_SearchMode = mode; }
+
+        /**
+         *
+         * @fn GetSearchMode
+         * @brief Gets how searches on this grid expand cells
+         *
+         * @return AStarSearchMode
+         * @author chris
+         */
+        AStarSearchMode GetSearchMode() const { return m_SearchMode; }
+
+    private:
+        /**
+         *
+         * @fn expandNeighbours
+         * @brief Relaxes every walkable neighbour of the cell
+         *
+         * @param current
+         * @param context
+         * @param goal
+         * @author chris
+         */
+        void expandNeighbours(int current, AStarSearchContext& context, const Node& goal) const;
+
+        /**
+         *
+         * @fn expandJumpPoints
+         * @brief Relaxes the jump points reachable from the cell in the directions left after pruning
+         *
+         * @param current
+         * @param context
+         * @param goal
+         * @author chris
+         */
+        void expandJumpPoints(int current, AStarSearchContext& context, const Node& goal) const;
+
+        /**
+         *
+         * @fn jump
+         * @brief Scans from the cell in one direction until a jump point, the destination or a blocked cell
+         *
+         * @param from
+         * @param dx
+         * @param dy
+         * @param destinationIndex
+         * @return the index of the jump point, -1 if there is none
+         * @author chris
+         */
+        int jump(Int2 from, int dx, int dy, int destinationIndex) const;
+
+        /**
+         *
+         * @fn relax
+         * @brief Opens the next cell or lowers its cost if reaching it through the current cell is cheaper
+         *
+         * @param current
+         * @param next
+         * @param cost
+         * @param context
+         * @param goal
+         * @author chris
+         */
+        void relax(int current, int next, float cost, AStarSearchContext& context, const Node& goal) const;
+
+        /**
+         *
+         * @fn makePath
+         * @brief Creates the path by following the parents back from the destination, filling in cells skipped by jumps
+         *
+         * @param destinationIndex
+         * @param context
+         * @return
+         * @author chris
+         */
+        std::deque<Node> makePath(int destinationIndex, AStarSearchContext& context) const;
+
+        /**  The starting position*/
+        Int2 m_StartingPos = {0, 0};
+        /** The overall size */
+        Int2 m_Size = {10, 10};
+        /**
+         *
+         * @fn testBit
+         * @brief Tests a bit of a packed bitset
+         *
+         * @param bits
+         * @param index
+         * @return bool
+         * @author chris
+         */
+        static bool testBit(const std::vector<uint64_t>& bits, int index) { return (bits[index >> 6] >> (index & 63)) & 1ull; }
+
+        /**
+         *
+         * @fn addDynamic
+         * @brief Adds one dynamic obstacle to the cell
+         *
+         * @param index
+         * @author chris
+         */
+        void addDynamic(int index);
+
+        /**
+         *
+         * @fn removeDynamic
+         * @brief Removes one dynamic obstacle from the cell
+         *
+         * @param index
+         * @author chris
+         */
+        void removeDynamic(int index);
+
+        /**
+         *
+         * @fn addStatic
+         * @brief Adds one baked static obstacle to the cell
+         *
+         * @param index
+         * @author chris
+         */
+        void addStatic(int index);
+
+        /**
+         *
+         * @fn removeStatic
+         * @brief Removes one baked static obstacle from the cell
+         *
+         * @param index
+         * @author chris
+         */
+        void removeStatic(int index);
+
+        /**
+         *
+         * @fn refreshCell
+         * @brief Recomputes the used bit of the cell from both layers and records the change if it flipped
+         *
+         * @param index
+         * @author chris
+         */
+        void refreshCell(int index);
+
+        /** A dynamic obstacle known to the grid */
+        struct DynamicObstacle
+        {
+            /** The cell it occupies, -1 if it is outside the grid */
+            int Index = -1;
+            /** The obstacle frame it was last set in */
+            uint64_t Frame = 0;
+        };
+
+        /** One bit per cell, set if the cell is used by either layer */
+        std::vector<uint64_t> m_UsedBits;
+        /** One bit per cell, set if a static obstacle was baked into the cell */
+        std::vector<uint64_t> m_StaticBits;
+        /** One bit per cell, set if the cell was blocked for good through BakeStaticCells or a static AddUsedPosition */
+        std::vector<uint64_t> m_PermanentBits;
+        /** Number of baked static obstacles in each cell that has any */
+        std::unordered_map<int, uint16_t> m_ObstacleCounts;
+        /** Number of dynamic obstacles in each cell */
+        std::vector<uint16_t> m_DynamicCounts;
+        /** Every cell that is not used, in no particular order */
+        std::vector<int> m_FreeCells;
+        /** The slot of each cell in the free list, -1 if it is used */
+        std::vector<int> m_FreeSlots;
+        /** The baked static obstacles and the cells they are in */
+        std::unordered_map<uint32_t, int> m_BakedObstacles;
+        /** The static obstacles the walkability bake already stamped */
+        std::unordered_set<uint32_t> m_SkippedObstacles;
+        /** The dynamic obstacles and the cells they are in */
+        std::unordered_map<uint32_t, DynamicObstacle> m_DynamicObstacles;
+        /** The current obstacle frame */
+        uint64_t m_ObstacleFrame = 0;
+        /**  The positions added as dynamic through AddUsedPosition, freed by Update*/
+        std::vector<int> m_UsedPositionsHolder;
+        /** Recent cell changes in version order */
+        std::deque<AStarCellChange> m_Changes;
+        /** Changes up to this version may have been dropped from the history */
+        uint64_t m_HistoryStart = 0;
+        /** The most changes kept in the history */
+        static constexpr size_t s_MaxChangeHistory = 1 << 16;
+        /** Context used by searches from the main thread */
+        AStarSearchContext m_MainContext;
+        /** One context per job system thread used by SolveBatch */
+        std::vector<AStarSearchContext> m_WorkerContexts;
+        /** Guards growing m_WorkerContexts when batches start on several threads at once */
+        std::mutex m_WorkerContextsLock;
+        /** Bumped whenever a cell becomes used or free */
+        uint64_t m_Version = 0;
+        /** How searches expand cells */
+        AStarSearchMode m_SearchMode = AStarSearchMode::AStar;
+    };
+
+    class PathRequestService;
+    class FlowFieldCache;
+    class HPAStarGraph;
+    
+    /**
+     * @class AStar
+     * @brief Static access to the active pathfinding grid, kept so gameplay code does not need to carry a grid around
+     *
+     * @author chris
+     */
     class AStar
     {
     public:
@@ -115,7 +960,7 @@ namespace tnah
         /**
          *
          * @fn Init
-         * @brief Initilises the astar map
+         * @brief Creates a new grid and makes it the active one
          * 
          * @param startingPosition
          * @param xySize
@@ -138,33 +983,23 @@ namespace tnah
         /**
          *
          * @fn GenerateRandomPosition
-         * @brief Generates a random position on the map
+         * @brief Picks a random free cell other than the current position, in constant time from the free list
          * 
          * @param currentPosition
-         * @return 
+         * @return the cell, 0,0 if there is no other free cell
          * @author chris
          */
         static Node GenerateRandomPosition(Int2 currentPosition);
-        
-        /**
-         *
-         * @fn GetMapPoints
-         * @brief Gets the map points
-         * 
-         * @return 
-         * @author chris
-         */
-        static std::unordered_map<int, std::unordered_map<int, Node>> GetMapPoints();
 
         /**
          *
-         * @fn GetUsedPoints
-         * @brief Gets the map points taht are obstacles
-         * 
-         * @return 
+         * @fn SetSearchMode
+         * @brief Sets how searches on the active grid expand cells
+         *
+         * @param mode
          * @author chris
          */
-        static std::unordered_map<int, std::unordered_map<int, bool>> GetUsedPoints();
+        static void SetSearchMode(AStarSearchMode mode);
 
         /**
          *
@@ -196,35 +1031,117 @@ namespace tnah
          * @author chris
          */
         static Int2 GetEndPosition();
-    
-    private:
+
         /**
          *
-         * @fn makePath
-         * @brief Creates the path used in the algorithm
+         * @fn SetActiveGrid
+         * @brief Sets the grid used by the static functions and creates a path request service and flow field cache for it, large grids also get a hierarchical graph
+         *
+         * @param grid
+         * @author chris
+         */
+        static void SetActiveGrid(const Ref<AStarGrid>& grid);
+
+        /**
+         *
+         * @fn SetBuildInBackground
+         * @brief Sets if grids made active from now on build their hierarchical graph on the job system. When a
+         * background build is picked up depends on timing, so runs that have to repeat exactly build it in SetActiveGrid.
+         *
+         * @param background
+         * @author chris
+         */
+        static void SetBuildInBackground(bool background) { s_BuildInBackground = background; }
+
+        /**
+         *
+         * @fn GetBuildInBackground
+         * @brief Gets if grids made active build their hierarchical graph on the job system
+         *
+         * @return bool
+         * @author chris
+         */
+        static bool GetBuildInBackground() { return s_BuildInBackground; }
+
+        /**
+         *
+         * @fn SetPathSliceBudget
+         * @brief Sets the slice budget of the active path service and of every one made for a grid after
+         *
+         * @param slices the search slices each Process runs, 0 to run on the time budget
+         * @author chris
+         */
+        static void SetPathSliceBudget(uint32_t slices);
+
+        /**
+         *
+         * @fn GetActiveGrid
+         * @brief Gets the grid used by the static functions, may be null
          *
-         * @param map
-         * @param destination
          * @return
          * @author chris
          */
-        static std::deque<Node> makePath(std::unordered_map<int, std::unordered_map<int, Node>> map, Node destination);
-        /**  If it is initilised*/
-        inline static bool initilised = false;
-        /**  The starting position*/
-        inline static Int2 startingPos = {0, 0};
-        /** The overall size */
-        inline static Int2 size = {10, 10};
-        /** If it has been generated  */
-        inline static bool generated = false;
-        /**  The map holding the closed list*/
-        inline static std::unordered_map<int, std::unordered_map<int, bool>> closedList = std::unordered_map<int, std::unordered_map<int, bool>>();
-        /**  The map holding the used position*/
-        inline static std::unordered_map<int, std::unordered_map<int, bool>> usedPositions = std::unordered_map<int, std::unordered_map<int, bool>>();
-        /** The map holding the overall map */
-        inline static std::unordered_map<int, std::unordered_map<int, Node>> astarMap = std::unordered_map<int, std::unordered_map<int, Node>>();
-        /**  The vector holding the dynamic positions*/
-        inline static std::vector<Int2> usedPositionsHolder = std::vector<Int2>();
+        static Ref<AStarGrid> GetActiveGrid() { return s_ActiveGrid; }
+
+        /**
+         *
+         * @fn GetPathService
+         * @brief Gets the path request service of the active grid, may be null
+         *
+         * @return
+         * @author chris
+         */
+        static Ref<PathRequestService> GetPathService();
+
+        /**
+         *
+         * @fn GetHierarchy
+         * @brief Gets the hierarchical graph of the active grid, null if the grid is too small to need one
+         *
+         * @return
+         * @author chris
+         */
+        static Ref<HPAStarGraph> GetHierarchy();
+
+        /**
+         *
+         * @fn GetFlowFields
+         * @brief Gets the flow field cache of the active grid, may be null
+         *
+         * @return
+         * @author chris
+         */
+        static Ref<FlowFieldCache> GetFlowFields();
+    
+    private:
+        /** The grid used by the static functions */
+        inline static Ref<AStarGrid> s_ActiveGrid = nullptr;
+        /** The path request service for the active grid */
+        static Ref<PathRequestService> s_PathService;
+        /** The hierarchical graph for the active grid */
+        static Ref<HPAStarGraph> s_Hierarchy;
+        /** The flow fields for the active grid */
+        static Ref<FlowFieldCache> s_FlowFields;
+        /** If new hierarchical graphs build on the job system */
+        inline static bool s_BuildInBackground = true;
+        /** The slice budget new path services start with */
+        inline static uint32_t s_PathSliceBudget = 0;
+        /** Grids with a side at least this long get a hierarchical graph */
+        static constexpr int s_HierarchyMinSize = 128;
+    };
+
+    /**
+     * @struct WalkabilitySettings
+     * @brief The limits a cell of terrain has to be inside to be walkable
+     *
+     * @author chris
+     */
+    struct WalkabilitySettings
+    {
+        /** Steepest walkable slope in degrees */
+        float MaxSlope = 40.0f;
+        /** Largest height difference to a neighbouring cell that can be stepped up or down */
+        float MaxStep = 0.75f;
     };
 
     struct AStarComponent
@@ -235,6 +1152,9 @@ namespace tnah
         {
             StartingPos = copy.StartingPos;
             Size = copy.Size;
+            JumpPointSearch = copy.JumpPointSearch;
+            Walkability = copy.Walkability;
+            WalkabilityCache = copy.WalkabilityCache;
         }
         /**  */
         Int2 StartingPos = {0, 0};
@@ -244,6 +1164,14 @@ namespace tnah
         bool DisplayMap = false;
         /**  */
         bool reset = true;
+        /** If the grid searches with jump point search instead of plain A* */
+        bool JumpPointSearch = false;
+        /** Limits used when baking walkability from the terrain */
+        WalkabilitySettings Walkability = {};
+        /** File the baked walkability is cached in, empty to bake every time */
+        std::string WalkabilityCache = "";
+        /** The grid built from this component */
+        Ref<AStarGrid> Grid = nullptr;
     private:
         inline static std::string s_SearchString = "AStar Component";
         /** @brief	Type identifiers for the component */
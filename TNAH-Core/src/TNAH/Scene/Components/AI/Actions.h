@@ -15,6 +15,8 @@ namespace tnah
     {
         sit = 1, kick = 2, punch = 3, none = 0, greeting = 4, pickup = 5, abuse = 6, sleep = 7, drink = 9, play = 10
     };
+    /** \brief Size of a table indexed by Actions */
+    constexpr size_t ActionCount = play + 1;
     /** \enum PlayerActions the actions players can do */
     enum PlayerActions
     {
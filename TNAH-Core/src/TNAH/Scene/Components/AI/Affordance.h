@@ -7,7 +7,7 @@
 *********************************************************************/
 #pragma once
 #include "Actions.h"
-#include <unordered_map>
+#include <array>
 namespace tnah
 {
     class Affordance
@@ -27,7 +27,7 @@ namespace tnah
          * @return float
          * @author chris
          */
-        float GetActionValue(Actions action);
+        float GetActionValue(Actions action) const { return objectsActions[action]; }
         /**
          *
          * @fn SetActionValues
@@ -45,7 +45,7 @@ namespace tnah
          * @return 
          * @author chris
          */
-        std::string GetTag() const {return tag;}
+        const std::string& GetTag() const {return tag;}
         /**
          *
          * @fn GetActionString
@@ -60,10 +60,11 @@ namespace tnah
         /**
          *
          * @fn GetActions
+         * @brief Gets the value of every action, indexed by Actions
          *
          * @author chris
          */
-        std::unordered_map<Actions, float> GetActions() {return objectsActions;};
+        const std::array<float, ActionCount>& GetActions() const {return objectsActions;}
 
         ///Editor value
         float editorValue = 0;
@@ -75,8 +76,8 @@ namespace tnah
         ///The tag
         std::string tag;
 
-        ///The objects actions
-        std::unordered_map<Actions, float> objectsActions;
+        ///The objects actions, indexed by Actions
+        std::array<float, ActionCount> objectsActions = {};
         inline static std::string s_SearchString = "Affordance";
         /** @brief	Type identifiers for the component */
         inline static ComponentTypes s_Types = {
@@ -0,0 +1,103 @@
+﻿#include "tnahpch.h"
+#include "AffordanceScorer.h"
+#include "Affordance.h"
+#include "TNAH/Core/JobSystem.h"
+
+namespace tnah
+{
+    void AffordanceScorer::Clear()
+    {
+        m_ObjectPositions.clear();
+        m_ObjectHeights.clear();
+        m_ObjectValues.clear();
+        m_ObjectIds.clear();
+        m_ObjectTags.clear();
+        m_ObjectIndices.clear();
+        m_AgentPositions.clear();
+        m_AgentRanges.clear();
+        m_AgentActions.clear();
+        m_Choices.clear();
+        m_KnownBegin.assign(1, 0);
+        m_KnownObjects.clear();
+    }
+
+    int AffordanceScorer::AddObject(uint32_t id, const glm::vec3& position, const Affordance& affordance)
+    {
+        m_ObjectPositions.emplace_back(position.x, position.z);
+        m_ObjectHeights.push_back(position.y);
+        const auto& values = affordance.GetActions();
+        m_ObjectValues.insert(m_ObjectValues.end(), values.begin(), values.end());
+        m_ObjectIds.push_back(id);
+        m_ObjectTags.push_back(&affordance.GetTag());
+        m_ObjectIndices[id] = static_cast<int>(m_ObjectIds.size()) - 1;
+        return static_cast<int>(m_ObjectIds.size()) - 1;
+    }
+
+    size_t AffordanceScorer::AddAgent(const glm::vec3& position, float range, Actions desired, const PerceptionComponent& perception)
+    {
+        m_AgentPositions.push_back(position);
+        m_AgentRanges.push_back(range);
+        m_AgentActions.push_back(desired);
+        m_Choices.emplace_back();
+
+        // Copied rather than pointed at, the components can move before the agents are scored
+        for(size_t i = 0; i < perception.GetKnownCount(); i++)
+        {
+            const PerceivedEntity& known = perception.GetKnown(i);
+            if(known.Kind == PerceivedKind::Object)
+                m_KnownObjects.push_back(known.Id);
+        }
+        m_KnownBegin.push_back(m_KnownObjects.size());
+        return m_AgentPositions.size() - 1;
+    }
+
+    void AffordanceScorer::Score()
+    {
+        // Every agent only writes its own choice, so chunks of agents can run on any thread
+        JobSystem::ParallelFor(m_AgentPositions.size(), s_ParallelGrain, [this](size_t begin, size_t end)
+        {
+            Score(begin, end);
+        });
+    }
+
+    void AffordanceScorer::Score(size_t begin, size_t end)
+    {
+        for(size_t agent = begin; agent < end; agent++)
+        {
+            AffordanceChoice best;
+            const glm::vec3 position = m_AgentPositions[agent];
+            const float range = m_AgentRanges[agent];
+            const float rangeSquared = range * range;
+            const size_t action = static_cast<size_t>(m_AgentActions[agent]);
+            float bestDistanceSquared = 0.0f;
+
+            for(size_t known = m_KnownBegin[agent]; known < m_KnownBegin[agent + 1]; known++)
+            {
+                // Objects the agent knows about may have lost their affordance since it last looked
+                const auto found = m_ObjectIndices.find(m_KnownObjects[known]);
+                if(found == m_ObjectIndices.end())
+                    continue;
+
+                const int object = found->second;
+                const glm::vec2& objectPosition = m_ObjectPositions[object];
+                const float dx = objectPosition.x - position.x;
+                const float dy = m_ObjectHeights[object] - position.y;
+                const float dz = objectPosition.y - position.z;
+                const float distanceSquared = dx * dx + dy * dy + dz * dz;
+                if(distanceSquared >= rangeSquared)
+                    continue;
+
+                const float value = m_ObjectValues[object * ActionCount + action];
+                if(best.Object < 0 || value > best.Value || (value == best.Value && distanceSquared < bestDistanceSquared))
+                {
+                    best.Object = object;
+                    best.Value = value;
+                    bestDistanceSquared = distanceSquared;
+                }
+            }
+
+            best.Distance = std::sqrt(bestDistanceSquared);
+            m_Choices[agent] = best;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+﻿/*****************************************************************//**
+ * @file   AffordanceScorer.h
+ * @brief  Scores the affordances around every agent in one batched pass
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "Actions.h"
+#include "Perception.h"
+
+namespace tnah
+{
+    class Affordance;
+
+    /**
+     * @struct AffordanceChoice
+     * @brief The object an agent picked for its desired action
+     *
+     * @author chris
+     */
+    struct AffordanceChoice
+    {
+        /** Index of the object, -1 if nothing was in range */
+        int Object = -1;
+        /** Value the object affords the action */
+        float Value = 0.0f;
+        /** Distance to the object */
+        float Distance = 0.0f;
+    };
+
+    /**
+     * @class AffordanceScorer
+     * @brief Works out which object every agent should act on. Objects are copied in with their action values as one
+     * dense row per object, and each agent only scores the objects its perception already knows about and that are in
+     * its range. The highest value for the agent's desired action wins, the nearest on a tie. Agents only read the
+     * shared state and write their own choice, so any range of agents can be scored on its own.
+     *
+     * @author chris
+     */
+    class AffordanceScorer : public RefCounted
+    {
+    public:
+        AffordanceScorer() = default;
+        ~AffordanceScorer() = default;
+
+        /**
+         *
+         * @fn Clear
+         * @brief Removes every object and agent, called before those of a frame are added
+         *
+         * @author chris
+         */
+        void Clear();
+
+        /**
+         *
+         * @fn AddObject
+         * @brief Adds an object that can be acted on
+         *
+         * @param id caller's id for the object, handed back with the choice
+         * @param position
+         * @param affordance
+         * @return the index of the object
+         * @author chris
+         */
+        int AddObject(uint32_t id, const glm::vec3& position, const Affordance& affordance);
+
+        /**
+         *
+         * @fn AddAgent
+         * @brief Adds an agent looking for an object to act on
+         *
+         * @param position
+         * @param range how far the agent looks
+         * @param desired the action the agent wants to do
+         * @param perception what the agent knows about, the objects in it are copied out
+         * @return the index of the agent
+         * @author chris
+         */
+        size_t AddAgent(const glm::vec3& position, float range, Actions desired, const PerceptionComponent& perception);
+
+        /**
+         *
+         * @fn Score
+         * @brief Scores every agent, in chunks across the job system
+         *
+         * @author chris
+         */
+        void Score();
+
+        /**
+         *
+         * @fn Score
+         * @brief Scores a range of agents
+         *
+         * @param begin
+         * @param end
+         * @author chris
+         */
+        void Score(size_t begin, size_t end);
+
+        /**
+         *
+         * @fn GetChoice
+         * @brief Gets the object an agent picked
+         *
+         * @param agent
+         * @return AffordanceChoice
+         * @author chris
+         */
+        const AffordanceChoice& GetChoice(size_t agent) const { return m_Choices[agent]; }
+
+        /**
+         *
+         * @fn GetObjectId
+         * @brief Gets the caller's id of an object
+         *
+         * @param object
+         * @return uint32_t
+         * @author chris
+         */
+        uint32_t GetObjectId(int object) const { return m_ObjectIds[object]; }
+
+        /**
+         *
+         * @fn GetObjectTag
+         * @brief Gets the tag of an object
+         *
+         * @param object
+         * @return const std::string&
+         * @author chris
+         */
+        const std::string& GetObjectTag(int object) const { return *m_ObjectTags[object]; }
+
+        /**
+         *
+         * @fn GetAgentCount
+         * @brief Gets the number of agents
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetAgentCount() const { return m_AgentPositions.size(); }
+
+    private:
+        /** Object state, one entry per object */
+        std::vector<glm::vec2> m_ObjectPositions;
+        std::vector<float> m_ObjectHeights;
+        /** Action values, ActionCount per object */
+        std::vector<float> m_ObjectValues;
+        std::vector<uint32_t> m_ObjectIds;
+        /** Tags of the objects, owned by their affordances which outlive the frame */
+        std::vector<const std::string*> m_ObjectTags;
+        /** The index of each object by the caller's id */
+        std::unordered_map<uint32_t, int> m_ObjectIndices;
+
+        /** Agent state, one entry per agent */
+        std::vector<glm::vec3> m_AgentPositions;
+        std::vector<float> m_AgentRanges;
+        std::vector<Actions> m_AgentActions;
+        std::vector<AffordanceChoice> m_Choices;
+        /** Where each agent's known objects start in m_KnownObjects, one more entry than there are agents */
+        std::vector<size_t> m_KnownBegin = { 0 };
+        /** Ids of the objects each agent knows about, one run per agent */
+        std::vector<uint32_t> m_KnownObjects;
+
+        /** Fewest agents worth a job of their own */
+        static constexpr size_t s_ParallelGrain = 128;
+    };
+}
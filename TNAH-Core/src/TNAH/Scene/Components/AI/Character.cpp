@@ -5,9 +5,11 @@
 
 namespace tnah{
 
-    void Character::LogAction(std::string text, glm::vec4 colour)
+    void Character::LogAction(const std::string& text, const glm::vec4& colour)
     {
-        Application::LogPush(LogText(name + ": " + text, colour));
+        //The line is only put together when the log is shown
+        static const uint16_t format = GameLog::RegisterFormat("{}: {}");
+        Application::GetGameLog().Push(format, colour, name, text);
     }
 
     std::string Character::GetActionString(Actions action)
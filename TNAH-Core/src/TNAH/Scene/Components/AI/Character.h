@@ -2,6 +2,8 @@
 #include "Actions.h"
 #include "EmotionComponent.h"
 #include "StateMachine.h"
+#include "Perception.h"
+#include "LatentScheduler.h"
 
 namespace tnah
 {
@@ -28,10 +30,43 @@ namespace tnah
          * 
          * @param deltaTime - the timestep of the update
          * @param transform - the transform component of the character
+         * @param perception - the entities the character knows about, cached by the perception system
          * @return glm::vec3 - the target position of the character
          */
 
-        virtual glm::vec3 OnUpdate(Timestep deltaTime,TransformComponent &transform) = 0;
+        virtual glm::vec3 OnUpdate(Timestep deltaTime,TransformComponent &transform, const PerceptionComponent &perception) = 0;
+
+        /**
+         * @fn  Behave
+         * 
+         * @brief Override to drive the character from a coroutine instead of OnUpdate. The scene starts it once and
+         * only resumes it when what it awaits is done, e.g. co_await MoveTo(position), co_await Seconds(2.0f) or
+         * co_await Until(predicate). OnUpdate is not called while it runs.
+         * 
+         * @author chris
+         * @date   17/10/2026
+         * 
+         * @return Behaviour - the coroutine, an empty one keeps the character on OnUpdate
+         */
+        virtual Behaviour Behave() { return {}; }
+
+        /**
+         * @fn  StartBehaviour
+         * 
+         * @brief Gets the behaviour the first time it is called, an empty one after that
+         * 
+         * @author chris
+         * @date   17/10/2026
+         * 
+         * @return Behaviour - the coroutine to start
+         */
+        Behaviour StartBehaviour()
+        {
+            if(behaviourStarted)
+                return {};
+            behaviourStarted = true;
+            return Behave();
+        }
         /**
          * @fn  ~Character
          * 
@@ -125,9 +160,10 @@ namespace tnah
          * @param affordanceValue
          * @param distance
          * @param tag
+         * @param perception - the entities the character knows about, cached by the perception system
          * @return 
          */
-        virtual std::pair<bool, bool> CheckAction(float affordanceValue, float distance, std::string tag) = 0;
+        virtual std::pair<bool, bool> CheckAction(float affordanceValue, float distance, const std::string& tag, const PerceptionComponent& perception) = 0;
         /**
          * @fn  LogAction
          * 
@@ -139,7 +175,7 @@ namespace tnah
          * @param text - the output of the character
          * @param colour - the colour of the text
          */
-        void LogAction(std::string text, glm::vec4 colour);
+        void LogAction(const std::string& text, const glm::vec4& colour);
 
         
         ///CHARACTER NAME
@@ -274,6 +310,9 @@ namespace tnah
 
         /// movement speed 
         float speed = 1.0f;
+
+        /// true once Behave has been asked for
+        bool behaviourStarted = false;
     };
    
 }
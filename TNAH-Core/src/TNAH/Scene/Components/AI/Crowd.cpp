@@ -0,0 +1,284 @@
+﻿#include "tnahpch.h"
+#include "Crowd.h"
+#include "TNAH/Core/JobSystem.h"
+
+namespace tnah
+{
+    namespace
+    {
+        float det(const glm::vec2& a, const glm::vec2& b)
+        {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        float lengthSquared(const glm::vec2& v)
+        {
+            return glm::dot(v, v);
+        }
+
+        constexpr float s_Epsilon = 0.00001f;
+    }
+
+    void CrowdSimulation::Clear()
+    {
+        m_Positions.clear();
+        m_Velocities.clear();
+        m_PreferredVelocities.clear();
+        m_Radii.clear();
+        m_MaxSpeeds.clear();
+        m_Responsive.clear();
+        m_NewVelocities.clear();
+        m_MaxRadius = 0.0f;
+    }
+
+    size_t CrowdSimulation::AddAgent(const glm::vec2& position, const glm::vec2& velocity, const glm::vec2& preferredVelocity, float radius, float maxSpeed, bool responsive)
+    {
+        m_Positions.push_back(position);
+        m_Velocities.push_back(velocity);
+        m_PreferredVelocities.push_back(preferredVelocity);
+        m_Radii.push_back(radius);
+        m_MaxSpeeds.push_back(maxSpeed);
+        m_Responsive.push_back(responsive ? 1 : 0);
+        m_NewVelocities.push_back(velocity);
+        m_MaxRadius = std::max(m_MaxRadius, radius);
+        return m_Positions.size() - 1;
+    }
+
+    void CrowdSimulation::ComputeVelocities(float timeStep)
+    {
+        BuildNeighbourGrid();
+
+        // Every agent only writes its own new velocity, so chunks of agents can run on any thread
+        JobSystem::ParallelFor(m_Positions.size(), s_ParallelGrain, [this, timeStep](size_t begin, size_t end)
+        {
+            ComputeVelocities(timeStep, begin, end);
+        });
+    }
+
+    void CrowdSimulation::ComputeVelocities(float timeStep, size_t begin, size_t end)
+    {
+        Scratch scratch;
+        Scratch& use = (begin == 0 && end == m_Positions.size()) ? m_Scratch : scratch;
+        for(size_t agent = begin; agent < end; agent++)
+            computeAgent(agent, timeStep, use);
+    }
+
+    void CrowdSimulation::BuildNeighbourGrid()
+    {
+        // A cell as wide as the search radius means only the surrounding 3x3 cells need looking at
+        m_Grid.Build(m_Positions, m_NeighbourDistance + 2.0f * m_MaxRadius, s_MaxGridSide);
+    }
+
+    void CrowdSimulation::computeAgent(size_t agent, float timeStep, Scratch& scratch)
+    {
+        if(!m_Responsive[agent])
+        {
+            m_NewVelocities[agent] = m_Velocities[agent];
+            return;
+        }
+
+        const glm::vec2 position = m_Positions[agent];
+        const glm::vec2 velocity = m_Velocities[agent];
+        const float radius = m_Radii[agent];
+
+        // Closest neighbours from the surrounding cells
+        scratch.Neighbours.clear();
+        const float searchReach = m_NeighbourDistance + radius + m_MaxRadius;
+        m_Grid.Query(position - glm::vec2(searchReach), position + glm::vec2(searchReach), [&](int other)
+        {
+            if(other == static_cast<int>(agent))
+                return;
+
+            const float reach = m_NeighbourDistance + radius + m_Radii[other];
+            const float distanceSquared = lengthSquared(m_Positions[other] - position);
+            if(distanceSquared < reach * reach)
+                scratch.Neighbours.emplace_back(distanceSquared, other);
+        });
+
+        if(scratch.Neighbours.size() > s_MaxNeighbours)
+        {
+            std::nth_element(scratch.Neighbours.begin(), scratch.Neighbours.begin() + s_MaxNeighbours, scratch.Neighbours.end());
+            scratch.Neighbours.resize(s_MaxNeighbours);
+        }
+
+        // One half plane of allowed velocities per neighbour
+        scratch.Lines.clear();
+        const float invTimeHorizon = 1.0f / m_TimeHorizon;
+        for(const auto& neighbour : scratch.Neighbours)
+        {
+            const int other = neighbour.second;
+            const glm::vec2 relativePosition = m_Positions[other] - position;
+            const glm::vec2 relativeVelocity = velocity - m_Velocities[other];
+            const float distanceSquared = neighbour.first;
+            const float combinedRadius = radius + m_Radii[other];
+            const float combinedRadiusSquared = combinedRadius * combinedRadius;
+
+            Line line;
+            glm::vec2 u;
+            if(distanceSquared > combinedRadiusSquared)
+            {
+                // No collision yet, w is the relative velocity seen from the centre of the cut off circle
+                const glm::vec2 w = relativeVelocity - invTimeHorizon * relativePosition;
+                const float wLengthSquared = lengthSquared(w);
+                const float dotProduct1 = glm::dot(w, relativePosition);
+
+                if(dotProduct1 < 0.0f && dotProduct1 * dotProduct1 > combinedRadiusSquared * wLengthSquared)
+                {
+                    // Closest to the cut off circle
+                    const float wLength = std::sqrt(wLengthSquared);
+                    const glm::vec2 unitW = w / wLength;
+                    line.Direction = glm::vec2(unitW.y, -unitW.x);
+                    u = (combinedRadius * invTimeHorizon - wLength) * unitW;
+                }
+                else
+                {
+                    // Closest to one of the legs of the cone
+                    const float leg = std::sqrt(distanceSquared - combinedRadiusSquared);
+                    if(det(relativePosition, w) > 0.0f)
+                    {
+                        line.Direction = glm::vec2(relativePosition.x * leg - relativePosition.y * combinedRadius,
+                            relativePosition.x * combinedRadius + relativePosition.y * leg) / distanceSquared;
+                    }
+                    else
+                    {
+                        line.Direction = -glm::vec2(relativePosition.x * leg + relativePosition.y * combinedRadius,
+                            -relativePosition.x * combinedRadius + relativePosition.y * leg) / distanceSquared;
+                    }
+
+                    u = glm::dot(relativeVelocity, line.Direction) * line.Direction - relativeVelocity;
+                }
+            }
+            else
+            {
+                // Already overlapping, push apart within this step
+                const float invTimeStep = 1.0f / timeStep;
+                const glm::vec2 w = relativeVelocity - invTimeStep * relativePosition;
+                const float wLength = std::max(glm::length(w), s_Epsilon);
+                const glm::vec2 unitW = w / wLength;
+                line.Direction = glm::vec2(unitW.y, -unitW.x);
+                u = (combinedRadius * invTimeStep - wLength) * unitW;
+            }
+
+            line.Point = velocity + (m_Responsive[other] ? 0.5f : 1.0f) * u;
+            scratch.Lines.push_back(line);
+        }
+
+        glm::vec2 result(0.0f);
+        const float maxSpeed = m_MaxSpeeds[agent];
+        const size_t failed = linearProgram2(scratch.Lines, maxSpeed, m_PreferredVelocities[agent], false, result);
+        if(failed < scratch.Lines.size())
+            linearProgram3(scratch.Lines, failed, maxSpeed, result, scratch.Projected);
+
+        m_NewVelocities[agent] = result;
+    }
+
+    bool CrowdSimulation::linearProgram1(const std::vector<Line>& lines, size_t lineNo, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result)
+    {
+        const Line& line = lines[lineNo];
+        const float dotProduct = glm::dot(line.Point, line.Direction);
+        const float discriminant = dotProduct * dotProduct + radius * radius - lengthSquared(line.Point);
+        if(discriminant < 0.0f)
+            return false;
+
+        const float sqrtDiscriminant = std::sqrt(discriminant);
+        float tLeft = -dotProduct - sqrtDiscriminant;
+        float tRight = -dotProduct + sqrtDiscriminant;
+
+        for(size_t i = 0; i < lineNo; i++)
+        {
+            const float denominator = det(line.Direction, lines[i].Direction);
+            const float numerator = det(lines[i].Direction, line.Point - lines[i].Point);
+
+            if(std::abs(denominator) <= s_Epsilon)
+            {
+                // Parallel lines
+                if(numerator < 0.0f)
+                    return false;
+                continue;
+            }
+
+            const float t = numerator / denominator;
+            if(denominator >= 0.0f)
+                tRight = std::min(tRight, t);
+            else
+                tLeft = std::max(tLeft, t);
+
+            if(tLeft > tRight)
+                return false;
+        }
+
+        if(directionOpt)
+        {
+            result = line.Point + (glm::dot(optVelocity, line.Direction) > 0.0f ? tRight : tLeft) * line.Direction;
+        }
+        else
+        {
+            const float t = glm::dot(line.Direction, optVelocity - line.Point);
+            result = line.Point + std::clamp(t, tLeft, tRight) * line.Direction;
+        }
+
+        return true;
+    }
+
+    size_t CrowdSimulation::linearProgram2(const std::vector<Line>& lines, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result)
+    {
+        if(directionOpt)
+            result = optVelocity * radius;
+        else if(lengthSquared(optVelocity) > radius * radius)
+            result = glm::normalize(optVelocity) * radius;
+        else
+            result = optVelocity;
+
+        for(size_t i = 0; i < lines.size(); i++)
+        {
+            if(det(lines[i].Direction, lines[i].Point - result) > 0.0f)
+            {
+                const glm::vec2 previous = result;
+                if(!linearProgram1(lines, i, radius, optVelocity, directionOpt, result))
+                {
+                    result = previous;
+                    return i;
+                }
+            }
+        }
+
+        return lines.size();
+    }
+
+    void CrowdSimulation::linearProgram3(const std::vector<Line>& lines, size_t beginLine, float radius, glm::vec2& result, std::vector<Line>& projected)
+    {
+        float distance = 0.0f;
+        for(size_t i = beginLine; i < lines.size(); i++)
+        {
+            if(det(lines[i].Direction, lines[i].Point - result) <= distance)
+                continue;
+
+            // The velocity breaks this line by more than the best so far, look for one that breaks every line less
+            projected.clear();
+            for(size_t j = 0; j < i; j++)
+            {
+                Line line;
+                const float determinant = det(lines[i].Direction, lines[j].Direction);
+                if(std::abs(determinant) <= s_Epsilon)
+                {
+                    if(glm::dot(lines[i].Direction, lines[j].Direction) > 0.0f)
+                        continue;
+                    line.Point = 0.5f * (lines[i].Point + lines[j].Point);
+                }
+                else
+                {
+                    line.Point = lines[i].Point + (det(lines[j].Direction, lines[i].Point - lines[j].Point) / determinant) * lines[i].Direction;
+                }
+
+                line.Direction = glm::normalize(lines[j].Direction - lines[i].Direction);
+                projected.push_back(line);
+            }
+
+            const glm::vec2 previous = result;
+            if(linearProgram2(projected, radius, glm::vec2(-lines[i].Direction.y, lines[i].Direction.x), true, result) < projected.size())
+                result = previous;
+
+            distance = det(lines[i].Direction, lines[i].Point - result);
+        }
+    }
+}
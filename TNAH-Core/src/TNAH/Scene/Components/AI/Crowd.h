@@ -0,0 +1,211 @@
+﻿/*****************************************************************//**
+ * @file   Crowd.h
+ * @brief  Local avoidance for crowds of agents with optimal reciprocal collision avoidance
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "UniformGrid.h"
+
+namespace tnah
+{
+    /**
+     * @class CrowdSimulation
+     * @brief Works out collision free velocities for a batch of agents with optimal reciprocal collision avoidance (ORCA).
+     * Each agent takes half the effort of avoiding every neighbour it could hit within the time horizon, and picks the
+     * velocity closest to the one it wants that keeps clear of all of them. Unresponsive agents, such as moving obstacles,
+     * keep their velocity and the others take the full effort. Neighbours are found through a uniform grid rebuilt every
+     * pass. Agents only read the shared state and write their own result, so any range of agents can be computed on its own.
+     *
+     * @author chris
+     */
+    class CrowdSimulation : public RefCounted
+    {
+    public:
+        CrowdSimulation() = default;
+        ~CrowdSimulation() = default;
+
+        /**
+         *
+         * @fn Clear
+         * @brief Removes every agent, called before the agents of a frame are added
+         *
+         * @author chris
+         */
+        void Clear();
+
+        /**
+         *
+         * @fn AddAgent
+         * @brief Adds an agent to the next pass, positions and velocities are on the x and z axes
+         *
+         * @param position
+         * @param velocity the velocity the agent is moving at
+         * @param preferredVelocity the velocity the agent would move at with nobody around
+         * @param radius
+         * @param maxSpeed
+         * @param responsive false if the agent keeps its velocity and leaves the avoiding to the others
+         * @return the index of the agent
+         * @author chris
+         */
+        size_t AddAgent(const glm::vec2& position, const glm::vec2& velocity, const glm::vec2& preferredVelocity, float radius, float maxSpeed, bool responsive = true);
+
+        /**
+         *
+         * @fn ComputeVelocities
+         * @brief Builds the neighbour grid and computes the new velocity of every agent, in chunks across the job system
+         *
+         * @param timeStep
+         * @author chris
+         */
+        void ComputeVelocities(float timeStep);
+
+        /**
+         *
+         * @fn ComputeVelocities
+         * @brief Computes the new velocities of a range of agents, the neighbour grid must already be built
+         *
+         * @param timeStep
+         * @param begin
+         * @param end
+         * @author chris
+         */
+        void ComputeVelocities(float timeStep, size_t begin, size_t end);
+
+        /**
+         *
+         * @fn BuildNeighbourGrid
+         * @brief Sorts the agents into the neighbour grid
+         *
+         * @author chris
+         */
+        void BuildNeighbourGrid();
+
+        /**
+         *
+         * @fn GetVelocity
+         * @brief Gets the velocity computed for an agent
+         *
+         * @param agent
+         * @return glm::vec2
+         * @author chris
+         */
+        const glm::vec2& GetVelocity(size_t agent) const { return m_NewVelocities[agent]; }
+
+        /**
+         *
+         * @fn GetAgentCount
+         * @brief Gets the number of agents
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetAgentCount() const { return m_Positions.size(); }
+
+        /**
+         *
+         * @fn SetTimeHorizon
+         * @brief Sets how many seconds ahead agents avoid each other
+         *
+         * @param seconds
+         * @author chris
+         */
+        void SetTimeHorizon(float seconds) { m_TimeHorizon = seconds; }
+
+        /**
+         *
+         * @fn SetNeighbourDistance
+         * @brief Sets how far from an agent, edge to edge, others are taken into account
+         *
+         * @param distance
+         * @author chris
+         */
+        void SetNeighbourDistance(float distance) { m_NeighbourDistance = distance; }
+
+    private:
+        /** A half plane of allowed velocities, those to the left of the directed line */
+        struct Line
+        {
+            glm::vec2 Point = glm::vec2(0.0f);
+            glm::vec2 Direction = glm::vec2(0.0f);
+        };
+
+        /** Scratch memory for one agent at a time, kept per caller so ranges can run side by side */
+        struct Scratch
+        {
+            std::vector<std::pair<float, int>> Neighbours;
+            std::vector<Line> Lines;
+            std::vector<Line> Projected;
+        };
+
+        /**
+         *
+         * @fn computeAgent
+         * @brief Computes the new velocity of one agent
+         *
+         * @param agent
+         * @param timeStep
+         * @param scratch
+         * @author chris
+         */
+        void computeAgent(size_t agent, float timeStep, Scratch& scratch);
+
+        /**
+         *
+         * @fn linearProgram1
+         * @brief Finds the velocity closest to the optimum on one line that satisfies the lines before it
+         *
+         * @return false if the lines leave nothing on this one
+         * @author chris
+         */
+        static bool linearProgram1(const std::vector<Line>& lines, size_t lineNo, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result);
+
+        /**
+         *
+         * @fn linearProgram2
+         * @brief Finds the velocity closest to the optimum inside the speed limit that satisfies every line
+         *
+         * @return the number of lines, or the first line that could not be satisfied
+         * @author chris
+         */
+        static size_t linearProgram2(const std::vector<Line>& lines, float radius, const glm::vec2& optVelocity, bool directionOpt, glm::vec2& result);
+
+        /**
+         *
+         * @fn linearProgram3
+         * @brief Finds the velocity that breaks the lines from the given one onward by the least, used when they cannot all hold
+         *
+         * @author chris
+         */
+        static void linearProgram3(const std::vector<Line>& lines, size_t beginLine, float radius, glm::vec2& result, std::vector<Line>& projected);
+
+        /** Agent state, one entry per agent */
+        std::vector<glm::vec2> m_Positions;
+        std::vector<glm::vec2> m_Velocities;
+        std::vector<glm::vec2> m_PreferredVelocities;
+        std::vector<float> m_Radii;
+        std::vector<float> m_MaxSpeeds;
+        std::vector<uint8_t> m_Responsive;
+        std::vector<glm::vec2> m_NewVelocities;
+
+        /** Largest agent radius, widens the neighbour search */
+        float m_MaxRadius = 0.0f;
+        /** Agents bucketed by position */
+        UniformGrid m_Grid;
+        /** Scratch used by the single call that computes every agent */
+        Scratch m_Scratch;
+
+        /** Seconds ahead agents avoid each other */
+        float m_TimeHorizon = 2.0f;
+        /** Edge to edge distance within which others are taken into account */
+        float m_NeighbourDistance = 3.0f;
+
+        /** Closest neighbours taken into account */
+        static constexpr size_t s_MaxNeighbours = 10;
+        /** Neighbour grids are capped at this many cells along a side, cells grow to fit */
+        static constexpr int s_MaxGridSide = 256;
+        /** Fewest agents worth a job of their own */
+        static constexpr size_t s_ParallelGrain = 64;
+    };
+}
@@ -3,174 +3,145 @@
 
 namespace tnah
 {
-	float EmotionComponent::GetArousal() { return m_Arousal; }
-	float EmotionComponent::GetValence() { return m_Valence; }
+	float EmotionComponent::GetArousal() { return m_System->GetStorage().Arousal[m_Slot]; }
+	float EmotionComponent::GetValence() { return m_System->GetStorage().Valence[m_Slot]; }
 
 	EmotionComponent::EmotionComponent()
+		: m_System(&EmotionSystem::GetStandalone()), m_Slot(m_System->Allocate())
 	{
-		InitialiseMap();
-		UpdateTimer();
 	}
 
 	EmotionComponent::EmotionComponent(float valence, float arousal, Mood m)
+		: m_System(&EmotionSystem::GetStandalone()), m_Slot(m_System->Allocate())
 	{
-		InitialiseMap();	
 		SetMood(m);
 		SetValence(valence);
 		SetArousal(arousal);
 		UpdateTimer();
 	}
 
-	void EmotionComponent::SetArousal(float arousal) 
-	{ 
-		if (arousal > 1)
-			m_Arousal = 1;
-		else if (arousal < -1)
-			m_Arousal = -1;
-		else
-			m_Arousal = arousal;
+	EmotionComponent::EmotionComponent(const EmotionComponent& other)
+		: m_System(other.m_System), m_Slot(m_System->Allocate()), m_Traits(other.m_Traits)
+	{
+		m_System->Copy(*other.m_System, other.m_Slot, m_Slot);
 	}
-	void EmotionComponent::SetValence(float valence) 
+
+	EmotionComponent::EmotionComponent(EmotionComponent&& other) noexcept
+		: m_System(other.m_System), m_Slot(other.m_Slot), m_Traits(std::move(other.m_Traits))
 	{
-		if (valence > 1)
-			m_Valence = 1;
-		else if (valence < -1)
-			m_Valence = -1;
-		else
-			m_Valence = valence; 
+		other.m_Slot = EmotionSystem::s_NoSlot;
 	}
 
-	void EmotionComponent::IncreaseArousal(float arousal)
+	EmotionComponent::~EmotionComponent()
 	{
-		m_Arousal = m_Arousal + (arousal * m_MultiplierPositiveArousal);
+		if (m_Slot != EmotionSystem::s_NoSlot)
+			m_System->Free(m_Slot);
+	}
 
-		//adjusts arousal if value overflows to ensure accuracy
-		if (m_Arousal > 1)
-			m_Arousal = 1;
+	EmotionComponent& EmotionComponent::operator=(const EmotionComponent& other)
+	{
+		if (this != &other)
+		{
+			if (m_Slot == EmotionSystem::s_NoSlot)
+				m_Slot = m_System->Allocate();
+			m_System->Copy(*other.m_System, other.m_Slot, m_Slot);
+			m_Traits = other.m_Traits;
+		}
+		return *this;
 	}
 
-	void EmotionComponent::DecreaseArousal(float arousal)
+	EmotionComponent& EmotionComponent::operator=(EmotionComponent&& other) noexcept
 	{
-		m_Arousal = m_Arousal - (arousal * m_MultiplierNegativeArousal);
+		if (this != &other)
+		{
+			if (m_Slot != EmotionSystem::s_NoSlot)
+				m_System->Free(m_Slot);
+			m_System = other.m_System;
+			m_Slot = other.m_Slot;
+			m_Traits = std::move(other.m_Traits);
+			other.m_Slot = EmotionSystem::s_NoSlot;
+		}
+		return *this;
+	}
 
-		//adjusts arousal if value overflows to ensure accuracy
-		if (m_Arousal < -1)
-			m_Arousal = -1;
+	void EmotionComponent::MoveTo(EmotionSystem& system)
+	{
+		if (&system == m_System || m_Slot == EmotionSystem::s_NoSlot)
+		{
+			m_System = &system;
+			return;
+		}
+
+		const uint32_t slot = system.Allocate();
+		system.Copy(*m_System, m_Slot, slot);
+		m_System->Free(m_Slot);
+		m_System = &system;
+		m_Slot = slot;
 	}
 
-	void EmotionComponent::IncreaseValence(float valence)
+	void EmotionComponent::SetArousal(float arousal) 
+	{ 
+		m_System->GetStorage().Arousal[m_Slot] = std::max(std::min(arousal, 1.0f), -1.0f);
+	}
+	void EmotionComponent::SetValence(float valence) 
 	{
-		m_Valence = m_Valence + (valence * m_MultiplierPositiveValence);
+		m_System->GetStorage().Valence[m_Slot] = std::max(std::min(valence, 1.0f), -1.0f);
+	}
 
+	void EmotionComponent::IncreaseArousal(float arousal)
+	{
+		auto& s = m_System->GetStorage();
 		//adjusts arousal if value overflows to ensure accuracy
-		if (m_Valence > 1)
-			m_Valence = 1;
+		s.Arousal[m_Slot] = std::min(s.Arousal[m_Slot] + (arousal * s.PositiveArousal[m_Slot]), 1.0f);
 	}
 
-	void EmotionComponent::DecreaseValence(float valence)
+	void EmotionComponent::DecreaseArousal(float arousal)
 	{
-		m_Valence = m_Valence - (valence * m_MultiplierNegativeValence);
-
+		auto& s = m_System->GetStorage();
 		//adjusts arousal if value overflows to ensure accuracy
-		if (m_Valence < -1)
-			m_Valence = -1;
+		s.Arousal[m_Slot] = std::max(s.Arousal[m_Slot] - (arousal * s.NegativeArousal[m_Slot]), -1.0f);
 	}
 
+	void EmotionComponent::IncreaseValence(float valence)
+	{
+		auto& s = m_System->GetStorage();
+		//adjusts valence if value overflows to ensure accuracy
+		s.Valence[m_Slot] = std::min(s.Valence[m_Slot] + (valence * s.PositiveValence[m_Slot]), 1.0f);
+	}
 
-	void EmotionComponent::InitialiseMap()
+	void EmotionComponent::DecreaseValence(float valence)
 	{
-		// High Arousal - Positive Valence
-		EmotionMap.insert({ (std::make_pair(1.0f, 0.5f)), Emotion::Excited });
-		EmotionMap.insert({ (std::make_pair(0.66f, 0.5f)), Emotion::Delighted });
-		EmotionMap.insert({ (std::make_pair(0.33f, 0.5f)), Emotion::Happy });
-
-		// Low Arousal - Positive Valence
-		EmotionMap.insert({ (std::make_pair(-0.33f, 0.5f)), Emotion::Content });
-		EmotionMap.insert({ (std::make_pair(-0.66f, 0.5f)), Emotion::Relaxed });
-		EmotionMap.insert({ (std::make_pair(-1.0f, 0.5f)), Emotion::Calm });
-
-		// High Arousal - Negative Valence
-		EmotionMap.insert({ (std::make_pair(1.0f, -0.5f)), Emotion::Tense });
-		EmotionMap.insert({ (std::make_pair(0.66f, -0.5f)), Emotion::Angry });
-		EmotionMap.insert({ (std::make_pair(0.33f, -0.5f)), Emotion::Frustrated });
-
-		// Low Arousal - Negative Valence
-		EmotionMap.insert({ (std::make_pair(-0.33f, -0.5f)), Emotion::Depressed });
-		EmotionMap.insert({ (std::make_pair(-0.66f, -0.5)), Emotion::Bored });
-		EmotionMap.insert({ (std::make_pair(-1.0f, -0.5)), Emotion::Tired });
+		auto& s = m_System->GetStorage();
+		//adjusts valence if value overflows to ensure accuracy
+		s.Valence[m_Slot] = std::max(s.Valence[m_Slot] - (valence * s.NegativeValence[m_Slot]), -1.0f);
 	}
 
 	Emotion EmotionComponent::ReturnEmotion(float arousal, float valence)
 	{
-		std::pair<float, float> emotionVals{ arousal, valence };
-		it = EmotionMap.find(emotionVals);
-
-		if (!EmotionMap.count(emotionVals))
-			TNAH_CORE_ERROR("Emotion not within map: {0} {1} ", emotionVals.first, emotionVals.second);
-		else 
-			return it->second;
-			
-
-		return Emotion::Neutral;
+		return m_System->Lookup(m_Slot, arousal, valence);
 	}
 
 	void EmotionComponent::AddEmotion(float arousal, float valence, Emotion e)
 	{
-		std::pair<float, float> emotionVals{ arousal,valence };
-		if (EmotionMap.count(emotionVals))
-			TNAH_CORE_ERROR("Values aready in map: {0} {1} ", emotionVals.first, emotionVals.second);
-		/*else
-			std::cout << "Added to map" << std::endl;*/
-		EmotionMap.insert({ emotionVals, e });
+		if (m_System->Lookup(m_Slot, arousal, valence) != Emotion::Neutral)
+			TNAH_CORE_ERROR("Values aready in map: {0} {1} ", arousal, valence);
+		else
+			m_System->SetTableEntry(m_Slot, arousal, valence, e);
 	}
 
 	void EmotionComponent::RemoveEmotion(float arousal, float valence)
 	{
-		std::pair<float, float> emotionVals{ arousal, valence };
-		/*if (EmotionMap.count(emotionVals))
-			std::cout << "Emotion removed from map" << std::endl;
-		else
-			std::cout << "Emotion not in map" << std::endl;*/
-		EmotionMap.erase(emotionVals);
-
+		m_System->SetTableEntry(m_Slot, arousal, valence, Emotion::Neutral);
 	}
 
 	float EmotionComponent::GetScaledArousal(float value)
 	{
-		float scaledValue = 0;
-		if (value >= 0)
-		{
-			if (value <= 1.0f && value > 0.66f)
-				scaledValue = 1.0f;
-			else if (value <= 0.66f && value > 0.33f)
-				scaledValue = 0.66f;
-			else
-				scaledValue = 0.33f;
-		}
-		else
-		{
-			if (value >= -1.0f && value < -0.66f)
-				scaledValue = -1.0f;
-			else if (value >= -0.66f && value < -0.33f)
-				scaledValue = -0.66f;
-			else
-				scaledValue = -0.33f;
-		}
-		return scaledValue;
+		return EmotionSystem::ScaledArousal(EmotionSystem::ArousalLevel(value));
 	}
 
 	float EmotionComponent::GetScaledValence(float value)
 	{
-		float scaledValue = 0;
-		if (value >= 0)
-		{
-			scaledValue = 0.5f;
-		}
-		else
-		{
-			scaledValue = -0.5f;
-		}
-		return scaledValue;
+		return EmotionSystem::ValenceLevel(value) ? 0.5f : -0.5f;
 	}
 
 	void EmotionComponent::AddTrait(Trait t)
@@ -181,85 +152,91 @@ namespace tnah
 			TNAH_CORE_WARN("Trait exits");
 		else
 		{
+			auto& s = m_System->GetStorage();
+			float& positiveArousal = s.PositiveArousal[m_Slot];
+			float& positiveValence = s.PositiveValence[m_Slot];
+			float& negativeArousal = s.NegativeArousal[m_Slot];
+			float& negativeValence = s.NegativeValence[m_Slot];
+
 			m_Traits.push_back(t);
 			switch (t)
 			{
 			case Trait::Happy:
-				m_MultiplierPositiveArousal += 0.05f; //more likely to feel positive
-				m_MultiplierPositiveValence += 0.05f;
+				positiveArousal += 0.05f; //more likely to feel positive
+				positiveValence += 0.05f;
 				
-				m_MultiplierNegativeArousal -= 0.05f; //less likely to feel negative
-				m_MultiplierNegativeValence -= 0.05f;
+				negativeArousal -= 0.05f; //less likely to feel negative
+				negativeValence -= 0.05f;
 				break;
 
 			case Trait::Delighted:
 
-				m_MultiplierPositiveArousal += 0.1f; //more likely to feel positive
-				m_MultiplierPositiveValence += 0.1f;
+				positiveArousal += 0.1f; //more likely to feel positive
+				positiveValence += 0.1f;
 
-				m_MultiplierNegativeArousal -= 0.1f; //less likely to feel negative
-				m_MultiplierNegativeValence -= 0.1f;
+				negativeArousal -= 0.1f; //less likely to feel negative
+				negativeValence -= 0.1f;
 				break;
 
 
 			case Trait::Cheerful:
-				m_MultiplierPositiveArousal += 0.15f; //more likely to feel positive
-				m_MultiplierPositiveValence += 0.15f;
+				positiveArousal += 0.15f; //more likely to feel positive
+				positiveValence += 0.15f;
 
-				m_MultiplierNegativeArousal -= 0.15f; //less likely to feel negative
-				m_MultiplierNegativeValence -= 0.15f;
+				negativeArousal -= 0.15f; //less likely to feel negative
+				negativeValence -= 0.15f;
 				break;
 
 			case Trait::Sad:
-				m_MultiplierPositiveArousal -= 0.15f; //arousal more likely to decrease
-				m_MultiplierPositiveValence -= 0.15f; //less likely to feel positive
+				positiveArousal -= 0.15f; //arousal more likely to decrease
+				positiveValence -= 0.15f; //less likely to feel positive
 
-				m_MultiplierNegativeArousal += 0.15f; // negative arousal more likely to increase
-				m_MultiplierNegativeValence += 0.15f; //more likely to feel negative
+				negativeArousal += 0.15f; // negative arousal more likely to increase
+				negativeValence += 0.15f; //more likely to feel negative
 				break;
 
 			case Trait::Bland:
-				m_MultiplierPositiveArousal -= 0.1f; //arousal more likely to decrease
-				m_MultiplierPositiveValence -= 0.1f; //less likely to feel positive
+				positiveArousal -= 0.1f; //arousal more likely to decrease
+				positiveValence -= 0.1f; //less likely to feel positive
 
-				m_MultiplierNegativeArousal += 0.1f; // negative arousal more likely to increase
-				m_MultiplierNegativeValence += 0.1f; //more likely to feel negative
+				negativeArousal += 0.1f; // negative arousal more likely to increase
+				negativeValence += 0.1f; //more likely to feel negative
 				break;
 
 			case Trait::Depressed:
-				m_MultiplierPositiveArousal -= 0.05f; //arousal more likely to decrease
-				m_MultiplierPositiveValence -= 0.05f; //less likely to feel positive
+				positiveArousal -= 0.05f; //arousal more likely to decrease
+				positiveValence -= 0.05f; //less likely to feel positive
 
-				m_MultiplierNegativeArousal += 0.05f; // negative arousal more likely to increase
-				m_MultiplierNegativeValence += 0.05f; //more likely to feel negative
+				negativeArousal += 0.05f; // negative arousal more likely to increase
+				negativeValence += 0.05f; //more likely to feel negative
 				break;
 
 			case Trait::Patient:
-				m_MultiplierNegativeArousal -= 0.05f; //arousal more likely to decrease
+				negativeArousal -= 0.05f; //arousal more likely to decrease
 				break;
 
 			case Trait::Peaceful:
-				m_MultiplierNegativeArousal -= 0.1f; //arousal more likely to decrease
-				m_MultiplierPositiveValence += 0.1f; // more likely to feel positive
+				negativeArousal -= 0.1f; //arousal more likely to decrease
+				positiveValence += 0.1f; // more likely to feel positive
 				break;
 
 			case Trait::Carefree:
-				m_MultiplierNegativeArousal -= 0.15f; //arousal more likely to decrease
-				m_MultiplierPositiveValence += 0.15f; // more likely to feel positive
+				negativeArousal -= 0.15f; //arousal more likely to decrease
+				positiveValence += 0.15f; // more likely to feel positive
 				break;
 
 			case Trait::Impatient:
-				m_MultiplierPositiveArousal += 0.05f; //arousal more likely to increase
+				positiveArousal += 0.05f; //arousal more likely to increase
 				break;
 
 			case Trait::Aggressive:
-				m_MultiplierPositiveArousal += 0.1f; //arousal more likely to increase
-				m_MultiplierNegativeValence += 0.1f; //more likely to feel negative
+				positiveArousal += 0.1f; //arousal more likely to increase
+				negativeValence += 0.1f; //more likely to feel negative
 				break;
 
 			case Trait::Paranoid:
-				m_MultiplierPositiveArousal += 0.15f; //arousal more likely to increase
-				m_MultiplierNegativeValence += 0.15f; //more likely to feel negative
+				positiveArousal += 0.15f; //arousal more likely to increase
+				negativeValence += 0.15f; //more likely to feel negative
 				break;
 			}
 		}
@@ -267,139 +244,16 @@ namespace tnah
 
 	void EmotionComponent::Update(float dt)
 	{
-		Emotion em = ReturnEmotion(GetScaledArousal(GetArousal()), GetScaledValence(GetValence()));
-		m_State = em;
-		IncreaseArousal(0.0001f * dt);
-		DecreaseArousal(0.0001f * dt);
-		IncreaseValence(0.0001f * dt);
-		DecreaseValence(0.0001f * dt);
-		UpdateMood(dt);
+		m_System->Update(dt, m_Slot, m_Slot + 1);
 	}
 
 	void EmotionComponent::SetMood(Mood m)
 	{
-		switch (m)
-		{
-		case Mood::Happy:
-			m_MultiplierPositiveArousal += 0.25f; //arousal more likely to be positive
-			m_MultiplierPositiveValence += 0.25; // easier to feel positive
-
-			m_MultiplierNegativeArousal -= 0.25f; //less likely to have negative arousal
-			m_MultiplierNegativeValence -= 0.25f; //less likely to feel negative
-
-			m_Mood = m;
-			break;
-		case Mood::Angry:
-			m_MultiplierPositiveArousal += 0.25f; //arousal more likely to be positive
-			m_MultiplierPositiveValence -= 0.25f; // harder to feel positive
-
-			m_MultiplierNegativeArousal -= 0.25f; // less likely to have negative arousal
-			m_MultiplierNegativeValence += 0.25f; // easier to feel negative
-
-			m_Mood = m;
-			break;
-		case Mood::Sad:
-			m_MultiplierPositiveArousal -= 0.25f; //arousal more likely to be negative
-			m_MultiplierPositiveValence -= 0.25f; // harder to feel positive 
-
-			m_MultiplierNegativeArousal += 0.25f; // more likely to feel negative arousal
-			m_MultiplierNegativeValence += 0.25f; // easier to feel negative
-
-			m_Mood = m;
-			break;
-		case Mood::Relaxed:
-			m_MultiplierPositiveArousal -= 0.25f; //arousal more likely to be negative
-			m_MultiplierPositiveValence += 0.25f; //easier to feel positive
-
-			m_MultiplierNegativeArousal += 0.25f; //more likely to feel negative arousal
-			m_MultiplierNegativeValence -= 0.25f; //harder to feel negative
-			
-			m_Mood = m;
-			break;
-
-		default:
-			break;
-		}
-
-	}
-
-	void EmotionComponent::UpdateMood(float dt)
-	{
-		if(internalTimer <= 0)
-		{
-			switch (m_Mood)
-			{
-			case Mood::Happy:
-				m_MultiplierPositiveArousal -= 0.25f; //arousal more likely to be positive
-				m_MultiplierPositiveValence -= 0.25; // easier to feel positive
-
-				m_MultiplierNegativeArousal += 0.25f; //less likely to have negative arousal
-				m_MultiplierNegativeValence += 0.25f; //less likely to feel negative
-				break;
-			case Mood::Angry:
-				m_MultiplierPositiveArousal -= 0.25f; //arousal more likely to be positive
-				m_MultiplierPositiveValence += 0.25f; // harder to feel positive
-
-				m_MultiplierNegativeArousal += 0.25f; // less likely to have negative arousal
-				m_MultiplierNegativeValence -= 0.25f; // easier to feel negative
-				break;
-			case Mood::Sad:
-				m_MultiplierPositiveArousal += 0.25f; //arousal more likely to be negative
-				m_MultiplierPositiveValence += 0.25f; // harder to feel positive 
-
-				m_MultiplierNegativeArousal -= 0.25f; // more likely to feel negative arousal
-				m_MultiplierNegativeValence -= 0.25f; // easier to feel negative
-				break;
-			case Mood::Relaxed:
-				m_MultiplierPositiveArousal += 0.25f; //arousal more likely to be negative
-				m_MultiplierPositiveValence -= 0.25f; //easier to feel positive
-
-				m_MultiplierNegativeArousal -= 0.25f; //more likely to feel negative arousal
-				m_MultiplierNegativeValence += 0.25f; //harder to feel negative
-				break;
-
-			default:
-				break;
-			}
-			Mood temp = Mood::Neutral;
-		
-			switch (m_State)
-			{
-			case Emotion::Happy:
-			case Emotion::Excited:
-			case Emotion::Delighted:
-				temp = Mood::Happy;
-				break;
-			case Emotion::Frustrated:
-			case Emotion::Angry:
-			case Emotion::Tense:
-				temp = Mood::Angry;
-				break;
-			case Emotion::Bored:
-			case Emotion::Depressed:
-			case Emotion::Tired:
-				temp = Mood::Sad;
-				break;
-			case Emotion::Calm:
-			case Emotion::Content:
-			case Emotion::Relaxed:
-				temp = Mood::Relaxed;
-				break;
-			default:
-				break;
-			}
-		
-			SetMood(temp);
-			UpdateTimer();
-		}
-		else
-		{
-			internalTimer -= dt;
-		}
+		m_System->ApplyMood(m_Slot, m, 1.0f);
+		if (m != Mood::Neutral)
+			m_System->GetStorage().Moods[m_Slot] = m;
 	}
 
-
-	
 	std::string EmotionComponent::GetCurrentEmotionAsString()
 	{
 		switch (GetEmotion())
@@ -1,12 +1,14 @@
 ﻿#pragma once
 #include "Emotion.h"
+#include "EmotionSystem.h"
 
 namespace tnah
 {
 	/**
 	 * @class  EmotionComponent
 	 *
-	 * @brief  The EmotionComponent class repsonsible for the managing of emotions, mood and personality. Can be attached as a component to give a gameobject the ability to have Emotions
+	 * @brief  The EmotionComponent class repsonsible for the managing of emotions, mood and personality. Can be attached as a component to give a gameobject the ability to have Emotions.
+	 * The values live in the EmotionSystem storage, the component holds the slot and reads and writes through it
 	 *
 	 * @author Dylan Blereau
 	 * @date   3/11/2021
@@ -40,6 +42,67 @@ namespace tnah
 		 */
 		EmotionComponent(float valence, float arousal, Mood m);
 
+		/**
+		 * @fn  EmotionComponent
+		 * 
+		 * @brief  Copy constructor, takes a slot of its own with the same values
+		 * 
+		 * @author chris
+		 * @date   17/10/2026
+		 * 
+		 * @param other
+		 */
+		EmotionComponent(const EmotionComponent& other);
+
+		/**
+		 * @fn  EmotionComponent
+		 * 
+		 * @brief  Move constructor, takes over the slot
+		 * 
+		 * @author chris
+		 * @date   17/10/2026
+		 * 
+		 * @param other
+		 */
+		EmotionComponent(EmotionComponent&& other) noexcept;
+
+		/**
+		 * @fn  ~EmotionComponent
+		 * 
+		 * @brief  Destructor, gives the slot back
+		 * 
+		 * @author chris
+		 * @date   17/10/2026
+		 * 
+		 */
+		~EmotionComponent();
+
+		/**
+		 * @fn  operator=
+		 * 
+		 * @brief  Copies the values of another component into this one's slot
+		 * 
+		 * @author chris
+		 * @date   17/10/2026
+		 * 
+		 * @param other
+		 * @return this component
+		 */
+		EmotionComponent& operator=(const EmotionComponent& other);
+
+		/**
+		 * @fn  operator=
+		 * 
+		 * @brief  Gives this one's slot back and takes over the other's
+		 * 
+		 * @author chris
+		 * @date   17/10/2026
+		 * 
+		 * @param other
+		 * @return this component
+		 */
+		EmotionComponent& operator=(EmotionComponent&& other) noexcept;
+
 		/**
 		 * @fn  GetEmotion
 		 * 
@@ -50,7 +113,7 @@ namespace tnah
 		 * 
 		 * @return Current Emotion
 		 */
-		Emotion GetEmotion() { return m_State; }
+		Emotion GetEmotion() { return m_System->GetStorage().State[m_Slot]; }
 
 		/**
 		 * @fn  SetEmotion
@@ -62,7 +125,7 @@ namespace tnah
 		 * 
 		 * @param e
 		 */
-		void SetEmotion(Emotion e) { m_State = e; }
+		void SetEmotion(Emotion e) { m_System->GetStorage().State[m_Slot] = e; }
 
 		/**
 		 * @fn  GetMood
@@ -74,7 +137,7 @@ namespace tnah
 		 * 
 		 * @return Current Mood
 		 */
-		Mood GetMood() { return m_Mood; }
+		Mood GetMood() { return m_System->GetStorage().Moods[m_Slot]; }
 
 		/**
 		 * @fn  GetArousal
@@ -179,7 +242,7 @@ namespace tnah
 		/**
 		 * @fn  ReturnEmotion
 		 * 
-		 * @brief  Returns the emotion in the emotionMap that corresponds to the given arousal and valence values
+		 * @brief  Returns the emotion in the shared emotion table that corresponds to the given arousal and valence values
 		 * 
 		 * @author Dylan Blereau
 		 * @date   3/11/2021
@@ -195,7 +258,8 @@ namespace tnah
 		/**
 		 * @fn  AddEmotion
 		 * 
-		 * @brief Adds an emotion into the emotionMap using the given arousal, valence and Emotion name (Emotion enum name must be in Enum list to allow for this to work) 
+		 * @brief Adds an emotion into the emotion table using the given arousal, valence and Emotion name (Emotion enum name must be in Enum list to allow for this to work).
+		 * The table belongs to this component and only has a cell free once its emotion has been removed
 		 * 
 		 * @author Dylan Blereau
 		 * @date   3/11/2021
@@ -210,7 +274,7 @@ namespace tnah
 		/**
 		 * @fn  RemoveEmotion
 		 * 
-		 * @brief  Removes the emotion from the map that has the matching arousal and valence values
+		 * @brief  Removes the emotion from the component's table that has the matching arousal and valence values
 		 * 
 		 * @author Dylan Blereau
 		 * @date   3/11/2021
@@ -235,7 +299,8 @@ namespace tnah
 		/**
 		 * @fn  Update
 		 * 
-		 * @brief  Updates the EmotionComponent with deltaTime
+		 * @brief  Updates the EmotionComponent with deltaTime. The scene already steps its components each frame through
+		 * its EmotionSystem, this steps only this one
 		 * 
 		 * @author Dylan Blereau
 		 * @date   3/11/2021
@@ -281,7 +346,7 @@ namespace tnah
 		 * 
 		 * @return the Positive Valence multiplier
 		 */
-		float GetPositiveValenceMultiplier() { return m_MultiplierPositiveValence; }
+		float GetPositiveValenceMultiplier() { return m_System->GetStorage().PositiveValence[m_Slot]; }
 
 		/**
 		 * @fn  GetNegativeValenceMultiplier
@@ -293,7 +358,7 @@ namespace tnah
 		 * 
 		 * @return the negative valence multiplier
 		 */
-		float GetNegativeValenceMultiplier() { return m_MultiplierNegativeValence; }
+		float GetNegativeValenceMultiplier() { return m_System->GetStorage().NegativeValence[m_Slot]; }
 
 		/**
 		 * @fn  GetPositiveArosualMultiplier
@@ -305,7 +370,7 @@ namespace tnah
 		 * 
 		 * @return the positive arousal multiplier
 		 */
-		float GetPositiveArosualMultiplier() { return m_MultiplierPositiveArousal; }
+		float GetPositiveArosualMultiplier() { return m_System->GetStorage().PositiveArousal[m_Slot]; }
 
 		/**
 		 * @fn  GetNegativeArousalMultiplier
@@ -317,7 +382,7 @@ namespace tnah
 		 * 
 		 * @return the negative arousal multiplier
 		 */
-		float GetNegativeArousalMultiplier() { return m_MultiplierNegativeArousal; }
+		float GetNegativeArousalMultiplier() { return m_System->GetStorage().NegativeArousal[m_Slot]; }
 
 
 		/**
@@ -385,67 +450,32 @@ namespace tnah
 		/**
 		 * @fn  UpdateTimer
 		 * 
-		 * @brief  Updates the internalTimer back to its default value
-		 * 
-		 * @author Dylan Blereau
-		 * @date   3/11/2021
-		 * 
-		 */
-		void UpdateTimer() {internalTimer = 15.0f;}
-	private:
-
-		/**
-		 * @fn  InitialiseMap
-		 * 
-		 * @brief  Initialises the map with all the emotions used
+		 * @brief  Updates the mood timer back to its default value
 		 * 
 		 * @author Dylan Blereau
 		 * @date   3/11/2021
 		 * 
 		 */
-		void InitialiseMap();
+		void UpdateTimer() { m_System->GetStorage().Timer[m_Slot] = EmotionSystem::s_MoodTime; }
 
 		/**
-		 * @fn  UpdateMood
+		 * @fn  MoveTo
 		 * 
-		 * @brief  Updates the mood when required
+		 * @brief  Moves the values of the component into another EmotionSystem, a scene does this as the component is added
 		 * 
-		 * @author Dylan Blereau
-		 * @date   3/11/2021
+		 * @author chris
+		 * @date   17/10/2026
 		 * 
-		 * @param dt - deltaTime
+		 * @param system
 		 */
-		void UpdateMood(float dt);
-
-		/// A map containing all available emotions, with the key being the Emotion valence and arousal
-		std::map <std::pair<float,float>, Emotion> EmotionMap;
-
-		/// an iterator for the emotion map
-		std::map <std::pair<float, float>, Emotion>::iterator it = EmotionMap.begin();
-
-		/// arousal value
-		float m_Arousal = 0.0f;
-
-		/// valence value
-		float m_Valence = 0.0f;
-
-		/// positive valence multiplier
-		float m_MultiplierPositiveValence = 1.0f;
-
-		/// negative valence multiplier
-		float m_MultiplierNegativeValence = 1.0f;	
-
-		/// positive arousal multiplier
-		float m_MultiplierPositiveArousal = 1.0f;
+		void MoveTo(EmotionSystem& system);
+	private:
 
-		/// negative arousal multiplier
-		float m_MultiplierNegativeArousal = 1.0f;
-	
-		/// Current Emotional State
-		Emotion m_State = Emotion::Neutral;
+		/// the EmotionSystem the values live in
+		EmotionSystem* m_System = nullptr;
 
-		/// Current Mood
-		Mood m_Mood = Mood::Neutral;
+		/// slot of the values in the EmotionSystem storage
+		uint32_t m_Slot = EmotionSystem::s_NoSlot;
 
 		/// Vector of all traits of the AI - AKA its Personality
 		std::vector<Trait> m_Traits;
@@ -453,7 +483,5 @@ namespace tnah
 		/// iterator
 		std::vector<Trait>::iterator itr;
 
-		/// internal timer used to assist with changing moods
-		float internalTimer = 0;
 };
 }
@@ -0,0 +1,238 @@
+﻿#include "tnahpch.h"
+#include "EmotionSystem.h"
+#include "TNAH/Core/JobSystem.h"
+
+#include <limits>
+
+namespace tnah
+{
+    namespace
+    {
+        /** Multiplier changes of each mood: positive arousal, positive valence, negative arousal, negative valence */
+        constexpr float s_MoodMultipliers[5][4] = {
+            { 0.0f, 0.0f, 0.0f, 0.0f },       // Neutral
+            { 0.25f, 0.25f, -0.25f, -0.25f },  // Happy
+            { 0.25f, -0.25f, -0.25f, 0.25f },  // Angry
+            { -0.25f, -0.25f, 0.25f, 0.25f },  // Sad
+            { -0.25f, 0.25f, 0.25f, -0.25f }   // Relaxed
+        };
+
+        /** The mood each emotion leads to, in Emotion order */
+        constexpr Mood s_EmotionMoods[13] = {
+            Mood::Neutral,
+            Mood::Happy, Mood::Happy, Mood::Happy,
+            Mood::Relaxed, Mood::Relaxed, Mood::Relaxed,
+            Mood::Angry, Mood::Angry, Mood::Angry,
+            Mood::Sad, Mood::Sad, Mood::Sad
+        };
+    }
+
+    EmotionSystem::EmotionSystem()
+        : m_Tables(std::begin(s_DefaultTable), std::end(s_DefaultTable))
+    {
+    }
+
+    EmotionSystem& EmotionSystem::GetStandalone()
+    {
+        static EmotionSystem standalone;
+        return standalone;
+    }
+
+    uint32_t EmotionSystem::Allocate()
+    {
+        auto& s = m_Storage;
+        uint32_t slot;
+        if(!s.FreeSlots.empty())
+        {
+            slot = s.FreeSlots.back();
+            s.FreeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(s.Arousal.size());
+            const size_t size = s.Arousal.size() + 1;
+            s.Arousal.resize(size);
+            s.Valence.resize(size);
+            s.PositiveArousal.resize(size);
+            s.NegativeArousal.resize(size);
+            s.PositiveValence.resize(size);
+            s.NegativeValence.resize(size);
+            s.Timer.resize(size);
+            s.Level.resize(size);
+            s.Table.resize(size);
+            s.Expired.resize(size);
+            s.State.resize(size);
+            s.Moods.resize(size);
+        }
+
+        s.Arousal[slot] = 0.0f;
+        s.Valence[slot] = 0.0f;
+        s.PositiveArousal[slot] = 1.0f;
+        s.NegativeArousal[slot] = 1.0f;
+        s.PositiveValence[slot] = 1.0f;
+        s.NegativeValence[slot] = 1.0f;
+        s.Timer[slot] = s_MoodTime;
+        s.Level[slot] = 0;
+        s.Table[slot] = 0;
+        s.Expired[slot] = 0;
+        s.State[slot] = Emotion::Neutral;
+        s.Moods[slot] = Mood::Neutral;
+        return slot;
+    }
+
+    void EmotionSystem::Free(uint32_t slot)
+    {
+        auto& s = m_Storage;
+        if(s.Table[slot] != 0)
+        {
+            m_FreeTables.push_back(s.Table[slot]);
+            s.Table[slot] = 0;
+        }
+        s.Arousal[slot] = 0.0f;
+        s.Valence[slot] = 0.0f;
+        s.PositiveArousal[slot] = 0.0f;
+        s.NegativeArousal[slot] = 0.0f;
+        s.PositiveValence[slot] = 0.0f;
+        s.NegativeValence[slot] = 0.0f;
+        s.Timer[slot] = std::numeric_limits<float>::infinity();
+        s.FreeSlots.push_back(slot);
+    }
+
+    void EmotionSystem::Copy(const EmotionSystem& source, uint32_t from, uint32_t to)
+    {
+        auto& s = m_Storage;
+        const auto& f = source.m_Storage;
+        s.Arousal[to] = f.Arousal[from];
+        s.Valence[to] = f.Valence[from];
+        s.PositiveArousal[to] = f.PositiveArousal[from];
+        s.NegativeArousal[to] = f.NegativeArousal[from];
+        s.PositiveValence[to] = f.PositiveValence[from];
+        s.NegativeValence[to] = f.NegativeValence[from];
+        s.Timer[to] = f.Timer[from];
+        s.Level[to] = f.Level[from];
+        s.Expired[to] = f.Expired[from];
+        s.State[to] = f.State[from];
+        s.Moods[to] = f.Moods[from];
+
+        // A slot reading the default table keeps doing so, one with its own table gets a copy of it
+        if(f.Table[from] == 0)
+        {
+            if(s.Table[to] != 0)
+            {
+                m_FreeTables.push_back(s.Table[to]);
+                s.Table[to] = 0;
+            }
+            return;
+        }
+
+        ownTable(to);
+        if(s.Table[to] != 0)
+        {
+            std::copy_n(source.m_Tables.begin() + f.Table[from] * s_TableSize, s_TableSize, m_Tables.begin() + s.Table[to] * s_TableSize);
+        }
+    }
+
+    void EmotionSystem::SetTableEntry(uint32_t slot, float arousal, float valence, Emotion e)
+    {
+        ownTable(slot);
+        if(m_Storage.Table[slot] != 0)
+            m_Tables[m_Storage.Table[slot] * s_TableSize + TableIndex(arousal, valence)] = e;
+    }
+
+    void EmotionSystem::ownTable(uint32_t slot)
+    {
+        auto& s = m_Storage;
+        if(s.Table[slot] != 0)
+            return;
+
+        uint16_t table;
+        if(!m_FreeTables.empty())
+        {
+            table = m_FreeTables.back();
+            m_FreeTables.pop_back();
+        }
+        else
+        {
+            const size_t count = m_Tables.size() / s_TableSize;
+            if(count > std::numeric_limits<uint16_t>::max())
+            {
+                TNAH_CORE_WARN("Too many emotion tables, the slot keeps the default table");
+                return;
+            }
+
+            table = static_cast<uint16_t>(count);
+            m_Tables.resize(m_Tables.size() + s_TableSize);
+        }
+
+        std::copy_n(s_DefaultTable, s_TableSize, m_Tables.begin() + table * s_TableSize);
+        s.Table[slot] = table;
+    }
+
+    void EmotionSystem::Update(float dt)
+    {
+        // Slots never read each other, so the arrays are split into chunks big enough to be worth a job
+        JobSystem::ParallelFor(m_Storage.Arousal.size(), s_ParallelGrain, [this, dt](size_t begin, size_t end)
+        {
+            Update(dt, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        });
+    }
+
+    void EmotionSystem::Update(float dt, uint32_t begin, uint32_t end)
+    {
+        auto& s = m_Storage;
+        float* arousal = s.Arousal.data();
+        float* valence = s.Valence.data();
+        const float* positiveArousal = s.PositiveArousal.data();
+        const float* negativeArousal = s.NegativeArousal.data();
+        const float* positiveValence = s.PositiveValence.data();
+        const float* negativeValence = s.NegativeValence.data();
+        float* timer = s.Timer.data();
+        uint8_t* level = s.Level.data();
+        uint8_t* expired = s.Expired.data();
+        const uint16_t* table = s.Table.data();
+        const Emotion* tables = m_Tables.data();
+        const float step = s_Drift * dt;
+
+        // Straight line arithmetic over the arrays so the compiler can vectorise it, the emotion is read from the
+        // values before they drift as the component always did
+        for(uint32_t i = begin; i < end; i++)
+        {
+            const float a = arousal[i];
+            const float v = valence[i];
+            level[i] = static_cast<uint8_t>(TableIndex(a, v));
+            arousal[i] = std::max(std::min(a + step * positiveArousal[i], 1.0f) - step * negativeArousal[i], -1.0f);
+            valence[i] = std::max(std::min(v + step * positiveValence[i], 1.0f) - step * negativeValence[i], -1.0f);
+
+            const float t = timer[i];
+            expired[i] = static_cast<uint8_t>(t <= 0.0f);
+            timer[i] = t - (t > 0.0f ? dt : 0.0f);
+        }
+
+        // Table lookups, and the few moods that are due a change
+        for(uint32_t i = begin; i < end; i++)
+        {
+            s.State[i] = tables[table[i] * s_TableSize + level[i]];
+            if(expired[i])
+                changeMood(i);
+        }
+    }
+
+    void EmotionSystem::ApplyMood(uint32_t slot, Mood mood, float sign)
+    {
+        auto& s = m_Storage;
+        const float* change = s_MoodMultipliers[static_cast<int>(mood)];
+        s.PositiveArousal[slot] += sign * change[0];
+        s.PositiveValence[slot] += sign * change[1];
+        s.NegativeArousal[slot] += sign * change[2];
+        s.NegativeValence[slot] += sign * change[3];
+    }
+
+    void EmotionSystem::changeMood(uint32_t slot)
+    {
+        auto& s = m_Storage;
+        ApplyMood(slot, s.Moods[slot], -1.0f);
+        s.Moods[slot] = s_EmotionMoods[static_cast<int>(s.State[slot])];
+        ApplyMood(slot, s.Moods[slot], 1.0f);
+        s.Timer[slot] = s_MoodTime;
+    }
+}
@@ -0,0 +1,278 @@
+﻿/*****************************************************************//**
+ * @file   EmotionSystem.h
+ * @brief  Structure of arrays storage for the EmotionComponents of a scene, updated in one pass a frame
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "Emotion.h"
+
+namespace tnah
+{
+    /**
+     * @struct EmotionStorage
+     * @brief The state of every emotion component, one entry per slot in each array. Freed slots are left with no
+     * multipliers and a timer that never runs out so the update can run over them without checking
+     *
+     * @author chris
+     */
+    struct EmotionStorage
+    {
+        std::vector<float> Arousal;
+        std::vector<float> Valence;
+        std::vector<float> PositiveArousal;
+        std::vector<float> NegativeArousal;
+        std::vector<float> PositiveValence;
+        std::vector<float> NegativeValence;
+        /** Seconds until the mood follows the emotion */
+        std::vector<float> Timer;
+        /** Table index of the quantised arousal and valence */
+        std::vector<uint8_t> Level;
+        /** Emotion table of each slot, 0 for the default table */
+        std::vector<uint16_t> Table;
+        /** If the timer had run out at the start of the update */
+        std::vector<uint8_t> Expired;
+        std::vector<Emotion> State;
+        std::vector<Mood> Moods;
+        /** Slots free to be handed out again */
+        std::vector<uint32_t> FreeSlots;
+    };
+
+    /**
+     * @class EmotionSystem
+     * @brief Owns the storage behind the EmotionComponents of one scene and steps them all together. Arousal and valence
+     * are quantised with comparisons into an index of an emotion table, so the update has no branches or map lookups.
+     * Every slot reads the default table until its component adds or removes an emotion, it then gets a table of its own
+     *
+     * @author chris
+     */
+    class EmotionSystem
+    {
+    public:
+        EmotionSystem();
+        ~EmotionSystem() = default;
+
+        /**
+         *
+         * @fn Allocate
+         * @brief Hands out a slot set to a neutral emotion with no traits
+         *
+         * @return the slot
+         * @author chris
+         */
+        uint32_t Allocate();
+
+        /**
+         *
+         * @fn Free
+         * @brief Gives a slot back, along with its own emotion table if it has one
+         *
+         * @param slot
+         * @author chris
+         */
+        void Free(uint32_t slot);
+
+        /**
+         *
+         * @fn Copy
+         * @brief Copies the state of a slot, which may belong to another system, into a slot of this one
+         *
+         * @param source the system the slot is copied from
+         * @param from
+         * @param to
+         * @author chris
+         */
+        void Copy(const EmotionSystem& source, uint32_t from, uint32_t to);
+
+        /**
+         *
+         * @fn Update
+         * @brief Steps every slot by the given time, in chunks across the job system once there are enough of them
+         *
+         * @param dt
+         * @author chris
+         */
+        void Update(float dt);
+
+        /**
+         *
+         * @fn Update
+         * @brief Steps a range of slots by the given time
+         *
+         * @param dt
+         * @param begin
+         * @param end
+         * @author chris
+         */
+        void Update(float dt, uint32_t begin, uint32_t end);
+
+        /**
+         *
+         * @fn Lookup
+         * @brief Gets the emotion the table of a slot holds for the quantised arousal and valence
+         *
+         * @param slot
+         * @param arousal
+         * @param valence
+         * @return Emotion
+         * @author chris
+         */
+        Emotion Lookup(uint32_t slot, float arousal, float valence) const
+        {
+            return m_Tables[m_Storage.Table[slot] * s_TableSize + TableIndex(arousal, valence)];
+        }
+
+        /**
+         *
+         * @fn SetTableEntry
+         * @brief Sets the emotion for the cell the arousal and valence quantise to, only for the given slot
+         *
+         * @param slot
+         * @param arousal
+         * @param valence
+         * @param e
+         * @author chris
+         */
+        void SetTableEntry(uint32_t slot, float arousal, float valence, Emotion e);
+
+        /**
+         *
+         * @fn ArousalLevel
+         * @brief Quantises arousal into one of six levels, lowest first
+         *
+         * @param arousal
+         * @return int
+         * @author chris
+         */
+        static int ArousalLevel(float arousal)
+        {
+            return static_cast<int>(arousal > 0.66f) + static_cast<int>(arousal > 0.33f) + static_cast<int>(arousal >= 0.0f)
+                + static_cast<int>(arousal >= -0.33f) + static_cast<int>(arousal >= -0.66f);
+        }
+
+        /**
+         *
+         * @fn ValenceLevel
+         * @brief Quantises valence into negative or positive
+         *
+         * @param valence
+         * @return int
+         * @author chris
+         */
+        static int ValenceLevel(float valence) { return static_cast<int>(valence >= 0.0f); }
+
+        /**
+         *
+         * @fn TableIndex
+         * @brief Gets the emotion table index of an arousal and valence
+         *
+         * @param arousal
+         * @param valence
+         * @return int
+         * @author chris
+         */
+        static int TableIndex(float arousal, float valence) { return ValenceLevel(valence) * s_ArousalLevels + ArousalLevel(arousal); }
+
+        /**
+         *
+         * @fn ScaledArousal
+         * @brief Gets the arousal a level stands for
+         *
+         * @param level
+         * @return float
+         * @author chris
+         */
+        static float ScaledArousal(int level) { return s_ArousalScale[level]; }
+
+        /**
+         *
+         * @fn ApplyMood
+         * @brief Adds the multiplier changes of a mood to a slot, or takes them away
+         *
+         * @param slot
+         * @param mood
+         * @param sign 1 to add, -1 to take away
+         * @author chris
+         */
+        void ApplyMood(uint32_t slot, Mood mood, float sign);
+
+        /**
+         *
+         * @fn GetStorage
+         * @brief Gets the storage
+         *
+         * @return EmotionStorage&
+         * @author chris
+         */
+        EmotionStorage& GetStorage() { return m_Storage; }
+
+        /**
+         *
+         * @fn GetCount
+         * @brief Gets the number of slots in use
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetCount() const { return m_Storage.Arousal.size() - m_Storage.FreeSlots.size(); }
+
+        /**
+         *
+         * @fn GetStandalone
+         * @brief Gets the system components start in. A scene moves its components into its own system as they are
+         * added, components kept outside a scene stay here and are only stepped by whoever owns them
+         *
+         * @return EmotionSystem&
+         * @author chris
+         */
+        static EmotionSystem& GetStandalone();
+
+        /** Seconds a mood lasts before following the emotion again */
+        static constexpr float s_MoodTime = 15.0f;
+        /** How much arousal and valence drift each second */
+        static constexpr float s_Drift = 0.0001f;
+        /** Slot index meaning no slot */
+        static constexpr uint32_t s_NoSlot = ~0u;
+        /** Fewest slots worth a job of their own */
+        static constexpr size_t s_ParallelGrain = 4096;
+
+    private:
+        /**
+         *
+         * @fn changeMood
+         * @brief Swaps the mood of a slot for the one its emotion leads to and restarts the timer
+         *
+         * @param slot
+         * @author chris
+         */
+        void changeMood(uint32_t slot);
+
+        /**
+         *
+         * @fn ownTable
+         * @brief Gives a slot reading the default table a copy of it, so its changes stay its own
+         *
+         * @param slot
+         * @author chris
+         */
+        void ownTable(uint32_t slot);
+
+        static constexpr int s_ArousalLevels = 6;
+        static constexpr float s_ArousalScale[s_ArousalLevels] = { -1.0f, -0.66f, -0.33f, 0.33f, 0.66f, 1.0f };
+        /** Cells in one emotion table */
+        static constexpr int s_TableSize = 2 * s_ArousalLevels;
+
+        /** Emotion of each quantised cell, negative valence first */
+        static constexpr Emotion s_DefaultTable[s_TableSize] = {
+            Emotion::Tired, Emotion::Bored, Emotion::Depressed, Emotion::Frustrated, Emotion::Angry, Emotion::Tense,
+            Emotion::Calm, Emotion::Relaxed, Emotion::Content, Emotion::Happy, Emotion::Delighted, Emotion::Excited
+        };
+
+        EmotionStorage m_Storage;
+        /** Every emotion table back to back, the default one first */
+        std::vector<Emotion> m_Tables;
+        /** Tables free to be handed out again */
+        std::vector<uint16_t> m_FreeTables;
+    };
+}
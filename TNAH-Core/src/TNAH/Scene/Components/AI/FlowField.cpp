@@ -0,0 +1,258 @@
+﻿#include "tnahpch.h"
+#include "FlowField.h"
+
+namespace tnah
+{
+#pragma region FlowField
+
+    FlowField::FlowField(const Ref<AStarGrid>& grid, Int2 goal)
+        : m_Grid(grid), m_Goal(goal)
+    {
+        m_GoalIndex = m_Grid->InBounds(goal) ? m_Grid->ToIndex(goal) : -1;
+        Build();
+    }
+
+    void FlowField::Build()
+    {
+        const size_t cellCount = m_Grid->GetCellCount();
+        m_Costs.assign(cellCount, s_Unreachable);
+        m_Directions.assign(cellCount, s_NoDirection);
+        m_InvalidMarks.assign(cellCount, false);
+        m_Version = m_Grid->GetVersion();
+
+        m_Seeds.clear();
+        if(m_GoalIndex < 0 || m_Grid->IsUsedIndex(m_GoalIndex))
+            return;
+
+        m_Costs[m_GoalIndex] = 0;
+        m_Seeds.emplace_back(0, m_GoalIndex);
+        propagate();
+    }
+
+    void FlowField::Sync()
+    {
+        if(m_Version == m_Grid->GetVersion())
+            return;
+
+        m_Changes.clear();
+        if(!m_Grid->GetChangedCells(m_Version, m_Changes))
+        {
+            Build();
+            return;
+        }
+
+        // The changes are replayed in order, only the state each cell ends up in matters
+        m_Invalid.clear();
+        m_Seeds.clear();
+        for(const auto& change : m_Changes)
+        {
+            if(change.Index == m_GoalIndex)
+            {
+                Build();
+                return;
+            }
+
+            if(m_InvalidMarks[change.Index])
+                continue;
+            m_InvalidMarks[change.Index] = true;
+            m_Invalid.push_back(change.Index);
+        }
+
+        // Every cell flowing into a changed cell has to find a new way, walk the flow backwards to collect them
+        for(size_t i = 0; i < m_Invalid.size(); i++)
+        {
+            const int index = m_Invalid[i];
+            const Int2 position = m_Grid->ToPosition(index);
+            for(int slot = 0; slot < 8; slot++)
+            {
+                const int from = neighbour(position, slot);
+                if(from < 0 || m_InvalidMarks[from] || m_Directions[from] == s_NoDirection)
+                    continue;
+
+                // The neighbour flows into this cell if its direction points back along this slot
+                if(direction(from) == (slot + 4) % 8)
+                {
+                    m_InvalidMarks[from] = true;
+                    m_Invalid.push_back(from);
+                }
+            }
+        }
+
+        for(int index : m_Invalid)
+        {
+            m_Costs[index] = s_Unreachable;
+            m_Directions[index] = s_NoDirection;
+        }
+
+        for(int index : m_Invalid)
+        {
+            m_InvalidMarks[index] = false;
+            if(!m_Grid->IsUsedIndex(index))
+                seedFromNeighbours(index);
+        }
+
+        std::sort(m_Seeds.begin(), m_Seeds.end());
+        propagate();
+        m_Version = m_Grid->GetVersion();
+    }
+
+    bool FlowField::IsReachable(Int2 cell) const
+    {
+        return m_Grid->InBounds(cell) && m_Costs[m_Grid->ToIndex(cell)] != s_Unreachable;
+    }
+
+    float FlowField::GetCost(Int2 cell) const
+    {
+        if(!IsReachable(cell))
+            return -1.0f;
+
+        return m_Costs[m_Grid->ToIndex(cell)] * 0.5f;
+    }
+
+    bool FlowField::GetNext(Int2 cell, Int2& next) const
+    {
+        if(!m_Grid->InBounds(cell))
+            return false;
+
+        const int slot = direction(m_Grid->ToIndex(cell));
+        if(slot == s_NoDirection)
+            return false;
+
+        next = Int2(cell.x + s_OffsetX[slot], cell.y + s_OffsetY[slot]);
+        return true;
+    }
+
+    glm::vec2 FlowField::GetDirection(Int2 cell) const
+    {
+        Int2 next;
+        if(!GetNext(cell, next))
+            return glm::vec2(0.0f);
+
+        return glm::normalize(glm::vec2(next.x - cell.x, next.y - cell.y));
+    }
+
+    int FlowField::neighbour(Int2 position, int slot) const
+    {
+        const Int2 cell(position.x + s_OffsetX[slot], position.y + s_OffsetY[slot]);
+        return m_Grid->InBounds(cell) ? m_Grid->ToIndex(cell) : -1;
+    }
+
+    void FlowField::seedFromNeighbours(int index)
+    {
+        const Int2 position = m_Grid->ToPosition(index);
+        int best = m_Costs[index];
+        uint8_t bestSlot = s_NoDirection;
+        for(int slot = 0; slot < 8; slot++)
+        {
+            const int to = neighbour(position, slot);
+            if(to < 0 || m_Costs[to] == s_Unreachable)
+                continue;
+
+            const int cost = m_Costs[to] + ((slot & 1) ? 3 : 2);
+            if(cost < best)
+            {
+                best = cost;
+                bestSlot = static_cast<uint8_t>(slot);
+            }
+        }
+
+        if(bestSlot == s_NoDirection)
+            return;
+
+        m_Costs[index] = best;
+        m_Directions[index] = bestSlot;
+        m_Seeds.emplace_back(best, index);
+    }
+
+    void FlowField::propagate()
+    {
+        // Dial's algorithm, moves cost 2 or 3 half steps so four buckets hold every pending cost. Seeds are fed in as the
+        // sweep reaches their cost, a cell whose cost dropped after it was queued is skipped when its stale entry comes up
+        size_t pending = 0;
+        size_t nextSeed = 0;
+        int cost = m_Seeds.empty() ? 0 : m_Seeds.front().first;
+        while(pending > 0 || nextSeed < m_Seeds.size())
+        {
+            if(pending == 0 && m_Seeds[nextSeed].first > cost)
+                cost = m_Seeds[nextSeed].first;
+
+            while(nextSeed < m_Seeds.size() && m_Seeds[nextSeed].first == cost)
+            {
+                m_Buckets[cost & 3].push_back(m_Seeds[nextSeed++].second);
+                pending++;
+            }
+
+            auto& bucket = m_Buckets[cost & 3];
+            while(!bucket.empty())
+            {
+                const int index = bucket.back();
+                bucket.pop_back();
+                pending--;
+                if(m_Costs[index] != cost)
+                    continue;
+
+                const Int2 position = m_Grid->ToPosition(index);
+                for(int slot = 0; slot < 8; slot++)
+                {
+                    const int to = neighbour(position, slot);
+                    if(to < 0 || m_Grid->IsUsedIndex(to))
+                        continue;
+
+                    const int next = cost + ((slot & 1) ? 3 : 2);
+                    if(next < m_Costs[to])
+                    {
+                        m_Costs[to] = next;
+                        // The neighbour steps back toward this cell, the opposite slot
+                        m_Directions[to] = static_cast<uint8_t>((slot + 4) % 8);
+                        m_Buckets[next & 3].push_back(to);
+                        pending++;
+                    }
+                }
+            }
+            cost++;
+        }
+        m_Seeds.clear();
+    }
+
+#pragma endregion
+
+#pragma region FlowFieldCache
+
+    FlowFieldCache::FlowFieldCache(const Ref<AStarGrid>& grid)
+        : m_Grid(grid)
+    {
+    }
+
+    Ref<FlowField> FlowFieldCache::Get(Int2 goal)
+    {
+        if(!m_Grid || !m_Grid->InBounds(goal))
+            return nullptr;
+
+        const int key = m_Grid->ToIndex(goal);
+        auto it = m_Fields.find(key);
+        if(it == m_Fields.end())
+        {
+            if(m_Fields.size() >= s_MaxFields)
+            {
+                auto oldest = m_Fields.begin();
+                for(auto field = m_Fields.begin(); field != m_Fields.end(); ++field)
+                {
+                    if(field->second.LastUsed < oldest->second.LastUsed)
+                        oldest = field;
+                }
+                m_Fields.erase(oldest);
+            }
+
+            it = m_Fields.emplace(key, CachedField{ Ref<FlowField>::Create(m_Grid, goal), 0 }).first;
+        }
+        else
+        {
+            it->second.Field->Sync();
+        }
+
+        it->second.LastUsed = ++m_UseCounter;
+        return it->second.Field;
+    }
+
+#pragma endregion
+}
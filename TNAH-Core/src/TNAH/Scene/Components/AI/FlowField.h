@@ -0,0 +1,249 @@
+﻿/*****************************************************************//**
+ * @file   FlowField.h
+ * @brief  Flow fields toward a goal cell of an AStarGrid, shared by every agent heading for that goal
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "AStar.h"
+
+#include <climits>
+
+namespace tnah
+{
+    /**
+     * @class FlowField
+     * @brief Holds the cost from every cell of a grid to one goal cell and the neighbour each cell should step to next.
+     * Built once with a Dijkstra sweep, after that occupancy changes are repaired locally: cells that became used take the
+     * cells flowing through them with them and those are refilled from their neighbours, cells that became free flood
+     * outward only as far as they lower costs.
+     *
+     * @author chris
+     */
+    class FlowField : public RefCounted
+    {
+    public:
+        FlowField(const Ref<AStarGrid>& grid, Int2 goal);
+        ~FlowField() = default;
+
+        /**
+         *
+         * @fn Build
+         * @brief Computes the whole field from scratch
+         *
+         * @author chris
+         */
+        void Build();
+
+        /**
+         *
+         * @fn Sync
+         * @brief Repairs the field for the cells that changed since it was last built or synced
+         *
+         * @author chris
+         */
+        void Sync();
+
+        /**
+         *
+         * @fn IsReachable
+         * @brief Checks if the goal can be reached from the cell
+         *
+         * @param cell
+         * @return bool
+         * @author chris
+         */
+        bool IsReachable(Int2 cell) const;
+
+        /**
+         *
+         * @fn GetCost
+         * @brief Gets the path cost from the cell to the goal
+         *
+         * @param cell
+         * @return the cost, a negative value if the goal cannot be reached
+         * @author chris
+         */
+        float GetCost(Int2 cell) const;
+
+        /**
+         *
+         * @fn GetNext
+         * @brief Gets the neighbour to step to from the cell
+         *
+         * @param cell
+         * @param next
+         * @return false if the cell is the goal or cannot reach it
+         * @author chris
+         */
+        bool GetNext(Int2 cell, Int2& next) const;
+
+        /**
+         *
+         * @fn GetDirection
+         * @brief Gets the unit direction to move in from the cell
+         *
+         * @param cell
+         * @return glm::vec2, zero if the cell is the goal or cannot reach it
+         * @author chris
+         */
+        glm::vec2 GetDirection(Int2 cell) const;
+
+        /**
+         *
+         * @fn GetGoal
+         * @brief Gets the goal cell
+         *
+         * @return Int2
+         * @author chris
+         */
+        Int2 GetGoal() const { return m_Goal; }
+
+        /**
+         *
+         * @fn GetVersion
+         * @brief Gets the grid version the field is in sync with
+         *
+         * @return uint64_t
+         * @author chris
+         */
+        uint64_t GetVersion() const { return m_Version; }
+
+    private:
+        /**
+         *
+         * @fn direction
+         * @brief Gets the neighbour slot of the cell the given cell steps to, s_NoDirection if none
+         *
+         * @param index
+         * @return int
+         * @author chris
+         */
+        int direction(int index) const { return m_Directions[index]; }
+
+        /**
+         *
+         * @fn neighbour
+         * @brief Gets the index of a neighbour of a cell
+         *
+         * @param position
+         * @param slot
+         * @return the index, -1 if it is out of bounds
+         * @author chris
+         */
+        int neighbour(Int2 position, int slot) const;
+
+        /**
+         *
+         * @fn propagate
+         * @brief Runs the Dijkstra sweep from the seeded cells, lowering the cost of every cell it reaches cheaper
+         *
+         * @author chris
+         */
+        void propagate();
+
+        /**
+         *
+         * @fn seedFromNeighbours
+         * @brief Gives a cell the cheapest cost it can get from its neighbours and seeds the sweep with it
+         *
+         * @param index
+         * @author chris
+         */
+        void seedFromNeighbours(int index);
+
+        /** The grid the field is built on */
+        Ref<AStarGrid> m_Grid;
+        /** The cell everything flows to */
+        Int2 m_Goal;
+        /** Row major index of the goal */
+        int m_GoalIndex = -1;
+        /** Cost of each cell in half steps */
+        std::vector<int> m_Costs;
+        /** Neighbour slot each cell steps to */
+        std::vector<uint8_t> m_Directions;
+        /** Cells with a cost, waiting to be swept, sorted by cost once seeding is done */
+        std::vector<std::pair<int, int>> m_Seeds;
+        /** Ring of cost buckets for the sweep, one more than the largest move cost */
+        std::array<std::vector<int>, 4> m_Buckets;
+        /** Cells dropped by a repair */
+        std::vector<int> m_Invalid;
+        /** Marks the cells in m_Invalid */
+        std::vector<bool> m_InvalidMarks;
+        /** Scratch list of changed cells */
+        std::vector<AStarCellChange> m_Changes;
+        /** The grid version the field is in sync with */
+        uint64_t m_Version = 0;
+
+        /** Cost of an unreachable cell */
+        static constexpr int s_Unreachable = INT_MAX;
+        /** Direction of the goal and of cells that cannot reach it */
+        static constexpr uint8_t s_NoDirection = 8;
+        /** Offsets of the eight neighbours */
+        static constexpr int s_OffsetX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+        static constexpr int s_OffsetY[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    };
+
+    /**
+     * @class FlowFieldCache
+     * @brief Keeps a flow field per goal cell so any number of agents sharing a goal sample one field, the least recently
+     * used field is dropped once the cache is full
+     *
+     * @author chris
+     */
+    class FlowFieldCache : public RefCounted
+    {
+    public:
+        FlowFieldCache(const Ref<AStarGrid>& grid);
+        ~FlowFieldCache() = default;
+
+        /**
+         *
+         * @fn Get
+         * @brief Gets the field for the goal, building it or repairing it as needed
+         *
+         * @param goal
+         * @return the field, null if the goal is outside the grid
+         * @author chris
+         */
+        Ref<FlowField> Get(Int2 goal);
+
+        /**
+         *
+         * @fn Clear
+         * @brief Drops every field
+         *
+         * @author chris
+         */
+        void Clear() { m_Fields.clear(); }
+
+        /**
+         *
+         * @fn GetFieldCount
+         * @brief Gets the number of cached fields
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetFieldCount() const { return m_Fields.size(); }
+
+    private:
+        /** A cached field and when it was last used */
+        struct CachedField
+        {
+            Ref<FlowField> Field;
+            uint64_t LastUsed = 0;
+        };
+
+        /** The grid the fields are built on */
+        Ref<AStarGrid> m_Grid;
+        /** Fields by goal cell index */
+        std::unordered_map<int, CachedField> m_Fields;
+        /** Counts calls to Get to order fields by use */
+        uint64_t m_UseCounter = 0;
+
+        /** Most fields kept at once, each costs five bytes per grid cell */
+        static constexpr size_t s_MaxFields = 16;
+    };
+}
@@ -0,0 +1,616 @@
+﻿#include "tnahpch.h"
+#include "HPAStar.h"
+
+#include <bit>
+#include <climits>
+
+namespace tnah
+{
+    HPAStarGraph::HPAStarGraph(const Ref<AStarGrid>& grid, int clusterSize)
+        : m_Grid(grid)
+    {
+        const Int2 size = m_Grid->GetSize();
+        // Larger grids get larger clusters so the abstract graph stays small enough to search quickly
+        if(clusterSize <= 0)
+            clusterSize = std::clamp(std::max(size.x, size.y) / s_ClustersPerSide, 16, 64);
+        m_ClusterSize = std::max(clusterSize, 2);
+
+        m_ClustersX = (size.x + m_ClusterSize - 1) / m_ClusterSize;
+        m_ClustersY = (size.y + m_ClusterSize - 1) / m_ClusterSize;
+
+        const size_t clusterCount = static_cast<size_t>(m_ClustersX) * static_cast<size_t>(m_ClustersY);
+        m_Clusters.resize(clusterCount);
+        m_EastBorders.resize(clusterCount);
+        m_NorthBorders.resize(clusterCount);
+    }
+
+    HPAStarGraph::~HPAStarGraph()
+    {
+        if(m_Building)
+            JobSystem::Wait(m_PendingBuild);
+    }
+
+    void HPAStarGraph::Build()
+    {
+        for(auto& cluster : m_Clusters)
+            cluster.Nodes.clear();
+        for(auto& border : m_EastBorders)
+            border.clear();
+        for(auto& border : m_NorthBorders)
+            border.clear();
+        m_Nodes.clear();
+        m_FreeNodes.clear();
+        m_CellNodes.clear();
+        m_DirtyBorders.clear();
+        m_DirtyClusters.clear();
+
+        for(int cluster = 0; cluster < (int)m_Clusters.size(); cluster++)
+        {
+            rebuildBorder(cluster, true);
+            rebuildBorder(cluster, false);
+        }
+
+        for(int cluster = 0; cluster < (int)m_Clusters.size(); cluster++)
+            rebuildIntra(cluster);
+
+        m_Cells = m_Grid->GetUsedCells();
+        m_SyncedVersion = m_Grid->GetVersion();
+        m_Built = true;
+    }
+
+    void HPAStarGraph::BuildAsync()
+    {
+        if(m_Building)
+            return;
+
+        // The grid keeps changing while the build runs, so it works on a copy and the changes since are synced after
+        m_Building = true;
+        m_PendingVersion = m_Grid->GetVersion();
+        JobSystem::Run([this, used = m_Grid->GetUsedCells(), origin = m_Grid->GetStartingPos(), size = m_Grid->GetSize()]()
+        {
+            auto copy = Ref<AStarGrid>::Create(origin, size);
+            copy->BakeStaticCells(used);
+            m_Pending = Ref<HPAStarGraph>::Create(copy, m_ClusterSize);
+            m_Pending->Build();
+        }, &m_PendingBuild);
+    }
+
+    void HPAStarGraph::WaitForBuild()
+    {
+        if(!m_Building)
+            return;
+
+        JobSystem::Wait(m_PendingBuild);
+        adoptBuild();
+    }
+
+    bool HPAStarGraph::IsReady(const std::function<bool()>& spent)
+    {
+        if(m_Building && m_PendingBuild.IsDone())
+            adoptBuild();
+
+        if(!m_Built)
+        {
+            BuildAsync();
+            // Without workers the build has already run
+            if(m_PendingBuild.IsDone())
+                adoptBuild();
+            if(!m_Built)
+                return false;
+        }
+
+        // A build that ran while the grid kept changing can leave a lot to catch up on, so it is spread over calls
+        collectChanges();
+        return syncDirty(spent);
+    }
+
+    void HPAStarGraph::adoptBuild()
+    {
+        m_Clusters = std::move(m_Pending->m_Clusters);
+        m_EastBorders = std::move(m_Pending->m_EastBorders);
+        m_NorthBorders = std::move(m_Pending->m_NorthBorders);
+        m_Nodes = std::move(m_Pending->m_Nodes);
+        m_FreeNodes = std::move(m_Pending->m_FreeNodes);
+        m_CellNodes = std::move(m_Pending->m_CellNodes);
+        m_Cells = std::move(m_Pending->m_Cells);
+        m_DirtyBorders.clear();
+        m_DirtyClusters.clear();
+        m_SyncedVersion = m_PendingVersion;
+        m_Built = true;
+        m_Pending = nullptr;
+        m_Building = false;
+    }
+
+    void HPAStarGraph::Sync()
+    {
+        if(m_Built)
+        {
+            collectChanges();
+            syncDirty({});
+        }
+        else
+        {
+            Build();
+        }
+    }
+
+    void HPAStarGraph::collectChanges()
+    {
+        if(m_SyncedVersion == m_Grid->GetVersion())
+            return;
+
+        // The grid's history is the cheap way to find what changed, once it no longer reaches back far enough the
+        // occupancy the graph was built from is compared with the grid's instead
+        const auto& used = m_Grid->GetUsedCells();
+        std::vector<int> changed;
+        std::vector<AStarCellChange> changes;
+        if(m_Grid->GetChangedCells(m_SyncedVersion, changes))
+        {
+            for(const auto& change : changes)
+            {
+                changed.push_back(change.Index);
+                const uint64_t bit = 1ull << (change.Index & 63);
+                m_Cells[change.Index >> 6] = (m_Cells[change.Index >> 6] & ~bit) | (used[change.Index >> 6] & bit);
+            }
+        }
+        else
+        {
+            for(size_t word = 0; word < used.size(); word++)
+            {
+                for(uint64_t bits = used[word] ^ m_Cells[word]; bits != 0; bits &= bits - 1)
+                    changed.push_back(static_cast<int>(word * 64) + std::countr_zero(bits));
+                m_Cells[word] = used[word];
+            }
+        }
+
+        // Every changed cluster needs new intra costs, a border only needs rebuilding if a changed cell lies on it
+        auto& rebuild = m_DirtyClusters;
+        auto& borders = m_DirtyBorders;
+        const int gridWidth = m_Grid->GetSize().x;
+        for(int index : changed)
+        {
+            const int cluster = clusterOf(index);
+            rebuild.push_back(cluster);
+
+            int x, y, width, height;
+            clusterBounds(cluster, x, y, width, height);
+            const int localX = index % gridWidth - x;
+            const int localY = index / gridWidth - y;
+            if(localX == width - 1)
+                borders.push_back(cluster * 2);
+            if(localX == 0 && cluster % m_ClustersX > 0)
+                borders.push_back((cluster - 1) * 2);
+            if(localY == height - 1)
+                borders.push_back(cluster * 2 + 1);
+            if(localY == 0 && cluster / m_ClustersX > 0)
+                borders.push_back((cluster - m_ClustersX) * 2 + 1);
+        }
+
+        m_SyncedVersion = m_Grid->GetVersion();
+    }
+
+    bool HPAStarGraph::syncDirty(const std::function<bool()>& spent)
+    {
+        const auto done = [&]() { return m_DirtyBorders.empty() && m_DirtyClusters.empty(); };
+
+        // Borders decide which nodes a cluster has, so every queued border goes before any cluster
+        std::sort(m_DirtyBorders.begin(), m_DirtyBorders.end());
+        m_DirtyBorders.erase(std::unique(m_DirtyBorders.begin(), m_DirtyBorders.end()), m_DirtyBorders.end());
+        while(!m_DirtyBorders.empty())
+        {
+            const int cluster = m_DirtyBorders.back() / 2;
+            const bool east = (m_DirtyBorders.back() & 1) == 0;
+            m_DirtyBorders.pop_back();
+
+            // The neighbour only needs new intra costs if its entrance nodes actually moved
+            if(rebuildBorder(cluster, east))
+            {
+                m_DirtyClusters.push_back(cluster);
+                m_DirtyClusters.push_back(east ? cluster + 1 : cluster + m_ClustersX);
+            }
+
+            if(spent && spent() && !done())
+                return false;
+        }
+
+        std::sort(m_DirtyClusters.begin(), m_DirtyClusters.end());
+        m_DirtyClusters.erase(std::unique(m_DirtyClusters.begin(), m_DirtyClusters.end()), m_DirtyClusters.end());
+        while(!m_DirtyClusters.empty())
+        {
+            rebuildIntra(m_DirtyClusters.back());
+            m_DirtyClusters.pop_back();
+
+            if(spent && spent() && !done())
+                return false;
+        }
+
+        return true;
+    }
+
+    bool HPAStarGraph::IsLongRange(Int2 start, Int2 goal) const
+    {
+        return std::max(std::abs(start.x - goal.x), std::abs(start.y - goal.y)) > m_ClusterSize * 2;
+    }
+
+    bool HPAStarGraph::FindRoute(Int2 start, Int2 goal, HPARoute& route)
+    {
+        route = HPARoute();
+        if(!m_Grid->IsValid(start) || !m_Grid->IsValid(goal))
+            return false;
+
+        Sync();
+
+        const int startCell = m_Grid->ToIndex(start);
+        const int goalCell = m_Grid->ToIndex(goal);
+        const int startCluster = clusterOf(startCell);
+        const int goalCluster = clusterOf(goalCell);
+
+        // The start and goal join the graph for this query only, linked to the nodes of their clusters
+        linkCell(startCluster, startCell, m_StartLinks);
+        const float direct = startCluster == goalCluster ? localCost(startCluster, goalCell) : FLT_MAX;
+        linkCell(goalCluster, goalCell, m_GoalLinks);
+
+        const int startNode = (int)m_Nodes.size();
+        const int goalNode = startNode + 1;
+        auto cellOf = [&](int node) { return node == startNode ? startCell : node == goalNode ? goalCell : m_Nodes[node].Cell; };
+
+        // Rounded up so small changes to the node count do not resize the context
+        m_AbstractContext.Begin((m_Nodes.size() + 2 + 1023) & ~size_t(1023), startNode, goalNode);
+        AStarCell& first = m_AbstractContext.Touch(startNode);
+        first.g = 0.0f;
+        first.h = heuristic(startCell, goalCell) * s_HeuristicWeight;
+        first.f = first.h;
+        first.parent = startNode;
+        m_AbstractContext.OpenPush(startNode);
+
+        auto relax = [&](int from, int to, float cost)
+        {
+            AStarCell& next = m_AbstractContext.Touch(to);
+            if(next.closed)
+                return;
+
+            const float gNew = m_AbstractContext.Cell(from).g + cost;
+            if(gNew < next.g)
+            {
+                next.g = gNew;
+                next.h = heuristic(cellOf(to), goalCell) * s_HeuristicWeight;
+                next.f = gNew + next.h;
+                next.parent = from;
+
+                if(next.heapIndex < 0)
+                    m_AbstractContext.OpenPush(to);
+                else
+                    m_AbstractContext.OpenDecrease(to);
+            }
+        };
+
+        while(!m_AbstractContext.OpenEmpty())
+        {
+            const int current = m_AbstractContext.OpenPop();
+            m_AbstractContext.Cell(current).closed = true;
+
+            if(current == goalNode)
+            {
+                std::vector<Int2> reversed;
+                for(int node = goalNode; ; node = m_AbstractContext.Cell(node).parent)
+                {
+                    const Int2 position = m_Grid->ToPosition(cellOf(node));
+                    if(reversed.empty() || !reversed.back().CheckSame(position))
+                        reversed.push_back(position);
+                    if(node == startNode)
+                        break;
+                }
+
+                route.Waypoints.assign(reversed.rbegin(), reversed.rend());
+                return true;
+            }
+
+            if(current == startNode)
+            {
+                for(const auto& link : m_StartLinks)
+                    relax(current, link.Node, link.Cost);
+                if(direct != FLT_MAX)
+                    relax(current, goalNode, direct);
+                continue;
+            }
+
+            const AbstractNode& node = m_Nodes[current];
+            for(const auto& edge : node.Edges)
+                relax(current, edge.Node, edge.Cost);
+
+            if(node.Cluster == goalCluster)
+            {
+                for(const auto& link : m_GoalLinks)
+                {
+                    if(link.Node == current)
+                    {
+                        relax(current, goalNode, link.Cost);
+                        break;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool HPAStarGraph::RefineNext(HPARoute& route, std::deque<Node>& path)
+    {
+        if(route.Done())
+            return false;
+
+        std::deque<Node> segment = m_Grid->FindPath(route.Waypoints[route.Next], route.Waypoints[route.Next + 1], m_RefineContext);
+        if(segment.empty())
+            return false;
+
+        // Every segment after the first starts where the previous one ended
+        if(route.Next > 0)
+            segment.pop_front();
+
+        path.insert(path.end(), segment.begin(), segment.end());
+        route.Next++;
+        return true;
+    }
+
+    float HPAStarGraph::heuristic(int cell, int goal) const
+    {
+        // Octile distance with the grid's 1.5 diagonal, exact on open ground and never more than the real cost
+        const int width = m_Grid->GetSize().x;
+        const int dx = std::abs(cell % width - goal % width);
+        const int dy = std::abs(cell / width - goal / width);
+        return (float)std::max(dx, dy) + 0.5f * (float)std::min(dx, dy);
+    }
+
+    int HPAStarGraph::clusterOf(int cell) const
+    {
+        const int width = m_Grid->GetSize().x;
+        return (cell / width / m_ClusterSize) * m_ClustersX + (cell % width) / m_ClusterSize;
+    }
+
+    void HPAStarGraph::clusterBounds(int cluster, int& x, int& y, int& width, int& height) const
+    {
+        const Int2 size = m_Grid->GetSize();
+        x = (cluster % m_ClustersX) * m_ClusterSize;
+        y = (cluster / m_ClustersX) * m_ClusterSize;
+        width = std::min(m_ClusterSize, size.x - x);
+        height = std::min(m_ClusterSize, size.y - y);
+    }
+
+    bool HPAStarGraph::rebuildBorder(int cluster, bool east)
+    {
+        const int cx = cluster % m_ClustersX;
+        const int cy = cluster / m_ClustersX;
+        if((east && cx + 1 >= m_ClustersX) || (!east && cy + 1 >= m_ClustersY))
+            return false;
+
+        int x, y, width, height;
+        clusterBounds(cluster, x, y, width, height);
+        const int gridWidth = m_Grid->GetSize().x;
+
+        // Walk the last column or row of the cluster alongside the first one of its neighbour
+        const int length = east ? height : width;
+        auto transitionAt = [&](int i)
+        {
+            const int inside = east ? (y + i) * gridWidth + (x + width - 1) : (y + height - 1) * gridWidth + (x + i);
+            return Transition(inside, east ? inside + 1 : inside + gridWidth);
+        };
+
+        auto& transitions = m_BorderScratch;
+        transitions.clear();
+        int runStart = -1;
+        for(int i = 0; i <= length; i++)
+        {
+            bool open = false;
+            if(i < length)
+            {
+                const Transition transition = transitionAt(i);
+                open = !m_Grid->IsUsedIndex(transition.first) && !m_Grid->IsUsedIndex(transition.second);
+            }
+
+            if(open && runStart < 0)
+            {
+                runStart = i;
+            }
+            else if(!open && runStart >= 0)
+            {
+                const int runLength = i - runStart;
+                if(runLength >= s_WideEntrance)
+                {
+                    transitions.push_back(transitionAt(runStart));
+                    transitions.push_back(transitionAt(i - 1));
+                }
+                else
+                {
+                    transitions.push_back(transitionAt(runStart + (runLength - 1) / 2));
+                }
+                runStart = -1;
+            }
+        }
+
+        auto& border = east ? m_EastBorders[cluster] : m_NorthBorders[cluster];
+        if(transitions == border)
+            return false;
+
+        for(const auto& transition : border)
+            removeTransition(transition);
+        border = transitions;
+        for(const auto& transition : border)
+            addTransition(transition);
+        return true;
+    }
+
+    void HPAStarGraph::rebuildIntra(int cluster)
+    {
+        const auto& nodes = m_Clusters[cluster].Nodes;
+        for(int node : nodes)
+        {
+            auto& edges = m_Nodes[node].Edges;
+            edges.erase(std::remove_if(edges.begin(), edges.end(),
+                [&](const Edge& edge) { return m_Nodes[edge.Node].Cluster == cluster; }), edges.end());
+        }
+
+        for(size_t i = 0; i < nodes.size(); i++)
+        {
+            searchCluster(cluster, m_Nodes[nodes[i]].Cell);
+            for(size_t j = i + 1; j < nodes.size(); j++)
+            {
+                const float cost = localCost(cluster, m_Nodes[nodes[j]].Cell);
+                if(cost == FLT_MAX)
+                    continue;
+
+                m_Nodes[nodes[i]].Edges.push_back({nodes[j], cost});
+                m_Nodes[nodes[j]].Edges.push_back({nodes[i], cost});
+            }
+        }
+    }
+
+    void HPAStarGraph::searchCluster(int cluster, int cell)
+    {
+        int x, y, width, height;
+        clusterBounds(cluster, x, y, width, height);
+        const int gridWidth = m_Grid->GetSize().x;
+
+        m_LocalCosts.assign(static_cast<size_t>(width) * static_cast<size_t>(height), INT_MAX);
+        for(auto& bucket : m_LocalBuckets)
+            bucket.clear();
+
+        const int source = (cell / gridWidth - y) * width + (cell % gridWidth - x);
+        m_LocalCosts[source] = 0;
+        m_LocalBuckets[0].push_back(source);
+
+        // Same moves and costs as AStarGrid::FindPath limited to the cluster, costs are kept in half steps so
+        // every move costs 2 or 3 and a ring of buckets replaces the heap
+        size_t queued = 1;
+        for(int cost = 0; queued > 0; cost++)
+        {
+            auto& bucket = m_LocalBuckets[cost % m_LocalBuckets.size()];
+            while(!bucket.empty())
+            {
+                const int current = bucket.back();
+                bucket.pop_back();
+                queued--;
+                if(m_LocalCosts[current] != cost)
+                    continue;
+
+                const int cx = current % width;
+                const int cy = current / width;
+                for(int dy = -1; dy <= 1; dy++)
+                {
+                    const int ny = cy + dy;
+                    if(ny < 0 || ny >= height)
+                        continue;
+
+                    for(int dx = -1; dx <= 1; dx++)
+                    {
+                        const int nx = cx + dx;
+                        if((dx == 0 && dy == 0) || nx < 0 || nx >= width)
+                            continue;
+
+                        const int next = ny * width + nx;
+                        const int nextCost = cost + ((dx != 0 && dy != 0) ? 3 : 2);
+                        if(nextCost >= m_LocalCosts[next] || m_Grid->IsUsedIndex((y + ny) * gridWidth + (x + nx)))
+                            continue;
+
+                        m_LocalCosts[next] = nextCost;
+                        m_LocalBuckets[nextCost % m_LocalBuckets.size()].push_back(next);
+                        queued++;
+                    }
+                }
+            }
+        }
+    }
+
+    float HPAStarGraph::localCost(int cluster, int cell) const
+    {
+        int x, y, width, height;
+        clusterBounds(cluster, x, y, width, height);
+        const int gridWidth = m_Grid->GetSize().x;
+        const int cost = m_LocalCosts[(cell / gridWidth - y) * width + (cell % gridWidth - x)];
+        return cost == INT_MAX ? FLT_MAX : cost * 0.5f;
+    }
+
+    void HPAStarGraph::linkCell(int cluster, int cell, std::vector<Edge>& links)
+    {
+        links.clear();
+        searchCluster(cluster, cell);
+        for(int node : m_Clusters[cluster].Nodes)
+        {
+            const float cost = localCost(cluster, m_Nodes[node].Cell);
+            if(cost != FLT_MAX)
+                links.push_back({node, cost});
+        }
+    }
+
+    void HPAStarGraph::addTransition(const Transition& transition)
+    {
+        const int inside = getOrCreateNode(transition.first);
+        const int outside = getOrCreateNode(transition.second);
+        m_Nodes[inside].Transitions++;
+        m_Nodes[outside].Transitions++;
+        m_Nodes[inside].Edges.push_back({outside, 1.0f});
+        m_Nodes[outside].Edges.push_back({inside, 1.0f});
+    }
+
+    void HPAStarGraph::removeTransition(const Transition& transition)
+    {
+        const int inside = m_CellNodes.at(transition.first);
+        const int outside = m_CellNodes.at(transition.second);
+        removeEdge(inside, outside);
+        removeEdge(outside, inside);
+
+        if(--m_Nodes[inside].Transitions == 0)
+            deleteNode(inside);
+        if(--m_Nodes[outside].Transitions == 0)
+            deleteNode(outside);
+    }
+
+    int HPAStarGraph::getOrCreateNode(int cell)
+    {
+        const auto found = m_CellNodes.find(cell);
+        if(found != m_CellNodes.end())
+            return found->second;
+
+        int node;
+        if(!m_FreeNodes.empty())
+        {
+            node = m_FreeNodes.back();
+            m_FreeNodes.pop_back();
+        }
+        else
+        {
+            node = (int)m_Nodes.size();
+            m_Nodes.emplace_back();
+        }
+
+        AbstractNode& created = m_Nodes[node];
+        created.Cell = cell;
+        created.Cluster = clusterOf(cell);
+        created.Transitions = 0;
+        created.Edges.clear();
+        m_Clusters[created.Cluster].Nodes.push_back(node);
+        m_CellNodes[cell] = node;
+        return node;
+    }
+
+    void HPAStarGraph::deleteNode(int node)
+    {
+        AbstractNode& removed = m_Nodes[node];
+        for(const auto& edge : removed.Edges)
+            removeEdge(edge.Node, node);
+
+        auto& clusterNodes = m_Clusters[removed.Cluster].Nodes;
+        clusterNodes.erase(std::remove(clusterNodes.begin(), clusterNodes.end(), node), clusterNodes.end());
+        m_CellNodes.erase(removed.Cell);
+
+        removed = AbstractNode();
+        m_FreeNodes.push_back(node);
+    }
+
+    void HPAStarGraph::removeEdge(int from, int to)
+    {
+        auto& edges = m_Nodes[from].Edges;
+        const auto edge = std::find_if(edges.begin(), edges.end(), [to](const Edge& e) { return e.Node == to; });
+        if(edge != edges.end())
+            edges.erase(edge);
+    }
+}
@@ -0,0 +1,455 @@
+﻿/*****************************************************************//**
+ * @file   HPAStar.h
+ * @brief  Hierarchical pathfinding over clusters of an AStarGrid
+ *
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "AStar.h"
+#include "TNAH/Core/JobSystem.h"
+
+namespace tnah
+{
+    /**
+     * @struct HPARoute
+     * @brief A route through the abstract graph, each pair of waypoints is refined into grid cells only when needed
+     *
+     * @author chris
+     */
+    struct HPARoute
+    {
+        /** The start, the entrances passed through and the goal */
+        std::vector<Int2> Waypoints = {};
+        /** The waypoint the next segment to refine starts from */
+        size_t Next = 0;
+
+        /**
+         *
+         * @fn Done
+         * @brief Checks if every segment has been refined
+         *
+         * @return bool
+         * @author chris
+         */
+        bool Done() const { return Next + 1 >= Waypoints.size(); }
+    };
+
+    /**
+     * @class HPAStarGraph
+     * @brief Splits an AStarGrid into square clusters joined by entrances on the cluster borders. Entrances become
+     * abstract nodes connected by the cost of the best path between them inside their cluster, so a long query only
+     * searches the small abstract graph. Clusters touched by occupancy changes are rebuilt on the next query, or a few
+     * at a time by IsReady. A full build takes long enough on large grids that it runs on the job system from a copy
+     * of the occupancy.
+     *
+     * @author chris
+     */
+    class HPAStarGraph : public RefCounted
+    {
+    public:
+        /**
+         *
+         * @fn HPAStarGraph
+         * @brief Constructor, the graph is built by BuildAsync or on first use
+         *
+         * @param grid
+         * @param clusterSize cells along a cluster side, 0 picks one from the grid size
+         * @author chris
+         */
+        HPAStarGraph(const Ref<AStarGrid>& grid, int clusterSize = 0);
+
+        /**
+         *
+         * @fn ~HPAStarGraph
+         * @brief Destructor, waits for a background build to finish
+         *
+         * @author chris
+         */
+        ~HPAStarGraph();
+
+        /**
+         *
+         * @fn Build
+         * @brief Builds every cluster from scratch
+         *
+         * @author chris
+         */
+        void Build();
+
+        /**
+         *
+         * @fn BuildAsync
+         * @brief Starts building every cluster on the job system from a copy of the grid's occupancy, does nothing if
+         * a build is already running. IsReady picks the result up.
+         *
+         * @author chris
+         */
+        void BuildAsync();
+
+        /**
+         *
+         * @fn WaitForBuild
+         * @brief Waits for a background build to finish and picks it up, does nothing if none is running
+         *
+         * @author chris
+         */
+        void WaitForBuild();
+
+        /**
+         *
+         * @fn IsReady
+         * @brief Picks up a finished background build and catches it up with the grid, rebuilding changed clusters
+         * until spent reports the caller's budget is used up. Nothing here waits for a build, a graph that is not
+         * built yet starts one in the background and answers false.
+         *
+         * @param spent called after each border or cluster rebuild, returns true once no more time should be spent syncing.
+         * Without one every change is synced.
+         * @return true if the graph is built and in sync
+         * @author chris
+         */
+        bool IsReady(const std::function<bool()>& spent = {});
+
+        /**
+         *
+         * @fn Sync
+         * @brief Rebuilds only the clusters whose cells changed since the last sync, builds everything the first time
+         *
+         * @author chris
+         */
+        void Sync();
+
+        /**
+         *
+         * @fn IsLongRange
+         * @brief Checks if a query is far enough to be worth running on the abstract graph
+         *
+         * @param start
+         * @param goal
+         * @return bool
+         * @author chris
+         */
+        bool IsLongRange(Int2 start, Int2 goal) const;
+
+        /**
+         *
+         * @fn FindRoute
+         * @brief Searches the abstract graph for a route from the start to the goal
+         *
+         * @param start
+         * @param goal
+         * @param route
+         * @return false if no route was found
+         * @author chris
+         */
+        bool FindRoute(Int2 start, Int2 goal, HPARoute& route);
+
+        /**
+         *
+         * @fn RefineNext
+         * @brief Turns the next segment of the route into grid cells and appends them to the path
+         *
+         * @param route
+         * @param path
+         * @return false if the route is done or the segment is blocked
+         * @author chris
+         */
+        bool RefineNext(HPARoute& route, std::deque<Node>& path);
+
+        /**
+         *
+         * @fn GetClusterSize
+         * @brief Gets the number of cells along a cluster side
+         *
+         * @return int
+         * @author chris
+         */
+        int GetClusterSize() const { return m_ClusterSize; }
+
+        /**
+         *
+         * @fn GetClusterCount
+         * @brief Gets the number of clusters
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetClusterCount() const { return m_Clusters.size(); }
+
+        /**
+         *
+         * @fn GetNodeCount
+         * @brief Gets the number of abstract nodes
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetNodeCount() const { return m_CellNodes.size(); }
+
+    private:
+        /** A connection between two abstract nodes */
+        struct Edge
+        {
+            int Node = -1;
+            float Cost = 0.0f;
+        };
+
+        /** An entrance cell on a cluster border */
+        struct AbstractNode
+        {
+            /** Row major index of the cell, -1 if the slot is free */
+            int Cell = -1;
+            /** The cluster the cell is in */
+            int Cluster = -1;
+            /** Number of border transitions using this node */
+            int Transitions = 0;
+            /** Edges to the other nodes of the cluster and across the border */
+            std::vector<Edge> Edges = {};
+        };
+
+        /** The abstract nodes inside one cluster */
+        struct Cluster
+        {
+            std::vector<int> Nodes = {};
+        };
+
+        /** A pair of cells facing each other across a border, both become nodes */
+        using Transition = std::pair<int, int>;
+
+        /**
+         *
+         * @fn heuristic
+         * @brief Estimates the cost between two cells
+         *
+         * @param cell
+         * @param goal
+         * @return float
+         * @author chris
+         */
+        float heuristic(int cell, int goal) const;
+
+        /**
+         *
+         * @fn clusterOf
+         * @brief Gets the cluster a cell is in
+         *
+         * @param cell
+         * @return int
+         * @author chris
+         */
+        int clusterOf(int cell) const;
+
+        /**
+         *
+         * @fn clusterBounds
+         * @brief Gets the first cell column and row of a cluster and its size, clipped to the grid
+         *
+         * @param cluster
+         * @param x
+         * @param y
+         * @param width
+         * @param height
+         * @author chris
+         */
+        void clusterBounds(int cluster, int& x, int& y, int& width, int& height) const;
+
+        /**
+         *
+         * @fn rebuildBorder
+         * @brief Replaces the transitions on the east or north border of a cluster
+         *
+         * @param cluster
+         * @param east
+         * @return true if the transitions changed
+         * @author chris
+         */
+        bool rebuildBorder(int cluster, bool east);
+
+        /**
+         *
+         * @fn rebuildIntra
+         * @brief Recomputes the costs between every pair of nodes in a cluster
+         *
+         * @param cluster
+         * @author chris
+         */
+        void rebuildIntra(int cluster);
+
+        /**
+         *
+         * @fn searchCluster
+         * @brief Fills m_LocalCosts with the cost from the cell to every cell of its cluster without leaving it
+         *
+         * @param cluster
+         * @param cell
+         * @author chris
+         */
+        void searchCluster(int cluster, int cell);
+
+        /**
+         *
+         * @fn localCost
+         * @brief Reads the cost to a cell from the last searchCluster
+         *
+         * @param cluster
+         * @param cell
+         * @return float
+         * @author chris
+         */
+        float localCost(int cluster, int cell) const;
+
+        /**
+         *
+         * @fn linkCell
+         * @brief Collects the cost from a cell to every node of its cluster
+         *
+         * @param cluster
+         * @param cell
+         * @param links
+         * @author chris
+         */
+        void linkCell(int cluster, int cell, std::vector<Edge>& links);
+
+        /**
+         *
+         * @fn addTransition
+         * @brief Adds a border transition, creating the nodes on both sides if needed
+         *
+         * @param transition
+         * @author chris
+         */
+        void addTransition(const Transition& transition);
+
+        /**
+         *
+         * @fn removeTransition
+         * @brief Removes a border transition, deleting nodes no longer used by any transition
+         *
+         * @param transition
+         * @author chris
+         */
+        void removeTransition(const Transition& transition);
+
+        /**
+         *
+         * @fn getOrCreateNode
+         * @brief Gets the node for the cell, creating it if needed
+         *
+         * @param cell
+         * @return int
+         * @author chris
+         */
+        int getOrCreateNode(int cell);
+
+        /**
+         *
+         * @fn deleteNode
+         * @brief Deletes the node and every edge pointing at it
+         *
+         * @param node
+         * @author chris
+         */
+        void deleteNode(int node);
+
+        /**
+         *
+         * @fn removeEdge
+         * @brief Removes the edge from one node to another
+         *
+         * @param from
+         * @param to
+         * @author chris
+         */
+        void removeEdge(int from, int to);
+
+        /**
+         *
+         * @fn collectChanges
+         * @brief Queues the borders and clusters of every cell that changed since the last sync
+         *
+         * @author chris
+         */
+        void collectChanges();
+
+        /**
+         *
+         * @fn syncDirty
+         * @brief Rebuilds the queued borders, then the queued clusters, until spent returns true
+         *
+         * @param spent called after each border or cluster rebuild, empty to rebuild everything
+         * @return true if nothing is left queued
+         * @author chris
+         */
+        bool syncDirty(const std::function<bool()>& spent);
+
+        /**
+         *
+         * @fn adoptBuild
+         * @brief Takes the clusters and nodes of a finished background build
+         *
+         * @author chris
+         */
+        void adoptBuild();
+
+        /** The grid the graph is built on */
+        Ref<AStarGrid> m_Grid;
+        /** Number of cells along a cluster side */
+        int m_ClusterSize = 16;
+        /** Number of clusters along x */
+        int m_ClustersX = 0;
+        /** Number of clusters along y */
+        int m_ClustersY = 0;
+        /** Every cluster, row major */
+        std::vector<Cluster> m_Clusters;
+        /** Transitions between each cluster and the cluster to its east */
+        std::vector<std::vector<Transition>> m_EastBorders;
+        /** Transitions between each cluster and the cluster to its north */
+        std::vector<std::vector<Transition>> m_NorthBorders;
+        /** Abstract node slots, freed slots are reused */
+        std::vector<AbstractNode> m_Nodes;
+        /** Freed node slots */
+        std::vector<int> m_FreeNodes;
+        /** The node of each entrance cell */
+        std::unordered_map<int, int> m_CellNodes;
+        /** If the graph has been built */
+        bool m_Built = false;
+        /** The grid version the graph is in sync with */
+        uint64_t m_SyncedVersion = 0;
+        /** The occupancy the graph is in sync with, one bit per cell */
+        std::vector<uint64_t> m_Cells;
+        /** Borders waiting to be rebuilt, twice the cluster index plus one for the north border */
+        std::vector<int> m_DirtyBorders;
+        /** Clusters waiting for new intra costs */
+        std::vector<int> m_DirtyClusters;
+        /** The graph the background build fills in, only touched here once the build is done */
+        Ref<HPAStarGraph> m_Pending;
+        /** The background build, if one is running or waiting to be picked up */
+        JobCounter m_PendingBuild;
+        /** If a background build has been started and not picked up yet */
+        bool m_Building = false;
+        /** The grid version the background build copied */
+        uint64_t m_PendingVersion = 0;
+        /** Cluster costs in half steps from the last searchCluster */
+        std::vector<int> m_LocalCosts;
+        /** Ring of cost buckets used by searchCluster, one more than the largest move cost */
+        std::array<std::vector<int>, 4> m_LocalBuckets;
+        /** Scratch list of transitions used by rebuildBorder */
+        std::vector<Transition> m_BorderScratch;
+        /** Links from the query start into its cluster */
+        std::vector<Edge> m_StartLinks;
+        /** Links from the query goal into its cluster */
+        std::vector<Edge> m_GoalLinks;
+        /** Scratch memory of the abstract search */
+        AStarSearchContext m_AbstractContext;
+        /** Scratch memory of segment refinement */
+        AStarSearchContext m_RefineContext;
+
+        /** Entrances at least this wide get a transition at both ends instead of one in the middle */
+        static constexpr int s_WideEntrance = 6;
+        /** Automatic cluster sizes aim for this many clusters along the longest side */
+        static constexpr int s_ClustersPerSide = 64;
+        /** Scales the heuristic of the abstract search, routes may cost this much more than the best one but the
+         * search no longer expands every node whose estimate ties with the best route */
+        static constexpr float s_HeuristicWeight = 1.02f;
+    };
+}
@@ -0,0 +1,245 @@
+﻿#include "tnahpch.h"
+#include "LatentScheduler.h"
+
+namespace tnah
+{
+    void Behaviour::promise_type::unhandled_exception()
+    {
+        // The behaviour goes on to its final suspend and is cleaned up like one that returned
+        TNAH_CORE_ERROR("A behaviour threw and was stopped");
+    }
+
+    void SecondsAwaiter::await_suspend(Behaviour::Handle handle) const
+    {
+        handle.promise().Scheduler->waitSeconds(handle, Duration);
+    }
+
+    void UntilAwaiter::await_suspend(Behaviour::Handle handle)
+    {
+        handle.promise().Scheduler->waitUntil(handle, std::move(Predicate));
+    }
+
+    void EventAwaiter::await_suspend(Behaviour::Handle handle) const
+    {
+        handle.promise().Scheduler->waitEvent(handle, Event);
+    }
+
+    void MoveAwaiter::await_suspend(Behaviour::Handle handle)
+    {
+        Promise = &handle.promise();
+        Promise->Scheduler->waitMove(handle, Target, Tolerance);
+    }
+
+    LatentScheduler::~LatentScheduler()
+    {
+        for(auto& task : m_Tasks)
+        {
+            if(task.Handle)
+                task.Handle.destroy();
+        }
+    }
+
+    void LatentScheduler::Start(Behaviour behaviour, uint32_t owner)
+    {
+        auto handle = behaviour.Release();
+        if(!handle)
+            return;
+
+        uint32_t task;
+        if(!m_FreeTasks.empty())
+        {
+            task = m_FreeTasks.back();
+            m_FreeTasks.pop_back();
+        }
+        else
+        {
+            task = static_cast<uint32_t>(m_Tasks.size());
+            m_Tasks.emplace_back();
+        }
+
+        m_Tasks[task].Handle = handle;
+        m_Tasks[task].Owner = owner;
+        m_Running[owner]++;
+
+        auto& promise = handle.promise();
+        promise.Scheduler = this;
+        promise.Owner = owner;
+        promise.Task = task;
+        resume({ task, m_Tasks[task].Generation });
+    }
+
+    void LatentScheduler::Stop(uint32_t owner)
+    {
+        if(m_Running.find(owner) == m_Running.end())
+            return;
+
+        for(uint32_t task = 0; task < m_Tasks.size(); task++)
+        {
+            if(m_Tasks[task].Handle && m_Tasks[task].Owner == owner)
+                finish(task);
+        }
+        m_Moves.erase(owner);
+    }
+
+    bool LatentScheduler::IsRunning(uint32_t owner) const
+    {
+        return m_Running.find(owner) != m_Running.end();
+    }
+
+    void LatentScheduler::Update(float deltaTime)
+    {
+        if(!m_Interrupted.empty())
+        {
+            auto interrupted = std::move(m_Interrupted);
+            m_Interrupted.clear();
+            for(const auto& wait : interrupted)
+                resume(wait, false);
+        }
+
+        // Waits made while resuming end no sooner than the next tick, so the tick moves before any slot is looked at
+        m_Time += deltaTime;
+        const uint64_t target = static_cast<uint64_t>(m_Time / s_TickLength);
+        if(target > m_Tick)
+        {
+            // Going round the wheel once is enough however many ticks passed
+            const uint64_t passed = std::min<uint64_t>(target - m_Tick, s_WheelSlots);
+            m_Tick = target;
+            for(uint64_t tick = target - passed + 1; tick <= target; tick++)
+            {
+                auto& slot = m_Wheel[tick % s_WheelSlots];
+                if(slot.empty())
+                    continue;
+
+                m_DueTimers.clear();
+                m_DueTimers.swap(slot);
+                for(const auto& timer : m_DueTimers)
+                {
+                    if(timer.Deadline <= target)
+                        resume(timer.Waiting);
+                    else if(isLive(timer.Waiting))
+                        slot.push_back(timer);
+                }
+            }
+        }
+
+        if(!m_Predicates.empty())
+        {
+            m_CheckedPredicates.clear();
+            m_CheckedPredicates.swap(m_Predicates);
+            for(auto& [wait, predicate] : m_CheckedPredicates)
+            {
+                if(!isLive(wait))
+                    continue;
+                if(predicate())
+                    resume(wait);
+                else
+                    m_Predicates.emplace_back(wait, std::move(predicate));
+            }
+        }
+    }
+
+    void LatentScheduler::Signal(uint32_t event)
+    {
+        auto it = m_Events.find(event);
+        if(it == m_Events.end())
+            return;
+
+        auto waiting = std::move(it->second);
+        m_Events.erase(it);
+        for(const auto& wait : waiting)
+            resume(wait);
+    }
+
+    bool LatentScheduler::TakeNewMove(uint32_t owner, glm::vec3& target)
+    {
+        auto it = m_Moves.find(owner);
+        if(it == m_Moves.end() || it->second.Taken)
+            return false;
+
+        it->second.Taken = true;
+        target = it->second.Target;
+        return true;
+    }
+
+    void LatentScheduler::ReportPosition(uint32_t owner, const glm::vec3& position)
+    {
+        auto it = m_Moves.find(owner);
+        if(it == m_Moves.end())
+            return;
+
+        const glm::vec2 offset(it->second.Target.x - position.x, it->second.Target.z - position.z);
+        if(glm::length(offset) > it->second.Tolerance)
+            return;
+
+        const Wait wait = it->second.Waiting;
+        m_Moves.erase(it);
+        resume(wait);
+    }
+
+    LatentScheduler::Wait LatentScheduler::waitOf(Behaviour::Handle handle) const
+    {
+        const uint32_t task = handle.promise().Task;
+        return { task, m_Tasks[task].Generation };
+    }
+
+    bool LatentScheduler::isLive(const Wait& wait) const
+    {
+        return wait.Task < m_Tasks.size() && m_Tasks[wait.Task].Handle && m_Tasks[wait.Task].Generation == wait.Generation;
+    }
+
+    void LatentScheduler::resume(const Wait& wait, bool completed)
+    {
+        if(!isLive(wait))
+            return;
+
+        auto handle = m_Tasks[wait.Task].Handle;
+        handle.promise().Completed = completed;
+        handle.resume();
+        if(handle.done())
+            finish(wait.Task);
+    }
+
+    void LatentScheduler::finish(uint32_t task)
+    {
+        auto& entry = m_Tasks[task];
+        const uint32_t owner = entry.Owner;
+        entry.Handle.destroy();
+        entry.Handle = nullptr;
+        entry.Generation++;
+        m_FreeTasks.push_back(task);
+
+        auto running = m_Running.find(owner);
+        if(running != m_Running.end() && --running->second == 0)
+        {
+            m_Running.erase(running);
+            m_Moves.erase(owner);
+        }
+    }
+
+    void LatentScheduler::waitSeconds(Behaviour::Handle handle, float duration)
+    {
+        const uint64_t ticks = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(duration / s_TickLength)));
+        const uint64_t deadline = m_Tick + ticks;
+        m_Wheel[deadline % s_WheelSlots].push_back({ waitOf(handle), deadline });
+    }
+
+    void LatentScheduler::waitUntil(Behaviour::Handle handle, std::function<bool()> predicate)
+    {
+        m_Predicates.emplace_back(waitOf(handle), std::move(predicate));
+    }
+
+    void LatentScheduler::waitEvent(Behaviour::Handle handle, uint32_t event)
+    {
+        m_Events[event].push_back(waitOf(handle));
+    }
+
+    void LatentScheduler::waitMove(Behaviour::Handle handle, const glm::vec3& target, float tolerance)
+    {
+        const uint32_t owner = handle.promise().Owner;
+        auto it = m_Moves.find(owner);
+        if(it != m_Moves.end())
+            m_Interrupted.push_back(it->second.Waiting);
+
+        m_Moves[owner] = { waitOf(handle), target, tolerance, false };
+    }
+}
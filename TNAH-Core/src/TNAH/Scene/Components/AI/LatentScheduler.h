@@ -0,0 +1,384 @@
+﻿/*****************************************************************//**
+ * @file   LatentScheduler.h
+ * @brief  Coroutine behaviours for characters and the scheduler that resumes them when what they wait on happens
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include <coroutine>
+#include <utility>
+
+namespace tnah
+{
+    class LatentScheduler;
+
+    /**
+     * @class Behaviour
+     * @brief A coroutine that drives a character. It starts suspended and only runs once handed to a LatentScheduler,
+     * after that it is resumed by the scheduler whenever what it awaits is done. Owns the coroutine and destroys it if
+     * it is never started.
+     *
+     * @author chris
+     */
+    class Behaviour
+    {
+    public:
+        struct promise_type
+        {
+            /** Scheduler the behaviour runs on */
+            LatentScheduler* Scheduler = nullptr;
+            /** Id of whatever owns the behaviour */
+            uint32_t Owner = 0;
+            /** Slot of the behaviour in the scheduler */
+            uint32_t Task = 0;
+            /** Set by the scheduler before a resume, false when a wait was cut short */
+            bool Completed = true;
+
+            Behaviour get_return_object() { return Behaviour(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception();
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Behaviour() = default;
+        Behaviour(const Behaviour&) = delete;
+        Behaviour& operator=(const Behaviour&) = delete;
+        Behaviour(Behaviour&& other) noexcept : m_Handle(std::exchange(other.m_Handle, nullptr)) {}
+        Behaviour& operator=(Behaviour&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(m_Handle)
+                    m_Handle.destroy();
+                m_Handle = std::exchange(other.m_Handle, nullptr);
+            }
+            return *this;
+        }
+        ~Behaviour()
+        {
+            if(m_Handle)
+                m_Handle.destroy();
+        }
+
+        /**
+         *
+         * @fn operator bool
+         * @brief Checks there is a coroutine, a default constructed behaviour has none
+         *
+         * @author chris
+         */
+        explicit operator bool() const { return static_cast<bool>(m_Handle); }
+
+        /**
+         *
+         * @fn Release
+         * @brief Hands the coroutine over to the caller
+         *
+         * @return Handle
+         * @author chris
+         */
+        Handle Release() { return std::exchange(m_Handle, nullptr); }
+
+    private:
+        explicit Behaviour(Handle handle) : m_Handle(handle) {}
+
+        Handle m_Handle = nullptr;
+    };
+
+    /**
+     * @struct SecondsAwaiter
+     * @brief co_await Seconds(2.0f) resumes once the time has passed
+     *
+     * @author chris
+     */
+    struct SecondsAwaiter
+    {
+        float Duration = 0.0f;
+
+        bool await_ready() const { return Duration <= 0.0f; }
+        void await_suspend(Behaviour::Handle handle) const;
+        void await_resume() const {}
+    };
+
+    /**
+     * @struct UntilAwaiter
+     * @brief co_await Until(predicate) resumes once the predicate is true, checked every scheduler update
+     *
+     * @author chris
+     */
+    struct UntilAwaiter
+    {
+        std::function<bool()> Predicate;
+
+        bool await_ready() const { return Predicate(); }
+        void await_suspend(Behaviour::Handle handle);
+        void await_resume() const {}
+    };
+
+    /**
+     * @struct EventAwaiter
+     * @brief co_await WaitFor(event) resumes when the event is signalled on the scheduler
+     *
+     * @author chris
+     */
+    struct EventAwaiter
+    {
+        uint32_t Event = 0;
+
+        bool await_ready() const { return false; }
+        void await_suspend(Behaviour::Handle handle) const;
+        void await_resume() const {}
+    };
+
+    /**
+     * @struct MoveAwaiter
+     * @brief co_await MoveTo(position) sends the owner to the position and resumes when it gets there. Returns false
+     * if another move of the same owner replaced it first.
+     *
+     * @author chris
+     */
+    struct MoveAwaiter
+    {
+        glm::vec3 Target = glm::vec3(0.0f);
+        float Tolerance = 1.0f;
+        Behaviour::promise_type* Promise = nullptr;
+
+        bool await_ready() const { return false; }
+        void await_suspend(Behaviour::Handle handle);
+        bool await_resume() const { return Promise->Completed; }
+    };
+
+    inline SecondsAwaiter Seconds(float duration) { return { duration }; }
+    inline UntilAwaiter Until(std::function<bool()> predicate) { return { std::move(predicate) }; }
+    inline EventAwaiter WaitFor(uint32_t event) { return { event }; }
+    inline MoveAwaiter MoveTo(const glm::vec3& target, float tolerance = 1.0f) { return { target, tolerance }; }
+
+    /**
+     * @class LatentScheduler
+     * @brief Runs the behaviours of a scene. Nothing is polled for a behaviour that waits on time, an event or a move,
+     * so an idle character costs nothing until it is due. Timed waits sit in a hashed timer wheel of fixed ticks and
+     * only the slots of the ticks that passed are looked at, events resume exactly the behaviours waiting on them and
+     * moves are resolved when the scene reports where their owner got to. Only Until predicates are checked every
+     * update.
+     *
+     * @author chris
+     */
+    class LatentScheduler : public RefCounted
+    {
+    public:
+        LatentScheduler() = default;
+        ~LatentScheduler();
+
+        /**
+         *
+         * @fn Start
+         * @brief Starts a behaviour, it runs to its first wait straight away
+         *
+         * @param behaviour
+         * @param owner id of whatever the behaviour drives
+         * @author chris
+         */
+        void Start(Behaviour behaviour, uint32_t owner);
+
+        /**
+         *
+         * @fn Stop
+         * @brief Destroys every behaviour of an owner
+         *
+         * @param owner
+         * @author chris
+         */
+        void Stop(uint32_t owner);
+
+        /**
+         *
+         * @fn IsRunning
+         * @brief Checks if an owner has a behaviour that has not finished
+         *
+         * @param owner
+         * @return bool
+         * @author chris
+         */
+        bool IsRunning(uint32_t owner) const;
+
+        /**
+         *
+         * @fn Update
+         * @brief Resumes the behaviours whose time is up or whose predicate holds
+         *
+         * @param deltaTime
+         * @author chris
+         */
+        void Update(float deltaTime);
+
+        /**
+         *
+         * @fn Signal
+         * @brief Resumes every behaviour waiting on an event
+         *
+         * @param event
+         * @author chris
+         */
+        void Signal(uint32_t event);
+
+        /**
+         *
+         * @fn TakeNewMove
+         * @brief Gets a move an owner started since the last call, the scene sets it off on a path
+         *
+         * @param owner
+         * @param target set to where the owner is going
+         * @return true if there is a new move
+         * @author chris
+         */
+        bool TakeNewMove(uint32_t owner, glm::vec3& target);
+
+        /**
+         *
+         * @fn IsMoving
+         * @brief Checks if an owner has a move that has not arrived
+         *
+         * @param owner
+         * @return bool
+         * @author chris
+         */
+        bool IsMoving(uint32_t owner) const { return m_Moves.find(owner) != m_Moves.end(); }
+
+        /**
+         *
+         * @fn ReportPosition
+         * @brief Tells the scheduler where a moving owner is, resumes its move once it is close enough on the ground
+         *
+         * @param owner
+         * @param position
+         * @author chris
+         */
+        void ReportPosition(uint32_t owner, const glm::vec3& position);
+
+        /**
+         *
+         * @fn GetTaskCount
+         * @brief Gets the number of behaviours running
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetTaskCount() const { return m_Tasks.size() - m_FreeTasks.size(); }
+
+    private:
+        /** A behaviour waiting, stale once the task finishes or is stopped */
+        struct Wait
+        {
+            uint32_t Task = 0;
+            uint32_t Generation = 0;
+        };
+
+        struct Task
+        {
+            Behaviour::Handle Handle = nullptr;
+            uint32_t Owner = 0;
+            uint32_t Generation = 0;
+        };
+
+        struct Timer
+        {
+            Wait Waiting;
+            uint64_t Deadline = 0;
+        };
+
+        struct Move
+        {
+            Wait Waiting;
+            glm::vec3 Target = glm::vec3(0.0f);
+            float Tolerance = 1.0f;
+            bool Taken = false;
+        };
+
+        friend struct SecondsAwaiter;
+        friend struct UntilAwaiter;
+        friend struct EventAwaiter;
+        friend struct MoveAwaiter;
+
+        /**
+         *
+         * @fn waitOf
+         * @brief Gets the wait for the current run of a behaviour
+         *
+         * @param handle
+         * @return Wait
+         * @author chris
+         */
+        Wait waitOf(Behaviour::Handle handle) const;
+
+        /**
+         *
+         * @fn isLive
+         * @brief Checks the behaviour of a wait is still the one that made it
+         *
+         * @param wait
+         * @return bool
+         * @author chris
+         */
+        bool isLive(const Wait& wait) const;
+
+        /**
+         *
+         * @fn resume
+         * @brief Resumes the behaviour of a wait if it is still live, cleaning it up if it finishes
+         *
+         * @param wait
+         * @param completed false if the wait was cut short
+         * @author chris
+         */
+        void resume(const Wait& wait, bool completed = true);
+
+        /**
+         *
+         * @fn finish
+         * @brief Destroys a behaviour and frees its slot
+         *
+         * @param task
+         * @author chris
+         */
+        void finish(uint32_t task);
+
+        void waitSeconds(Behaviour::Handle handle, float duration);
+        void waitUntil(Behaviour::Handle handle, std::function<bool()> predicate);
+        void waitEvent(Behaviour::Handle handle, uint32_t event);
+        void waitMove(Behaviour::Handle handle, const glm::vec3& target, float tolerance);
+
+        /** Length of a tick of the timer wheel, timed waits resume on the first tick after they end */
+        static constexpr float s_TickLength = 1.0f / 60.0f;
+        /** Slots in the timer wheel, longer waits go round more than once */
+        static constexpr size_t s_WheelSlots = 256;
+
+        /** Behaviours by slot */
+        std::vector<Task> m_Tasks;
+        /** Unused slots of m_Tasks */
+        std::vector<uint32_t> m_FreeTasks;
+        /** Timed waits, each in the slot of the tick it ends on */
+        std::array<std::vector<Timer>, s_WheelSlots> m_Wheel;
+        /** Timers of the slot being processed */
+        std::vector<Timer> m_DueTimers;
+        /** Time since the scheduler was created */
+        double m_Time = 0.0;
+        /** Last tick processed */
+        uint64_t m_Tick = 0;
+        /** Waits on a predicate */
+        std::vector<std::pair<Wait, std::function<bool()>>> m_Predicates;
+        /** Predicates being checked, kept to reuse its memory */
+        std::vector<std::pair<Wait, std::function<bool()>>> m_CheckedPredicates;
+        /** Waits on each event */
+        std::unordered_map<uint32_t, std::vector<Wait>> m_Events;
+        /** The move of each owner */
+        std::unordered_map<uint32_t, Move> m_Moves;
+        /** Number of unfinished behaviours of each owner */
+        std::unordered_map<uint32_t, uint32_t> m_Running;
+        /** Moves replaced by another, resumed as not completed on the next update */
+        std::vector<Wait> m_Interrupted;
+    };
+}
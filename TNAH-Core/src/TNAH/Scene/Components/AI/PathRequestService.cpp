@@ -0,0 +1,247 @@
+﻿#include "tnahpch.h"
+#include "PathRequestService.h"
+
+#include "TNAH/Core/Timer.h"
+
+namespace tnah
+{
+    PathRequestService::PathRequestService(const Ref<AStarGrid>& grid, const Ref<HPAStarGraph>& hierarchy)
+        : m_Grid(grid), m_Hierarchy(hierarchy)
+    {
+        m_CacheVersion = m_Grid ? m_Grid->GetVersion() : 0;
+    }
+
+    PathHandle PathRequestService::Request(Int2 start, Int2 destination)
+    {
+        const PathHandle handle = s_NextHandle++;
+        auto& request = m_Requests[handle];
+        request.Start = start;
+        request.Destination = destination;
+
+        syncCache();
+        if(!resolveFromCache(request))
+            m_Queue.push_back(handle);
+
+        return handle;
+    }
+
+    PathStatus PathRequestService::GetStatus(PathHandle handle) const
+    {
+        const auto it = m_Requests.find(handle);
+        if(it == m_Requests.end())
+            return PathStatus::Invalid;
+
+        return it->second.Status;
+    }
+
+    bool PathRequestService::TakePath(PathHandle handle, std::deque<Node>& path, HPARoute& route)
+    {
+        const auto it = m_Requests.find(handle);
+        if(it == m_Requests.end() || it->second.Status == PathStatus::Pending)
+            return false;
+
+        path = std::move(it->second.Path);
+        route = std::move(it->second.Route);
+        m_Requests.erase(it);
+        return true;
+    }
+
+    void PathRequestService::Cancel(PathHandle handle)
+    {
+        // The queue entry is skipped by Process once the request is gone
+        m_Requests.erase(handle);
+    }
+
+    void PathRequestService::Process()
+    {
+        if(!m_Grid)
+            return;
+
+        syncCache();
+        Timer timer;
+        uint32_t slices = 0;
+        const std::function<bool()> spent = [&]()
+        {
+            return m_SliceBudget ? ++slices >= m_SliceBudget : timer.ElapsedMillis() >= m_BudgetMilliseconds;
+        };
+        while(!m_Queue.empty())
+        {
+            const PathHandle handle = m_Queue.front();
+            const auto it = m_Requests.find(handle);
+            if(it == m_Requests.end() || it->second.Status != PathStatus::Pending)
+            {
+                if(handle == m_ActiveHandle)
+                    m_ActiveHandle = 0;
+                m_Queue.pop_front();
+                continue;
+            }
+
+            QueuedRequest& request = it->second;
+            if(handle != m_ActiveHandle)
+            {
+                // An identical request further up the queue may have been solved since this one was queued
+                if(resolveFromCache(request))
+                {
+                    m_Queue.pop_front();
+                    continue;
+                }
+
+                // Long queries run on the hierarchical graph, only the first segment is refined here
+                if(solveHierarchical(request, spent))
+                {
+                    m_Queue.pop_front();
+                    if(spent())
+                        break;
+                    continue;
+                }
+
+                if(m_Grid->BeginSearch(request.Start, request.Destination, m_Context) == AStarSearchStatus::Failed)
+                {
+                    finish(request, {}, true);
+                    m_Queue.pop_front();
+                    continue;
+                }
+
+                m_ActiveHandle = handle;
+                m_ActiveVersion = m_Grid->GetVersion();
+            }
+
+            const AStarSearchStatus status = m_Grid->ContinueSearch(m_Context, s_ExpansionsPerSlice);
+            if(status != AStarSearchStatus::Searching)
+            {
+                // A search that ran while obstacles moved is still handed out but not cached
+                const bool cacheable = m_ActiveVersion == m_Grid->GetVersion();
+                finish(request, status == AStarSearchStatus::Found ? m_Grid->GetSearchPath(m_Context) : std::deque<Node>(), cacheable);
+                m_ActiveHandle = 0;
+                m_Queue.pop_front();
+            }
+
+            if(spent())
+                break;
+        }
+    }
+
+    bool PathRequestService::solveHierarchical(QueuedRequest& request, const std::function<bool()>& spent)
+    {
+        if(!m_Hierarchy || !m_Hierarchy->IsLongRange(request.Start, request.Destination))
+            return false;
+
+        // Until the graph is built and synced long requests take the flat search, nothing here waits for it and
+        // catching up after changes only uses what is left of the budget
+        if(!m_Hierarchy->IsReady(spent))
+            return false;
+
+        // Without a route the flat search is used, it also covers the rare gaps between clusters the graph misses
+        if(!m_Hierarchy->FindRoute(request.Start, request.Destination, request.Route))
+            return false;
+
+        if(!m_Hierarchy->RefineNext(request.Route, request.Path))
+        {
+            request.Route = HPARoute();
+            return false;
+        }
+
+        request.Status = PathStatus::Ready;
+        return true;
+    }
+
+    bool PathRequestService::cacheKey(Int2 start, Int2 destination, uint64_t& key) const
+    {
+        if(!m_Grid->InBounds(start) || !m_Grid->InBounds(destination))
+            return false;
+
+        key = (static_cast<uint64_t>(m_Grid->ToIndex(start)) << 32) | static_cast<uint32_t>(m_Grid->ToIndex(destination));
+        return true;
+    }
+
+    void PathRequestService::ClearCache()
+    {
+        m_Cache.clear();
+        m_CellKeys.clear();
+        m_CellKeyCount = 0;
+        m_FailedKeys.clear();
+    }
+
+    void PathRequestService::syncCache()
+    {
+        if(!m_Grid || m_CacheVersion == m_Grid->GetVersion())
+            return;
+
+        m_Changes.clear();
+        if(!m_Grid->GetChangedCells(m_CacheVersion, m_Changes))
+        {
+            ClearCache();
+        }
+        else
+        {
+            bool cellFreed = false;
+            for(const auto& change : m_Changes)
+            {
+                if(!change.Used)
+                {
+                    cellFreed = true;
+                    continue;
+                }
+
+                const auto keys = m_CellKeys.find(change.Index);
+                if(keys == m_CellKeys.end())
+                    continue;
+
+                for(uint64_t key : keys->second)
+                    m_Cache.erase(key);
+                m_CellKeyCount -= keys->second.size();
+                m_CellKeys.erase(keys);
+            }
+
+            // A freed cell can only open up routes, so cached paths stay walkable and only failures are retried
+            if(cellFreed)
+            {
+                for(uint64_t key : m_FailedKeys)
+                    m_Cache.erase(key);
+                m_FailedKeys.clear();
+            }
+        }
+
+        m_CacheVersion = m_Grid->GetVersion();
+    }
+
+    bool PathRequestService::resolveFromCache(QueuedRequest& request) const
+    {
+        uint64_t key = 0;
+        if(!m_Grid || !cacheKey(request.Start, request.Destination, key))
+            return false;
+
+        const auto cached = m_Cache.find(key);
+        if(cached == m_Cache.end())
+            return false;
+
+        request.Path = cached->second;
+        request.Status = request.Path.empty() ? PathStatus::Failed : PathStatus::Ready;
+        return true;
+    }
+
+    void PathRequestService::finish(QueuedRequest& request, std::deque<Node> path, bool cacheable)
+    {
+        uint64_t key = 0;
+        if(cacheable && cacheKey(request.Start, request.Destination, key))
+        {
+            if(m_Cache.size() >= s_MaxCacheEntries || m_CellKeyCount >= s_MaxCellKeys)
+                ClearCache();
+
+            if(path.empty())
+            {
+                m_FailedKeys.push_back(key);
+            }
+            else
+            {
+                for(const auto& node : path)
+                    m_CellKeys[m_Grid->ToIndex(node.position)].push_back(key);
+                m_CellKeyCount += path.size();
+            }
+            m_Cache[key] = path;
+        }
+
+        request.Status = path.empty() ? PathStatus::Failed : PathStatus::Ready;
+        request.Path = std::move(path);
+    }
+}
@@ -0,0 +1,288 @@
+﻿/*****************************************************************//**
+ * @file   PathRequestService.h
+ * @brief  Queues path requests and solves them a slice at a time under a per frame budget
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "AStar.h"
+#include "HPAStar.h"
+
+namespace tnah
+{
+    /** Handle to a queued path request, 0 is never a valid handle */
+    using PathHandle = uint64_t;
+
+    /**
+     * @enum PathStatus
+     * @brief The state of a queued path request
+     *
+     * @author chris
+     */
+    enum class PathStatus
+    {
+        Invalid, Pending, Ready, Failed
+    };
+
+    /**
+     * @class PathRequestService
+     * @brief Queues path requests for a grid and solves them in order under a time budget. A search that runs out of
+     * budget is resumed on the next call to Process. Results are cached by start and destination. When cells become used
+     * only the cached paths crossing them are dropped, when cells become free only the cached failures are dropped, so a
+     * cached path stays valid but may be longer than a fresh search would give. With a hierarchical graph long requests
+     * are answered with a route whose segments are refined as they are needed, those are not cached.
+     *
+     * @author chris
+     */
+    class PathRequestService : public RefCounted
+    {
+    public:
+        PathRequestService(const Ref<AStarGrid>& grid, const Ref<HPAStarGraph>& hierarchy = nullptr);
+        ~PathRequestService() = default;
+
+        /**
+         *
+         * @fn Request
+         * @brief Queues a path request, a cached path is ready straight away
+         *
+         * @param start
+         * @param destination
+         * @return PathHandle
+         * @author chris
+         */
+        PathHandle Request(Int2 start, Int2 destination);
+
+        /**
+         *
+         * @fn GetStatus
+         * @brief Gets the state of the request, Invalid if the handle is unknown or already taken
+         *
+         * @param handle
+         * @return PathStatus
+         * @author chris
+         */
+        PathStatus GetStatus(PathHandle handle) const;
+
+        /**
+         *
+         * @fn TakePath
+         * @brief Moves the path and the rest of a hierarchical route out of a finished request and releases the handle
+         *
+         * @param handle
+         * @param path the cells refined so far, empty if the request failed
+         * @param route the segments still to refine with HPAStarGraph::RefineNext, done if the path is complete
+         * @return true if the request was finished, false if it is still pending or unknown
+         * @author chris
+         */
+        bool TakePath(PathHandle handle, std::deque<Node>& path, HPARoute& route);
+
+        /**
+         *
+         * @fn Cancel
+         * @brief Drops the request, including a partly done search
+         *
+         * @param handle
+         * @author chris
+         */
+        void Cancel(PathHandle handle);
+
+        /**
+         *
+         * @fn Process
+         * @brief Works through the queue until it is empty or the budget is used up
+         *
+         * @author chris
+         */
+        void Process();
+
+        /**
+         *
+         * @fn ClearCache
+         * @brief Drops every cached path
+         *
+         * @author chris
+         */
+        void ClearCache();
+
+        /**
+         *
+         * @fn SetBudget
+         * @brief Sets the time Process may spend searching
+         *
+         * @param milliseconds
+         * @author chris
+         */
+        void SetBudget(float milliseconds) { m_BudgetMilliseconds = milliseconds; }
+
+        /**
+         *
+         * @fn GetBudget
+         * @brief Gets the time Process may spend searching
+         *
+         * @return float
+         * @author chris
+         */
+        float GetBudget() const { return m_BudgetMilliseconds; }
+
+        /**
+         *
+         * @fn SetSliceBudget
+         * @brief Caps Process at a number of search slices instead of a time, so a run does the same work however
+         * fast the machine is. 0 goes back to the time budget.
+         *
+         * @param slices
+         * @author chris
+         */
+        void SetSliceBudget(uint32_t slices) { m_SliceBudget = slices; }
+
+        /**
+         *
+         * @fn GetSliceBudget
+         * @brief Gets the most search slices Process runs, 0 if it runs on the time budget
+         *
+         * @return uint32_t
+         * @author chris
+         */
+        uint32_t GetSliceBudget() const { return m_SliceBudget; }
+
+        /**
+         *
+         * @fn GetPendingCount
+         * @brief Gets the number of requests still waiting on a search
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetPendingCount() const { return m_Queue.size(); }
+
+        /**
+         *
+         * @fn GetCacheSize
+         * @brief Gets the number of cached paths
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetCacheSize() const { return m_Cache.size(); }
+
+        /**
+         *
+         * @fn GetGrid
+         * @brief Gets the grid the requests are solved on
+         *
+         * @return
+         * @author chris
+         */
+        const Ref<AStarGrid>& GetGrid() const { return m_Grid; }
+
+    private:
+        /** A queued request and its result */
+        struct QueuedRequest
+        {
+            Int2 Start;
+            Int2 Destination;
+            PathStatus Status = PathStatus::Pending;
+            std::deque<Node> Path = {};
+            HPARoute Route = {};
+        };
+
+        /**
+         *
+         * @fn solveHierarchical
+         * @brief Answers a long request with a route on the hierarchical graph, catching the graph up with the grid
+         * first within the budget
+         *
+         * @param request
+         * @param spent checks the budget of the current Process, each border or cluster the graph rebuilds counts as a slice
+         * @return true if the request was finished
+         * @author chris
+         */
+        bool solveHierarchical(QueuedRequest& request, const std::function<bool()>& spent);
+
+        /**
+         *
+         * @fn cacheKey
+         * @brief Packs the start and destination cells into a cache key
+         *
+         * @param start
+         * @param destination
+         * @param key
+         * @return false if either point is outside the grid and can not be cached
+         * @author chris
+         */
+        bool cacheKey(Int2 start, Int2 destination, uint64_t& key) const;
+
+        /**
+         *
+         * @fn syncCache
+         * @brief Drops the cached results affected by the cells that changed since the cache was last synced
+         *
+         * @author chris
+         */
+        void syncCache();
+
+        /**
+         *
+         * @fn resolveFromCache
+         * @brief Finishes the request from the cache if the path is known
+         *
+         * @param request
+         * @return true if the request was finished
+         * @author chris
+         */
+        bool resolveFromCache(QueuedRequest& request) const;
+
+        /**
+         *
+         * @fn finish
+         * @brief Stores the result on the request and caches it if the grid did not change during the search
+         *
+         * @param request
+         * @param path
+         * @param cacheable
+         * @author chris
+         */
+        void finish(QueuedRequest& request, std::deque<Node> path, bool cacheable);
+
+        /** The grid searched */
+        Ref<AStarGrid> m_Grid;
+        /** The hierarchical graph of the grid, may be null */
+        Ref<HPAStarGraph> m_Hierarchy;
+        /** Scratch memory of the search in progress */
+        AStarSearchContext m_Context;
+        /** The request the context belongs to, 0 if no search is in progress */
+        PathHandle m_ActiveHandle = 0;
+        /** The grid version the search in progress started on */
+        uint64_t m_ActiveVersion = 0;
+        /** Requests waiting on a search, the search in progress is always at the front */
+        std::deque<PathHandle> m_Queue;
+        /** Every request that has not been taken or cancelled */
+        std::unordered_map<PathHandle, QueuedRequest> m_Requests;
+        /** Finished paths keyed by start and destination cell */
+        std::unordered_map<uint64_t, std::deque<Node>> m_Cache;
+        /** The cached keys whose path crosses each cell, may hold keys that were already dropped */
+        std::unordered_map<int, std::vector<uint64_t>> m_CellKeys;
+        /** Number of keys held in m_CellKeys */
+        size_t m_CellKeyCount = 0;
+        /** The cached keys that have no path */
+        std::vector<uint64_t> m_FailedKeys;
+        /** Scratch list of changed cells */
+        std::vector<AStarCellChange> m_Changes;
+        /** The grid version the cache is in sync with */
+        uint64_t m_CacheVersion = 0;
+        /** The next handle given out, shared by every service so a handle never outlives a replaced grid by mistake */
+        inline static PathHandle s_NextHandle = 1;
+        /** Time Process may spend searching */
+        float m_BudgetMilliseconds = 1.0f;
+        /** Search slices Process may run, 0 to use the time budget */
+        uint32_t m_SliceBudget = 0;
+
+        /** Cells expanded between checks of the budget */
+        static constexpr size_t s_ExpansionsPerSlice = 256;
+        /** The cache is dropped once it grows past this */
+        static constexpr size_t s_MaxCacheEntries = 4096;
+        /** The cache is dropped once its cell index grows past this */
+        static constexpr size_t s_MaxCellKeys = s_MaxCacheEntries * 128;
+    };
+}
@@ -0,0 +1,204 @@
+﻿#include "tnahpch.h"
+#include "Perception.h"
+#include "TNAH/Scene/Components/TerrainComponent.h"
+#include <limits>
+
+namespace tnah
+{
+    namespace
+    {
+        /** Smallest move on the ground that turns the view cone */
+        constexpr float s_MinMove = 0.01f;
+    }
+
+    const PerceivedEntity* PerceptionComponent::Find(uint32_t id) const
+    {
+        for(size_t i = 0; i < m_KnownCount; i++)
+        {
+            if(m_Known[i].Id == id)
+                return &m_Known[i];
+        }
+        return nullptr;
+    }
+
+    const PerceivedEntity* PerceptionComponent::FindNearest(PerceivedKind kind) const
+    {
+        // Sorted nearest first, so the first match is the nearest
+        for(size_t i = 0; i < m_KnownCount; i++)
+        {
+            if(m_Known[i].Kind == kind)
+                return &m_Known[i];
+        }
+        return nullptr;
+    }
+
+    void PerceptionSystem::Clear()
+    {
+        m_Ids.clear();
+        m_Positions.clear();
+        m_GroundPositions.clear();
+        m_Kinds.clear();
+        m_Loudness.clear();
+        m_MaxLoudness = 0.0f;
+    }
+
+    void PerceptionSystem::AddSource(uint32_t id, const glm::vec3& position, PerceivedKind kind, float loudness)
+    {
+        m_Ids.push_back(id);
+        m_Positions.push_back(position);
+        m_GroundPositions.emplace_back(position.x, position.z);
+        m_Kinds.push_back(kind);
+        m_Loudness.push_back(std::max(loudness, 0.0f));
+        m_MaxLoudness = std::max(m_MaxLoudness, loudness);
+    }
+
+    void PerceptionSystem::SetTerrain(Terrain* terrain, const glm::mat4& transform)
+    {
+        if(terrain == m_Terrain && transform == m_HeightTransform)
+            return;
+
+        std::vector<float> heights;
+        int side = 0;
+        if(terrain)
+        {
+            side = static_cast<int>(terrain->GetSize().x);
+            const auto vertices = terrain->GetVertexPositions();
+            if(side >= 2 && vertices.size() >= static_cast<size_t>(side) * side)
+            {
+                heights.resize(static_cast<size_t>(side) * side);
+                for(size_t i = 0; i < heights.size(); i++)
+                    heights[i] = vertices[i].y;
+            }
+            else
+            {
+                side = 0;
+            }
+        }
+
+        SetHeightfield(std::move(heights), side, transform);
+        m_Terrain = terrain;
+    }
+
+    void PerceptionSystem::SetHeightfield(std::vector<float> heights, int side, const glm::mat4& transform)
+    {
+        m_Terrain = nullptr;
+        m_Heights = std::move(heights);
+        m_HeightSide = m_Heights.size() >= static_cast<size_t>(side) * side ? side : 0;
+        m_HeightTransform = transform;
+        m_ToHeightLocal = glm::inverse(transform);
+    }
+
+    void PerceptionSystem::BeginUpdate(size_t agentCount, float sightRange, float hearingRange)
+    {
+        m_Frame++;
+        m_AgentCount = agentCount;
+        m_Cursor = agentCount ? m_NextCursor % agentCount : 0;
+        m_NextCursor = m_Cursor + std::min(m_Budget, agentCount);
+
+        // Cells as wide as the furthest anyone can sense keep every query to the surrounding cells
+        const float reach = std::max(sightRange, hearingRange * m_MaxLoudness);
+        m_Grid.Build(m_GroundPositions, std::max(reach, 1.0f), s_MaxGridSide);
+    }
+
+    bool PerceptionSystem::IsDue(size_t agent) const
+    {
+        if(m_AgentCount <= m_Budget)
+            return true;
+
+        // The turn wraps round the end of the agents
+        return (agent + m_AgentCount - m_Cursor) % m_AgentCount < m_Budget;
+    }
+
+    void PerceptionSystem::Perceive(PerceptionComponent& perception, uint32_t self, const glm::vec3& position)
+    {
+        const glm::vec2 ground(position.x, position.z);
+        if(perception.m_HasLastPosition)
+        {
+            const glm::vec2 moved = ground - glm::vec2(perception.m_LastPosition.x, perception.m_LastPosition.z);
+            const float length = glm::length(moved);
+            if(length > s_MinMove)
+                perception.m_Facing = moved / length;
+        }
+        perception.m_LastPosition = position;
+        perception.m_HasLastPosition = true;
+        perception.m_LastUpdate = m_Frame;
+
+        const float reach = std::max(perception.SightRange, perception.HearingRange * m_MaxLoudness);
+        const float halfCone = std::cos(glm::radians(perception.FieldOfView * 0.5f));
+        const glm::vec3 eye(0.0f, perception.EyeHeight, 0.0f);
+
+        m_Candidates.clear();
+        if(reach > 0.0f)
+        {
+            m_Grid.Query(ground - glm::vec2(reach), ground + glm::vec2(reach), [&](int source)
+            {
+                if(m_Ids[source] == self)
+                    return;
+
+                PerceivedEntity entity;
+                entity.Distance = glm::distance(position, m_Positions[source]);
+                entity.Heard = entity.Distance <= perception.HearingRange * m_Loudness[source];
+
+                // Cheapest first, the line of sight is only traced for what is in range and in the cone
+                if(entity.Distance <= perception.SightRange)
+                {
+                    const glm::vec2 toSource = m_GroundPositions[source] - ground;
+                    const float length = glm::length(toSource);
+                    if(length < s_MinMove || glm::dot(toSource, perception.m_Facing) >= halfCone * length)
+                        entity.Seen = HasLineOfSight(position + eye, m_Positions[source] + eye);
+                }
+
+                if(!entity.Seen && !entity.Heard)
+                    return;
+
+                entity.Id = m_Ids[source];
+                entity.Position = m_Positions[source];
+                entity.Kind = m_Kinds[source];
+                m_Candidates.push_back(entity);
+            });
+        }
+
+        const size_t count = std::min(m_Candidates.size(), PerceptionComponent::s_Capacity);
+        std::partial_sort(m_Candidates.begin(), m_Candidates.begin() + count, m_Candidates.end(),
+            [](const PerceivedEntity& a, const PerceivedEntity& b) { return a.Distance < b.Distance; });
+        std::copy(m_Candidates.begin(), m_Candidates.begin() + count, perception.m_Known.begin());
+        perception.m_KnownCount = static_cast<uint8_t>(count);
+    }
+
+    bool PerceptionSystem::HasLineOfSight(const glm::vec3& from, const glm::vec3& to) const
+    {
+        if(m_HeightSide < 2)
+            return true;
+
+        // The transform is affine so the line can be stepped in the terrain's space, about one sample per vertex
+        const glm::vec3 a = glm::vec3(m_ToHeightLocal * glm::vec4(from, 1.0f));
+        const glm::vec3 b = glm::vec3(m_ToHeightLocal * glm::vec4(to, 1.0f));
+        const int steps = static_cast<int>(std::ceil(std::max(std::abs(b.x - a.x), std::abs(b.z - a.z))));
+        for(int step = 1; step < steps; step++)
+        {
+            const glm::vec3 point = glm::mix(a, b, static_cast<float>(step) / steps);
+            const float height = heightAt(point.x, point.z);
+            if(!std::isnan(height) && height > point.y)
+                return false;
+        }
+        return true;
+    }
+
+    float PerceptionSystem::heightAt(float x, float z) const
+    {
+        const int side = m_HeightSide;
+        if(x < 0.0f || z < 0.0f || x > side - 1 || z > side - 1)
+            return std::numeric_limits<float>::quiet_NaN();
+
+        // Bilinear between the four vertices around the point, vertices are laid out z major
+        const int x0 = std::min(static_cast<int>(x), side - 2);
+        const int z0 = std::min(static_cast<int>(z), side - 2);
+        const float tx = x - x0;
+        const float tz = z - z0;
+        const float h00 = m_Heights[z0 * side + x0];
+        const float h10 = m_Heights[z0 * side + x0 + 1];
+        const float h01 = m_Heights[(z0 + 1) * side + x0];
+        const float h11 = m_Heights[(z0 + 1) * side + x0 + 1];
+        return glm::mix(glm::mix(h00, h10, tx), glm::mix(h01, h11, tx), tz);
+    }
+}
@@ -0,0 +1,335 @@
+﻿/*****************************************************************//**
+ * @file   Perception.h
+ * @brief  Amortized sight and hearing for agents, cached as a short list of known entities
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "UniformGrid.h"
+
+namespace tnah
+{
+    class Terrain;
+
+    /**
+     * @enum PerceivedKind
+     * @brief What sort of entity was perceived
+     *
+     * @author chris
+     */
+    enum class PerceivedKind : uint8_t
+    {
+        Agent, Player, Object
+    };
+
+    /**
+     * @struct PerceivedEntity
+     * @brief An entity an agent knows about, as of its last perception update
+     *
+     * @author chris
+     */
+    struct PerceivedEntity
+    {
+        /** Id the source was added with */
+        uint32_t Id = 0;
+        /** Where the entity was when perceived */
+        glm::vec3 Position = glm::vec3(0.0f);
+        /** Distance from the agent when perceived */
+        float Distance = 0.0f;
+        /** What sort of entity it is */
+        PerceivedKind Kind = PerceivedKind::Object;
+        /** Inside the view cone with nothing in the way */
+        bool Seen = false;
+        /** Inside the hearing range */
+        bool Heard = false;
+    };
+
+    /**
+     * @class PerceptionComponent
+     * @brief The senses of an agent and the entities it knows about. The list holds the closest entities the agent
+     * sees or hears, it is only rewritten when the PerceptionSystem gets round to the agent so it can be a few frames
+     * old. Decisions read from here rather than searching the scene.
+     *
+     * @author chris
+     */
+    class PerceptionComponent
+    {
+    public:
+        /** The most entities an agent keeps track of */
+        static constexpr size_t s_Capacity = 8;
+
+        /** How far the agent sees */
+        float SightRange = 20.0f;
+        /** Full angle of the view cone in degrees */
+        float FieldOfView = 120.0f;
+        /** How far the agent hears a source of loudness 1 */
+        float HearingRange = 8.0f;
+        /** Height of the eyes above the agent's position, sight lines start and end this high */
+        float EyeHeight = 1.5f;
+
+        /**
+         *
+         * @fn GetKnownCount
+         * @brief Gets the number of known entities
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetKnownCount() const { return m_KnownCount; }
+
+        /**
+         *
+         * @fn GetKnown
+         * @brief Gets a known entity, they are sorted nearest first
+         *
+         * @param index
+         * @return PerceivedEntity
+         * @author chris
+         */
+        const PerceivedEntity& GetKnown(size_t index) const { return m_Known[index]; }
+
+        /**
+         *
+         * @fn Find
+         * @brief Finds a known entity by id
+         *
+         * @param id
+         * @return the entity or nullptr if it is not known
+         * @author chris
+         */
+        const PerceivedEntity* Find(uint32_t id) const;
+
+        /**
+         *
+         * @fn FindNearest
+         * @brief Finds the nearest known entity of a kind
+         *
+         * @param kind
+         * @return the entity or nullptr if none is known
+         * @author chris
+         */
+        const PerceivedEntity* FindNearest(PerceivedKind kind) const;
+
+        /**
+         *
+         * @fn GetFacing
+         * @brief Gets the direction the view cone points, taken from the way the agent last moved
+         *
+         * @return glm::vec2 on the x and z axes
+         * @author chris
+         */
+        const glm::vec2& GetFacing() const { return m_Facing; }
+
+        /**
+         *
+         * @fn GetLastUpdate
+         * @brief Gets the frame the known entities were last updated
+         *
+         * @return uint64_t
+         * @author chris
+         */
+        uint64_t GetLastUpdate() const { return m_LastUpdate; }
+
+    private:
+        /** Known entities, nearest first */
+        std::array<PerceivedEntity, s_Capacity> m_Known = {};
+        /** Number of entries in m_Known in use */
+        uint8_t m_KnownCount = 0;
+        /** View direction on the x and z axes */
+        glm::vec2 m_Facing = glm::vec2(0.0f, -1.0f);
+        /** Position at the last update, the facing follows the movement since */
+        glm::vec3 m_LastPosition = glm::vec3(0.0f);
+        /** False until the first update */
+        bool m_HasLastPosition = false;
+        /** Frame of the last update */
+        uint64_t m_LastUpdate = 0;
+
+        friend class PerceptionSystem;
+    };
+
+    /**
+     * @class PerceptionSystem
+     * @brief Runs the perception of the agents a few at a time. Every frame the sources are added and sorted into a
+     * uniform grid, then only the next agents in turn, up to the budget, look through the cells their senses cover.
+     * Hearing is a radius scaled by the loudness of the source, sight is a cone along the agent's facing with a line
+     * of sight traced over a copy of the terrain heights.
+     *
+     * @author chris
+     */
+    class PerceptionSystem : public RefCounted
+    {
+    public:
+        PerceptionSystem() = default;
+        ~PerceptionSystem() = default;
+
+        /**
+         *
+         * @fn Clear
+         * @brief Removes every source and starts a new frame
+         *
+         * @author chris
+         */
+        void Clear();
+
+        /**
+         *
+         * @fn AddSource
+         * @brief Adds something that can be perceived
+         *
+         * @param id caller's id for the source, also used to keep an agent from perceiving itself
+         * @param position
+         * @param kind
+         * @param loudness scales the hearing range of whoever listens, 0 is silent
+         * @author chris
+         */
+        void AddSource(uint32_t id, const glm::vec3& position, PerceivedKind kind, float loudness = 1.0f);
+
+        /**
+         *
+         * @fn SetTerrain
+         * @brief Sets the terrain that blocks sight, the heights are only copied again when it or its transform change
+         *
+         * @param terrain may be null for none
+         * @param transform world transform of the terrain
+         * @author chris
+         */
+        void SetTerrain(Terrain* terrain, const glm::mat4& transform);
+
+        /**
+         *
+         * @fn SetHeightfield
+         * @brief Sets the heights that block sight directly
+         *
+         * @param heights side * side heights in the terrain's local space, z major
+         * @param side vertices along a side, one unit apart
+         * @param transform world transform of the heights
+         * @author chris
+         */
+        void SetHeightfield(std::vector<float> heights, int side, const glm::mat4& transform);
+
+        /**
+         *
+         * @fn SetBudget
+         * @brief Sets the most agents updated in one frame
+         *
+         * @param budget
+         * @author chris
+         */
+        void SetBudget(size_t budget) { m_Budget = std::max<size_t>(budget, 1); }
+
+        /**
+         *
+         * @fn GetBudget
+         * @brief Gets the most agents updated in one frame
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetBudget() const { return m_Budget; }
+
+        /**
+         *
+         * @fn BeginUpdate
+         * @brief Sorts the sources into the grid and picks the agents that update this frame
+         *
+         * @param agentCount number of agents that will be passed to IsDue
+         * @param sightRange largest sight range of the agents
+         * @param hearingRange largest hearing range of the agents
+         * @author chris
+         */
+        void BeginUpdate(size_t agentCount, float sightRange, float hearingRange);
+
+        /**
+         *
+         * @fn IsDue
+         * @brief Checks if an agent gets its turn this frame
+         *
+         * @param agent index of the agent in the order they are visited every frame
+         * @return bool
+         * @author chris
+         */
+        bool IsDue(size_t agent) const;
+
+        /**
+         *
+         * @fn Perceive
+         * @brief Rebuilds the known entities of one agent
+         *
+         * @param perception
+         * @param self id of the agent's own source, never perceived
+         * @param position
+         * @author chris
+         */
+        void Perceive(PerceptionComponent& perception, uint32_t self, const glm::vec3& position);
+
+        /**
+         *
+         * @fn HasLineOfSight
+         * @brief Checks the terrain does not rise above the line between two points
+         *
+         * @param from world position
+         * @param to world position
+         * @return bool
+         * @author chris
+         */
+        bool HasLineOfSight(const glm::vec3& from, const glm::vec3& to) const;
+
+    private:
+        /**
+         *
+         * @fn heightAt
+         * @brief Bilinear height of the terrain at a local point
+         *
+         * @param x
+         * @param z
+         * @return the height or NaN off the terrain
+         * @author chris
+         */
+        float heightAt(float x, float z) const;
+
+        /** Default number of agents updated in a frame */
+        static constexpr size_t s_DefaultBudget = 32;
+        /** Most cells along a side of the source grid */
+        static constexpr int s_MaxGridSide = 128;
+
+        /** Source ids */
+        std::vector<uint32_t> m_Ids;
+        /** Source positions */
+        std::vector<glm::vec3> m_Positions;
+        /** Source positions on the x and z axes, what the grid is built from */
+        std::vector<glm::vec2> m_GroundPositions;
+        /** Source kinds */
+        std::vector<PerceivedKind> m_Kinds;
+        /** Source loudness */
+        std::vector<float> m_Loudness;
+        /** Loudest source this frame, widens the hearing query */
+        float m_MaxLoudness = 0.0f;
+        /** Sources sorted on the x and z axes */
+        UniformGrid m_Grid;
+        /** Entities perceived by the agent being updated, before the closest are kept */
+        std::vector<PerceivedEntity> m_Candidates;
+
+        /** Terrain the heights were copied from */
+        Terrain* m_Terrain = nullptr;
+        /** Terrain heights in local space, z major */
+        std::vector<float> m_Heights;
+        /** Vertices along a side of the heights */
+        int m_HeightSide = 0;
+        /** World transform of the heights */
+        glm::mat4 m_HeightTransform = glm::mat4(1.0f);
+        /** Inverse of m_HeightTransform */
+        glm::mat4 m_ToHeightLocal = glm::mat4(1.0f);
+
+        /** Agents updated in a frame */
+        size_t m_Budget = s_DefaultBudget;
+        /** First agent updated this frame */
+        size_t m_Cursor = 0;
+        /** First agent updated next frame */
+        size_t m_NextCursor = 0;
+        /** Agents this frame */
+        size_t m_AgentCount = 0;
+        /** Frames started, stamped on the components that update */
+        uint64_t m_Frame = 0;
+    };
+}
@@ -0,0 +1,194 @@
+﻿/*****************************************************************//**
+ * @file   StaticStateMachine.h
+ * @brief  A state machine with its states known at compile time and stored inline
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace tnah
+{
+    /**
+     * @class StaticStateMachine
+     * @brief A state machine over a fixed list of state types, an alternative to StateMachine for hot per agent updates.
+     * The current state lives inline in a std::variant so there are no heap states, and calls are resolved by type
+     * instead of through virtual functions. A state is any type with an Execute(Owner&, args...) or
+     * Execute(Owner&, Machine&, args...), where args are whatever is passed to Update. Enter(Owner&) and Exit(Owner&)
+     * are optional. Changing to a type that is not in the list does not compile. The owner is passed to each call
+     * instead of being kept, so the machine can live inside a component the registry moves around. A change asked
+     * for while a state is executing is held until that state returns.
+     *
+     * @author chris
+     */
+    template<class Owner, class... States>
+    class StaticStateMachine
+    {
+        static_assert(sizeof...(States) > 0, "A state machine needs at least one state");
+
+    public:
+        using StateVariant = std::variant<States...>;
+
+        /**
+         *
+         * @fn Start
+         * @brief Enters the current state, for when the owner is ready. The machine starts in the first state.
+         *
+         * @param owner
+         * @author chris
+         */
+        void Start(Owner& owner)
+        {
+            std::visit([&owner](auto& state) { enter(state, owner); }, m_Current);
+        }
+
+        /**
+         *
+         * @fn Update
+         * @brief Executes the current state, then makes any change it asked for
+         *
+         * @param owner
+         * @param args passed on to Execute
+         * @author chris
+         */
+        template<class... Args>
+        void Update(Owner& owner, Args&&... args)
+        {
+            m_Executing = true;
+            std::visit([&](auto& state) { execute(state, owner, args...); }, m_Current);
+            m_Executing = false;
+
+            if(m_Next)
+            {
+                StateVariant next = std::move(*m_Next);
+                m_Next.reset();
+                swapTo(owner, std::move(next));
+            }
+        }
+
+        /**
+         *
+         * @fn ChangeState
+         * @brief Exits the current state and enters a new one built from the arguments
+         *
+         * @param owner
+         * @param args
+         * @author chris
+         */
+        template<class S, class... Args>
+        void ChangeState(Owner& owner, Args&&... args)
+        {
+            static_assert((std::is_same_v<S, States> || ...), "The state is not one of the machine's states");
+            if(m_Executing)
+                m_Next.emplace(std::in_place_type<S>, std::forward<Args>(args)...);
+            else
+                swapTo(owner, StateVariant(std::in_place_type<S>, std::forward<Args>(args)...));
+        }
+
+        /**
+         *
+         * @fn RevertToPreviousState
+         * @brief Goes back to the state before the last change, with the data it had
+         *
+         * @param owner
+         * @author chris
+         */
+        void RevertToPreviousState(Owner& owner)
+        {
+            if(!m_Previous)
+                return;
+
+            if(m_Executing)
+            {
+                m_Next = std::move(m_Previous);
+                m_Previous.reset();
+            }
+            else
+            {
+                StateVariant previous = std::move(*m_Previous);
+                swapTo(owner, std::move(previous));
+            }
+        }
+
+        /**
+         *
+         * @fn IsInState
+         * @brief Checks the type of the current state
+         *
+         * @return bool
+         * @author chris
+         */
+        template<class S>
+        bool IsInState() const
+        {
+            static_assert((std::is_same_v<S, States> || ...), "The state is not one of the machine's states");
+            return std::holds_alternative<S>(m_Current);
+        }
+
+        /**
+         *
+         * @fn GetState
+         * @brief Gets the data of the current state, which must be of the given type
+         *
+         * @return S&
+         * @author chris
+         */
+        template<class S>
+        S& GetState() { return std::get<S>(m_Current); }
+
+        /**
+         *
+         * @fn GetStateIndex
+         * @brief Gets the position of the current state's type in the list
+         *
+         * @return size_t
+         * @author chris
+         */
+        size_t GetStateIndex() const { return m_Current.index(); }
+
+    private:
+        template<class S>
+        static void enter(S& state, Owner& owner)
+        {
+            if constexpr(requires { state.Enter(owner); })
+                state.Enter(owner);
+        }
+
+        template<class S>
+        static void exit(S& state, Owner& owner)
+        {
+            if constexpr(requires { state.Exit(owner); })
+                state.Exit(owner);
+        }
+
+        template<class S, class... Args>
+        void execute(S& state, Owner& owner, Args&... args)
+        {
+            if constexpr(requires { state.Execute(owner, *this, args...); })
+                state.Execute(owner, *this, args...);
+            else
+                state.Execute(owner, args...);
+        }
+
+        void swapTo(Owner& owner, StateVariant&& next)
+        {
+            std::visit([&owner](auto& state) { exit(state, owner); }, m_Current);
+            m_Previous = std::move(m_Current);
+            m_Current = std::move(next);
+            std::visit([&owner](auto& state) { enter(state, owner); }, m_Current);
+        }
+
+        /** The current state */
+        StateVariant m_Current;
+        /** The state before the last change */
+        std::optional<StateVariant> m_Previous;
+        /** A change asked for while the current state was executing */
+        std::optional<StateVariant> m_Next;
+        /** If the current state is executing */
+        bool m_Executing = false;
+    };
+}
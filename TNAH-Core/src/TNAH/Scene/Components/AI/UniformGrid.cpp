@@ -0,0 +1,47 @@
+﻿#include "tnahpch.h"
+#include "UniformGrid.h"
+
+namespace tnah
+{
+    void UniformGrid::Build(const std::vector<glm::vec2>& points, float minCellSize, int maxSide)
+    {
+        if(points.empty())
+        {
+            m_Width = m_Height = 0;
+            return;
+        }
+
+        glm::vec2 max = points.front();
+        m_Min = points.front();
+        for(const auto& point : points)
+        {
+            m_Min = glm::min(m_Min, point);
+            max = glm::max(max, point);
+        }
+
+        const glm::vec2 extent = max - m_Min;
+        m_CellSize = std::max(minCellSize, std::max(extent.x, extent.y) / maxSide);
+        m_CellSize = std::max(m_CellSize, 0.00001f);
+        m_Width = static_cast<int>(extent.x / m_CellSize) + 1;
+        m_Height = static_cast<int>(extent.y / m_CellSize) + 1;
+
+        // Counting sort of the points by cell
+        const size_t cellCount = static_cast<size_t>(m_Width) * m_Height;
+        m_CellStart.assign(cellCount + 1, 0);
+        m_Points.resize(points.size());
+        for(const auto& point : points)
+        {
+            const auto cell = cellOf(point);
+            m_CellStart[cell.second * m_Width + cell.first + 1]++;
+        }
+        for(size_t cell = 0; cell < cellCount; cell++)
+            m_CellStart[cell + 1] += m_CellStart[cell];
+
+        std::vector<int> fill(m_CellStart.begin(), m_CellStart.end() - 1);
+        for(size_t i = 0; i < points.size(); i++)
+        {
+            const auto cell = cellOf(points[i]);
+            m_Points[fill[cell.second * m_Width + cell.first]++] = static_cast<int>(i);
+        }
+    }
+}
@@ -0,0 +1,104 @@
+﻿/*****************************************************************//**
+ * @file   UniformGrid.h
+ * @brief  A uniform grid over points on the x and z axes for neighbour queries
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+
+namespace tnah
+{
+    /**
+     * @class UniformGrid
+     * @brief Buckets a set of points into square cells with a counting sort, rebuilt whenever the points move. Queries
+     * visit every point in the cells a box covers, the caller does the exact test. Cells grow so a side never has more
+     * than the given number of cells, however spread out the points are.
+     *
+     * @author chris
+     */
+    class UniformGrid
+    {
+    public:
+        /**
+         *
+         * @fn Build
+         * @brief Sorts the points into cells
+         *
+         * @param points
+         * @param minCellSize the smallest side of a cell, a query box this wide covers at most 3x3 cells
+         * @param maxSide the most cells along a side
+         * @author chris
+         */
+        void Build(const std::vector<glm::vec2>& points, float minCellSize, int maxSide);
+
+        /**
+         *
+         * @fn Query
+         * @brief Visits the index of every point in the cells the box covers
+         *
+         * @param min
+         * @param max
+         * @param visit called with each point index
+         * @author chris
+         */
+        template<typename Visit>
+        void Query(const glm::vec2& min, const glm::vec2& max, Visit&& visit) const
+        {
+            if(m_Width == 0)
+                return;
+
+            const auto low = cellOf(min);
+            const auto high = cellOf(max);
+            for(int y = low.second; y <= high.second; y++)
+            {
+                for(int x = low.first; x <= high.first; x++)
+                {
+                    const int cell = y * m_Width + x;
+                    for(int i = m_CellStart[cell]; i < m_CellStart[cell + 1]; i++)
+                        visit(m_Points[i]);
+                }
+            }
+        }
+
+        /**
+         *
+         * @fn GetCellSize
+         * @brief Gets the side of a cell
+         *
+         * @return float
+         * @author chris
+         */
+        float GetCellSize() const { return m_CellSize; }
+
+    private:
+        /**
+         *
+         * @fn cellOf
+         * @brief Gets the cell of a position, clamped into the grid
+         *
+         * @param position
+         * @return cell x and y
+         * @author chris
+         */
+        std::pair<int, int> cellOf(const glm::vec2& position) const
+        {
+            const int x = static_cast<int>(std::floor((position.x - m_Min.x) / m_CellSize));
+            const int y = static_cast<int>(std::floor((position.y - m_Min.y) / m_CellSize));
+            return { std::clamp(x, 0, m_Width - 1), std::clamp(y, 0, m_Height - 1) };
+        }
+
+        /** Lower corner of the grid */
+        glm::vec2 m_Min = glm::vec2(0.0f);
+        /** Side of a cell */
+        float m_CellSize = 1.0f;
+        /** Cells along x */
+        int m_Width = 0;
+        /** Cells along y */
+        int m_Height = 0;
+        /** First entry of each cell in m_Points, one extra entry marks the end */
+        std::vector<int> m_CellStart;
+        /** Point indices sorted by cell */
+        std::vector<int> m_Points;
+    };
+}
@@ -0,0 +1,289 @@
+﻿#include "tnahpch.h"
+#include "WalkabilityBake.h"
+
+namespace tnah
+{
+    namespace
+    {
+        void mixHash(uint64_t& hash, const void* data, size_t size)
+        {
+            // FNV-1a
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for(size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+
+        template<typename T>
+        void mixHash(uint64_t& hash, const T& value)
+        {
+            mixHash(hash, &value, sizeof(T));
+        }
+
+        void setBit(std::vector<uint64_t>& bits, int index)
+        {
+            bits[index >> 6] |= 1ull << (index & 63);
+        }
+    }
+
+    std::vector<uint64_t> WalkabilityBake::Bake(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings)
+    {
+        std::vector<uint64_t> blocked((grid.GetCellCount() + 63) / 64, 0);
+        if(source.SceneTerrain)
+            bakeTerrain(grid, source, settings, blocked);
+
+        for(const auto& mesh : source.StaticMeshes)
+            bakeMesh(grid, mesh, blocked);
+
+        return blocked;
+    }
+
+    void WalkabilityBake::bakeTerrain(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings, std::vector<uint64_t>& blocked)
+    {
+        Terrain* terrain = source.SceneTerrain;
+        const int side = static_cast<int>(terrain->GetSize().x);
+        const auto vertices = terrain->GetVertexPositions();
+        if(side < 2 || vertices.size() < static_cast<size_t>(side) * side)
+            return;
+
+        const glm::mat4 toLocal = glm::inverse(source.TerrainTransform);
+        const Int2 size = grid.GetSize();
+        const Int2 origin = grid.GetStartingPos();
+
+        // World height at every cell centre, NaN where the terrain does not reach
+        std::vector<float> heights(grid.GetCellCount(), std::numeric_limits<float>::quiet_NaN());
+        for(int y = 0; y < size.y; y++)
+        {
+            for(int x = 0; x < size.x; x++)
+            {
+                const glm::vec4 local = toLocal * glm::vec4(origin.x + x, 0.0f, origin.y + y, 1.0f);
+                if(local.x < 0.0f || local.z < 0.0f || local.x > side - 1 || local.z > side - 1)
+                    continue;
+
+                // Bilinear between the four vertices around the point, vertices are laid out z major
+                const int x0 = std::min(static_cast<int>(local.x), side - 2);
+                const int z0 = std::min(static_cast<int>(local.z), side - 2);
+                const float tx = local.x - x0;
+                const float tz = local.z - z0;
+                const float h00 = vertices[z0 * side + x0].y;
+                const float h10 = vertices[z0 * side + x0 + 1].y;
+                const float h01 = vertices[(z0 + 1) * side + x0].y;
+                const float h11 = vertices[(z0 + 1) * side + x0 + 1].y;
+                const float height = glm::mix(glm::mix(h00, h10, tx), glm::mix(h01, h11, tx), tz);
+
+                heights[y * size.x + x] = (source.TerrainTransform * glm::vec4(local.x, height, local.z, 1.0f)).y;
+            }
+        }
+
+        const float maxGradient = std::tan(glm::radians(settings.MaxSlope));
+        for(int y = 0; y < size.y; y++)
+        {
+            for(int x = 0; x < size.x; x++)
+            {
+                const int index = y * size.x + x;
+                const float height = heights[index];
+                if(std::isnan(height))
+                    continue;
+
+                // The largest rise to a neighbour covers both the step and, divided by the distance, the slope
+                bool walkable = true;
+                for(int dy = -1; dy <= 1 && walkable; dy++)
+                {
+                    for(int dx = -1; dx <= 1; dx++)
+                    {
+                        const int nx = x + dx;
+                        const int ny = y + dy;
+                        if((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= size.x || ny >= size.y)
+                            continue;
+
+                        const float neighbour = heights[ny * size.x + nx];
+                        if(std::isnan(neighbour))
+                            continue;
+
+                        const float rise = std::abs(neighbour - height);
+                        const float run = (dx != 0 && dy != 0) ? 1.41421356f : 1.0f;
+                        if(rise > settings.MaxStep || rise / run > maxGradient)
+                        {
+                            walkable = false;
+                            break;
+                        }
+                    }
+                }
+
+                if(!walkable)
+                    setBit(blocked, index);
+            }
+        }
+    }
+
+    void WalkabilityBake::bakeMesh(const AStarGrid& grid, const WalkabilitySource::StaticMesh& mesh, std::vector<uint64_t>& blocked)
+    {
+        glm::vec3 localMin;
+        glm::vec3 localMax;
+        if(!meshBounds(mesh, localMin, localMax))
+            return;
+
+        // The world bounds of the eight transformed corners
+        glm::vec3 worldMin(std::numeric_limits<float>::max());
+        glm::vec3 worldMax(std::numeric_limits<float>::lowest());
+        for(int corner = 0; corner < 8; corner++)
+        {
+            const glm::vec3 point((corner & 1) ? localMax.x : localMin.x, (corner & 2) ? localMax.y : localMin.y, (corner & 4) ? localMax.z : localMin.z);
+            const glm::vec3 world = glm::vec3(mesh.Transform * glm::vec4(point, 1.0f));
+            worldMin = glm::min(worldMin, world);
+            worldMax = glm::max(worldMax, world);
+        }
+
+        // Agents round their position to a cell, so a cell spans half a unit either side of its centre
+        const Int2 origin = grid.GetStartingPos();
+        const Int2 size = grid.GetSize();
+        const int minX = std::max(static_cast<int>(std::ceil(worldMin.x - 0.5f)) - origin.x, 0);
+        const int maxX = std::min(static_cast<int>(std::floor(worldMax.x + 0.5f)) - origin.x, size.x - 1);
+        const int minY = std::max(static_cast<int>(std::ceil(worldMin.z - 0.5f)) - origin.y, 0);
+        const int maxY = std::min(static_cast<int>(std::floor(worldMax.z + 0.5f)) - origin.y, size.y - 1);
+        for(int y = minY; y <= maxY; y++)
+            for(int x = minX; x <= maxX; x++)
+                setBit(blocked, y * size.x + x);
+    }
+
+    bool WalkabilityBake::meshBounds(const WalkabilitySource::StaticMesh& mesh, glm::vec3& localMin, glm::vec3& localMax)
+    {
+        localMin = glm::vec3(std::numeric_limits<float>::max());
+        localMax = glm::vec3(std::numeric_limits<float>::lowest());
+        if(!mesh.MeshModel)
+            return false;
+
+        for(const auto& part : mesh.MeshModel->GetMeshes())
+        {
+            for(const auto& position : part.GetVertexPositions())
+            {
+                localMin = glm::min(localMin, position);
+                localMax = glm::max(localMax, position);
+            }
+        }
+        return localMin.x <= localMax.x;
+    }
+
+    uint64_t WalkabilityBake::Hash(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        mixHash(hash, s_FileVersion);
+        mixHash(hash, grid.GetStartingPos());
+        mixHash(hash, grid.GetSize());
+        mixHash(hash, settings.MaxSlope);
+        mixHash(hash, settings.MaxStep);
+
+        // The same heights and bounds the bake reads, so editing a heightmap or a model in place invalidates the cache
+        if(source.SceneTerrain)
+        {
+            mixHash(hash, source.TerrainTransform);
+            const int side = static_cast<int>(source.SceneTerrain->GetSize().x);
+            mixHash(hash, side);
+            const auto vertices = source.SceneTerrain->GetVertexPositions();
+            if(side >= 2 && vertices.size() >= static_cast<size_t>(side) * side)
+            {
+                for(size_t i = 0; i < static_cast<size_t>(side) * side; i++)
+                    mixHash(hash, vertices[i].y);
+            }
+        }
+
+        for(const auto& mesh : source.StaticMeshes)
+        {
+            mixHash(hash, mesh.Transform);
+            glm::vec3 localMin;
+            glm::vec3 localMax;
+            const bool bounded = meshBounds(mesh, localMin, localMax);
+            mixHash(hash, bounded);
+            if(bounded)
+            {
+                mixHash(hash, localMin);
+                mixHash(hash, localMax);
+            }
+        }
+
+        return hash;
+    }
+
+    bool WalkabilityBake::Save(const std::string& path, const AStarGrid& grid, uint64_t hash, const std::vector<uint64_t>& blocked)
+    {
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!out)
+        {
+            TNAH_CORE_WARN("Could not write walkability cache '{0}'", path);
+            return false;
+        }
+
+        const Int2 origin = grid.GetStartingPos();
+        const Int2 size = grid.GetSize();
+        const int32_t header[4] = { origin.x, origin.y, size.x, size.y };
+        const uint64_t words = blocked.size();
+        out.write(reinterpret_cast<const char*>(&s_Magic), sizeof(s_Magic));
+        out.write(reinterpret_cast<const char*>(&s_FileVersion), sizeof(s_FileVersion));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        out.write(reinterpret_cast<const char*>(&words), sizeof(words));
+        out.write(reinterpret_cast<const char*>(blocked.data()), static_cast<std::streamsize>(words * sizeof(uint64_t)));
+        return static_cast<bool>(out);
+    }
+
+    bool WalkabilityBake::Load(const std::string& path, const AStarGrid& grid, uint64_t hash, std::vector<uint64_t>& blocked)
+    {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if(!in)
+            return false;
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        int32_t header[4] = {};
+        uint64_t fileHash = 0;
+        uint64_t words = 0;
+        in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        in.read(reinterpret_cast<char*>(&version), sizeof(version));
+        in.read(reinterpret_cast<char*>(header), sizeof(header));
+        in.read(reinterpret_cast<char*>(&fileHash), sizeof(fileHash));
+        in.read(reinterpret_cast<char*>(&words), sizeof(words));
+
+        const Int2 origin = grid.GetStartingPos();
+        const Int2 size = grid.GetSize();
+        if(!in || magic != s_Magic || version != s_FileVersion || fileHash != hash
+            || header[0] != origin.x || header[1] != origin.y || header[2] != size.x || header[3] != size.y
+            || words != (grid.GetCellCount() + 63) / 64)
+        {
+            return false;
+        }
+
+        blocked.resize(words);
+        in.read(reinterpret_cast<char*>(blocked.data()), static_cast<std::streamsize>(words * sizeof(uint64_t)));
+        return static_cast<bool>(in);
+    }
+
+    bool WalkabilityBake::LoadOrBake(const std::string& path, AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings)
+    {
+        const uint64_t hash = Hash(grid, source, settings);
+        std::vector<uint64_t> blocked;
+        const bool cached = !path.empty() && Load(path, grid, hash, blocked);
+        if(!cached)
+        {
+            blocked = Bake(grid, source, settings);
+            if(!path.empty())
+                Save(path, grid, hash, blocked);
+        }
+
+        grid.BakeStaticCells(blocked);
+        return cached;
+    }
+
+    std::string WalkabilityBake::GetCachePath(const std::string& scenePath)
+    {
+        if(scenePath.empty())
+            return "";
+
+        // Only strip an extension from the file name, not from a dotted folder
+        const size_t slash = scenePath.find_last_of("\\/");
+        const size_t dot = scenePath.find_last_of('.');
+        const bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        return (hasExtension ? scenePath.substr(0, dot) : scenePath) + ".walk";
+    }
+}
@@ -0,0 +1,172 @@
+﻿/*****************************************************************//**
+ * @file   WalkabilityBake.h
+ * @brief  Bakes the cells of an AStarGrid blocked by terrain and static geometry, cached in a file next to the scene
+ * 
+ * @author chris
+ * @date   October 2026
+ *********************************************************************/
+#pragma once
+#include "AStar.h"
+#include "TNAH/Renderer/Mesh.h"
+#include "TNAH/Scene/Components/TerrainComponent.h"
+
+namespace tnah
+{
+    /**
+     * @struct WalkabilitySource
+     * @brief The parts of a scene the walkability is baked from
+     *
+     * @author chris
+     */
+    struct WalkabilitySource
+    {
+        /** A model that blocks every cell its bounds cover */
+        struct StaticMesh
+        {
+            Ref<Model> MeshModel;
+            glm::mat4 Transform = glm::mat4(1.0f);
+        };
+
+        /** The terrain, may be null */
+        Terrain* SceneTerrain = nullptr;
+        /** World transform of the terrain */
+        glm::mat4 TerrainTransform = glm::mat4(1.0f);
+        /** Static models */
+        std::vector<StaticMesh> StaticMeshes = {};
+    };
+
+    /**
+     * @class WalkabilityBake
+     * @brief Works out which cells of a grid are blocked by steep or stepped terrain and by the bounds of static models.
+     * The result is one bit per cell, saved with a hash of the sources so a scene that has not changed loads it straight
+     * back instead of baking again.
+     *
+     * @author chris
+     */
+    class WalkabilityBake
+    {
+    public:
+        /**
+         *
+         * @fn Bake
+         * @brief Bakes the blocked cells of the grid
+         *
+         * @param grid
+         * @param source
+         * @param settings
+         * @return one bit per cell in row major order, set if the cell is blocked
+         * @author chris
+         */
+        static std::vector<uint64_t> Bake(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings);
+
+        /**
+         *
+         * @fn Hash
+         * @brief Hashes everything a bake depends on, the terrain's vertex heights and the models' bounds included
+         *
+         * @param grid
+         * @param source
+         * @param settings
+         * @return uint64_t
+         * @author chris
+         */
+        static uint64_t Hash(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings);
+
+        /**
+         *
+         * @fn Save
+         * @brief Writes baked cells to a file
+         *
+         * @param path
+         * @param grid
+         * @param hash
+         * @param blocked
+         * @return false if the file could not be written
+         * @author chris
+         */
+        static bool Save(const std::string& path, const AStarGrid& grid, uint64_t hash, const std::vector<uint64_t>& blocked);
+
+        /**
+         *
+         * @fn Load
+         * @brief Reads baked cells from a file
+         *
+         * @param path
+         * @param grid
+         * @param hash
+         * @param blocked
+         * @return false if the file is missing or was baked for a different grid or different sources
+         * @author chris
+         */
+        static bool Load(const std::string& path, const AStarGrid& grid, uint64_t hash, std::vector<uint64_t>& blocked);
+
+        /**
+         *
+         * @fn LoadOrBake
+         * @brief Applies the cached cells to the grid, baking and saving them first if the cache is missing or stale
+         *
+         * @param path the cache file, empty to bake without caching
+         * @param grid
+         * @param source
+         * @param settings
+         * @return true if the cache was used
+         * @author chris
+         */
+        static bool LoadOrBake(const std::string& path, AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings = {});
+
+        /**
+         *
+         * @fn GetCachePath
+         * @brief Gets the cache file that goes with a scene file
+         *
+         * @param scenePath
+         * @return std::string
+         * @author chris
+         */
+        static std::string GetCachePath(const std::string& scenePath);
+
+    private:
+        /**
+         *
+         * @fn bakeTerrain
+         * @brief Blocks the cells where the terrain is too steep or steps too far
+         *
+         * @param grid
+         * @param source
+         * @param settings
+         * @param blocked
+         * @author chris
+         */
+        static void bakeTerrain(const AStarGrid& grid, const WalkabilitySource& source, const WalkabilitySettings& settings, std::vector<uint64_t>& blocked);
+
+        /**
+         *
+         * @fn bakeMesh
+         * @brief Blocks the cells covered by the world bounds of a model
+         *
+         * @param grid
+         * @param mesh
+         * @param blocked
+         * @author chris
+         */
+        static void bakeMesh(const AStarGrid& grid, const WalkabilitySource::StaticMesh& mesh, std::vector<uint64_t>& blocked);
+
+        /**
+         *
+         * @fn meshBounds
+         * @brief Gets the bounds of a model's vertices before its transform
+         *
+         * @param mesh
+         * @param localMin
+         * @param localMax
+         * @return false if there is no model or it has no vertices
+         * @author chris
+         */
+        static bool meshBounds(const WalkabilitySource::StaticMesh& mesh, glm::vec3& localMin, glm::vec3& localMax);
+
+        /** Identifies a walkability cache file */
+        static constexpr uint32_t s_Magic = 0x4B4C4157;
+        /** Bumped whenever the file layout or the bake itself changes */
+        static constexpr uint32_t s_FileVersion = 1;
+    };
+}
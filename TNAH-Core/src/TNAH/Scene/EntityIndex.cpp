@@ -0,0 +1,119 @@
+#include "tnahpch.h"
+#include "EntityIndex.h"
+
+#include "Components/Components.h"
+
+namespace tnah {
+
+	EntityIndex::EntityIndex(entt::registry& registry)
+		: m_Registry(registry)
+	{
+		m_Registry.on_construct<IDComponent>().connect<&EntityIndex::onIDConstruct>(this);
+		m_Registry.on_update<IDComponent>().connect<&EntityIndex::onIDUpdate>(this);
+		m_Registry.on_destroy<IDComponent>().connect<&EntityIndex::onIDDestroy>(this);
+		m_Registry.on_construct<TagComponent>().connect<&EntityIndex::onTagConstruct>(this);
+		m_Registry.on_update<TagComponent>().connect<&EntityIndex::onTagUpdate>(this);
+		m_Registry.on_destroy<TagComponent>().connect<&EntityIndex::onTagDestroy>(this);
+	}
+
+	EntityIndex::~EntityIndex()
+	{
+		m_Registry.on_construct<IDComponent>().disconnect(this);
+		m_Registry.on_update<IDComponent>().disconnect(this);
+		m_Registry.on_destroy<IDComponent>().disconnect(this);
+		m_Registry.on_construct<TagComponent>().disconnect(this);
+		m_Registry.on_update<TagComponent>().disconnect(this);
+		m_Registry.on_destroy<TagComponent>().disconnect(this);
+	}
+
+	entt::entity EntityIndex::FindByUUID(UUID id) const
+	{
+		auto found = m_EntitiesByUUID.find(id);
+		return found != m_EntitiesByUUID.end() ? found->second : entt::entity(entt::null);
+	}
+
+	entt::entity EntityIndex::FindByTag(const std::string& tag) const
+	{
+		auto found = m_EntitiesByTag.find(tag);
+		return found != m_EntitiesByTag.end() ? found->second.front() : entt::entity(entt::null);
+	}
+
+	const std::vector<entt::entity>& EntityIndex::GetEntitiesWithTag(const std::string& tag) const
+	{
+		static const std::vector<entt::entity> s_None;
+		auto found = m_EntitiesByTag.find(tag);
+		return found != m_EntitiesByTag.end() ? found->second : s_None;
+	}
+
+	void EntityIndex::onIDConstruct(entt::registry& registry, entt::entity entity)
+	{
+		const UUID id = registry.get<IDComponent>(entity).ID;
+		m_EntitiesByUUID[id] = entity;
+		m_IndexedUUIDs[entity] = id;
+	}
+
+	void EntityIndex::onIDUpdate(entt::registry& registry, entt::entity entity)
+	{
+		onIDDestroy(registry, entity);
+		onIDConstruct(registry, entity);
+	}
+
+	void EntityIndex::onIDDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto indexed = m_IndexedUUIDs.find(entity);
+		if(indexed == m_IndexedUUIDs.end())
+			return;
+
+		// Two entities can share a UUID while one is being reassigned, only drop the entry if it is still this one
+		auto owner = m_EntitiesByUUID.find(indexed->second);
+		if(owner != m_EntitiesByUUID.end() && owner->second == entity)
+			m_EntitiesByUUID.erase(owner);
+		m_IndexedUUIDs.erase(indexed);
+	}
+
+	void EntityIndex::onTagConstruct(entt::registry& registry, entt::entity entity)
+	{
+		addTag(entity, registry.get<TagComponent>(entity).Tag);
+	}
+
+	void EntityIndex::onTagUpdate(entt::registry& registry, entt::entity entity)
+	{
+		const std::string& tag = registry.get<TagComponent>(entity).Tag;
+		auto slot = m_TagSlots.find(entity);
+		if(slot != m_TagSlots.end() && slot->second.Tag->first == tag)
+			return;
+
+		removeTag(entity);
+		addTag(entity, tag);
+	}
+
+	void EntityIndex::onTagDestroy(entt::registry& registry, entt::entity entity)
+	{
+		removeTag(entity);
+	}
+
+	void EntityIndex::addTag(entt::entity entity, const std::string& tag)
+	{
+		auto& entry = *m_EntitiesByTag.try_emplace(tag).first;
+		m_TagSlots[entity] = { &entry, entry.second.size() };
+		entry.second.push_back(entity);
+	}
+
+	void EntityIndex::removeTag(entt::entity entity)
+	{
+		auto slot = m_TagSlots.find(entity);
+		if(slot == m_TagSlots.end())
+			return;
+
+		// Keep the rest in the order they were tagged, so FindByTag keeps giving the oldest
+		auto& entities = slot->second.Tag->second;
+		const size_t index = slot->second.Slot;
+		for(size_t later = index + 1; later < entities.size(); later++)
+			m_TagSlots[entities[later]].Slot = later - 1;
+		entities.erase(entities.begin() + index);
+
+		if(entities.empty())
+			m_EntitiesByTag.erase(m_EntitiesByTag.find(slot->second.Tag->first));
+		m_TagSlots.erase(slot);
+	}
+}
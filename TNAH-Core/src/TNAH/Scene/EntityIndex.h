@@ -0,0 +1,163 @@
+#pragma once
+#include "TNAH/Core/UUID.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma warning(push, 0)
+#include <entt/entt.hpp>
+#pragma warning(pop)
+
+namespace tnah {
+
+	/**
+	 * @class	EntityIndex
+	 *
+	 * @brief	Hashed lookups of the entities of a registry by UUID and by tag. The index listens to the construct,
+	 * 			update and destroy signals of the ID and tag components, so it keeps itself in step with anything
+	 * 			that emplaces, patches, replaces or removes them. Writing a field straight through a reference does
+	 * 			not raise a signal, use registry.patch for that.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class EntityIndex
+	{
+	public:
+
+		/**
+		 * @fn	EntityIndex::EntityIndex(entt::registry& registry);
+		 *
+		 * @brief	Constructor, connects to the signals of the registry
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	registry	The registry to index, must outlive the index.
+		 */
+
+		EntityIndex(entt::registry& registry);
+
+		/**
+		 * @fn	EntityIndex::~EntityIndex();
+		 *
+		 * @brief	Destructor, disconnects from the signals of the registry
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		~EntityIndex();
+
+		EntityIndex(const EntityIndex&) = delete;
+		EntityIndex& operator=(const EntityIndex&) = delete;
+
+		/**
+		 * @fn	entt::entity EntityIndex::FindByUUID(UUID id) const;
+		 *
+		 * @brief	Finds the entity with a UUID
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	id	The UUID.
+		 *
+		 * @returns	The entity, or entt::null if there is none.
+		 */
+
+		entt::entity FindByUUID(UUID id) const;
+
+		/**
+		 * @fn	entt::entity EntityIndex::FindByTag(const std::string& tag) const;
+		 *
+		 * @brief	Finds an entity with a tag
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	tag	The tag.
+		 *
+		 * @returns	The entity that has had the tag the longest, or entt::null if there is none.
+		 */
+
+		entt::entity FindByTag(const std::string& tag) const;
+
+		/**
+		 * @fn	const std::vector<entt::entity>& EntityIndex::GetEntitiesWithTag(const std::string& tag) const;
+		 *
+		 * @brief	Gets every entity with a tag, in the order they were given it
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	tag	The tag.
+		 *
+		 * @returns	The entities, empty if there are none.
+		 */
+
+		const std::vector<entt::entity>& GetEntitiesWithTag(const std::string& tag) const;
+
+	private:
+
+		/** @brief	The signal listeners, entt calls these with the entity whose component changed */
+		void onIDConstruct(entt::registry& registry, entt::entity entity);
+		void onIDUpdate(entt::registry& registry, entt::entity entity);
+		void onIDDestroy(entt::registry& registry, entt::entity entity);
+		void onTagConstruct(entt::registry& registry, entt::entity entity);
+		void onTagUpdate(entt::registry& registry, entt::entity entity);
+		void onTagDestroy(entt::registry& registry, entt::entity entity);
+
+		/**
+		 * @fn	void EntityIndex::addTag(entt::entity entity, const std::string& tag);
+		 *
+		 * @brief	Adds an entity under a tag, interning the tag if it is new
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	entity	The entity.
+		 * @param 	tag   	The tag.
+		 */
+
+		void addTag(entt::entity entity, const std::string& tag);
+
+		/**
+		 * @fn	void EntityIndex::removeTag(entt::entity entity);
+		 *
+		 * @brief	Removes an entity from the tag it was added under, dropping the tag once no entity has it
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	entity	The entity.
+		 */
+
+		void removeTag(entt::entity entity);
+
+		/** @brief	Where an entity sits in the tag index */
+		struct TagSlot
+		{
+			/** @brief	The entry of the tag, map nodes never move so this stays good until the tag is dropped */
+			std::pair<const std::string, std::vector<entt::entity>>* Tag;
+			/** @brief	The position of the entity in the tag's entities */
+			size_t Slot;
+		};
+
+		/** @brief	The registry being indexed */
+		entt::registry& m_Registry;
+
+		/** @brief	The entity of each UUID */
+		std::unordered_map<UUID, entt::entity> m_EntitiesByUUID;
+
+		/** @brief	The UUID each entity was indexed under, needed once the component holds the new one */
+		std::unordered_map<entt::entity, UUID> m_IndexedUUIDs;
+
+		/** @brief	Every tag in use, each held once, and the entities that have it in the order they were given it */
+		std::unordered_map<std::string, std::vector<entt::entity>> m_EntitiesByTag;
+
+		/** @brief	Where each tagged entity sits, so it can be removed without searching */
+		std::unordered_map<entt::entity, TagSlot> m_TagSlots;
+	};
+}
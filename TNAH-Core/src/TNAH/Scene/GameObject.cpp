@@ -7,8 +7,8 @@ namespace tnah {
 	{
 		if(HasComponent<TagComponent>())
 		{
-			auto& t = GetComponent<TagComponent>();
-			t.Tag = tag;
+			// Patched so the scene's tag index hears about the change
+			m_Scene->m_Registry.patch<TagComponent>(m_EntityID, [&tag](TagComponent& t) { t.Tag = tag; });
 		}
 		else
 		{
@@ -16,6 +16,28 @@ namespace tnah {
 		}
 	}
 
+	void GameObject::SetParentUUID(UUID parent)
+	{
+		GameObject parentObject = m_Scene->FindEntityByUUID(parent);
+		if(!m_Scene->m_Hierarchy.SetParent(m_EntityID, parentObject ? parentObject.GetID() : entt::entity(entt::null)))
+		{
+			TNAH_CORE_WARN("GameObject {0} can't be parented to {1}!", GetID(), (uint64_t)parent);
+			return;
+		}
+
+		auto& relationship = GetComponent<RelationshipComponent>();
+		const UUID self = GetUUID();
+		if(GameObject oldParent = m_Scene->FindEntityByUUID(relationship.ParentHandle))
+		{
+			auto& siblings = oldParent.Children();
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), self), siblings.end());
+		}
+
+		relationship.ParentHandle = parentObject ? parent : UUID(0);
+		if(parentObject)
+			parentObject.Children().push_back(self);
+	}
+
 	std::string GameObject::GetTag()
 	{
 		if(HasComponent<TagComponent>())
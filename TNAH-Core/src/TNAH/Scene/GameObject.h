@@ -293,15 +293,16 @@ namespace tnah {
 		/**
 		 * @fn	void GameObject::SetParentUUID(UUID parent)
 		 *
-		 * @brief	Sets parent uuid
+		 * @brief	Sets parent uuid, moving this object between the children of its old and new parent and in the
+		 * 			scene's transform hierarchy. A parent that is this object or one of its children is refused.
 		 *
 		 * @author	Bryce Standley
 		 * @date	7/09/2021
 		 *
-		 * @param 	parent	The parent.
+		 * @param 	parent	The parent, 0 for none.
 		 */
 
-		void SetParentUUID(UUID parent) { GetComponent<RelationshipComponent>().ParentHandle = parent; }
+		void SetParentUUID(UUID parent);
 
 		/**
 		 * @fn	UUID GameObject::GetParentUUID()
@@ -4,6 +4,7 @@
 #include "Components/Components.h"
 #include "TNAH/Core/Application.h"
 #include "TNAH/Core/Input.h"
+#include "TNAH/Core/Timer.h"
 #include "TNAH/Renderer/Renderer.h"
 #include "TNAH/Audio/Audio.h"
 #include "TNAH/Physics/PhysicsEvents.h"
@@ -13,6 +14,7 @@
 #include "Components/AI/AIComponent.h"
 #include "Components/AI/CharacterComponent.h"
 #include "Components/AI/PlayerInteractions.h"
+#include "Components/AI/WalkabilityBake.h"
 
 namespace tnah{
 
@@ -20,11 +22,14 @@ namespace tnah{
 	
 	Scene::ActiveScene Scene::s_ActiveScene = Scene::ActiveScene();
 
+	/** @brief	How many agents have to pick the same object before they follow one flow field to it */
+	static constexpr int s_SharedGoalAgents = 2;
+
 	struct SceneComponent
 	{
 		UUID SceneID;
 	};
-	
+
 	std::map<UUID, GameObject>& Scene::GetGameObjectsInScene()
 	{
 		return m_GameObjectsInScene;
@@ -39,6 +44,8 @@ namespace tnah{
 	{
 		m_SceneEntity = m_Registry.create();
 		m_Registry.emplace<SceneComponent>(m_SceneEntity, m_SceneID);
+		m_Registry.on_destroy<AStarObstacleComponent>().connect<&Scene::onObstacleDestroy>(this);
+		m_Registry.on_construct<EmotionComponent>().connect<&Scene::onEmotionConstruct>(this);
 		if(editor)
 		{
 			m_EditorCamera = CreateEditorCamera().GetUUID();
@@ -71,6 +78,8 @@ namespace tnah{
 
 	Scene::~Scene()
 	{
+		m_Registry.on_destroy<AStarObstacleComponent>().disconnect(this);
+		m_Registry.on_construct<EmotionComponent>().disconnect(this);
 		m_Registry.clear();
 		m_GameObjectsInScene.clear();
 		//s_ActiveScenes.erase(m_SceneID);
@@ -106,87 +115,40 @@ namespace tnah{
 	void Scene::OnUpdate(Timestep deltaTime)
 	{
 		
-#pragma region OnUpdates
-		
-		Physics::PhysicsEngine::OnUpdate(deltaTime);
+#pragma region Systems
 
-#pragma endregion OnUpdates
-		
-#pragma region PlayerControllerUpdate
-		//TODO: Actually test the player controller component
-		// Process any PlayerControllers before updating anything else in the scene
-		{
-			auto e = EditorComponent();
+		//Physics, audio, player controllers, transforms and A* obstacles run as systems, those that touch different
+		//components run at the same time
+		if(!m_Systems)
+			registerSystems();
+		m_Systems->Run(deltaTime);
 
-			Audio::OnUpdate();
-			
-			auto view = m_Registry.view<PlayerControllerComponent, TransformComponent>();
-			for(auto obj : view)
-			{
-				auto& editor = m_GameObjectsInScene[m_EditorCamera].GetComponent<EditorComponent>();
-				//Only run this update for a player controller if the editor isnt empty, were in play mode to test the scene
-				// or this scene isnt being ran in a editor ie in the runtime
-				if((editor.m_EditorMode == EditorComponent::EditorMode::Play) || (!m_IsEditorScene && this->FindGameObjectByID(obj).IsActive()))
-				{
-					auto& transform = view.get<TransformComponent>(obj);
-					auto& player = view.get<PlayerControllerComponent>(obj);
-					// Only continue if the component is active/enabled
-					if(player.IsActive())
-					{
-						if(!player.m_MouseDisabled) Application::Get().GetWindow().SetCursorDisabled(true); player.m_MouseDisabled = true;
-						float s = 0.0f;
-						// if were sprinting, use sprint speed else if were crouched use crouched speed else use the normal movement speed
-						auto speed = (player.IsSprinting()) ? player.SprintSpeed : (s = (player.IsCrouched()) ? player.CrouchSpeed : player.MovementSpeed);
-				
-						if(Input::IsKeyPressed(player.Forward)) transform.Position += transform.Forward * speed * deltaTime.GetSeconds();
-						if(Input::IsKeyPressed(player.Backward)) transform.Position -= transform.Forward * speed * deltaTime.GetSeconds();
-						if(Input::IsKeyPressed(player.Left)) transform.Position -= transform.Right * speed * deltaTime.GetSeconds();
-						if(Input::IsKeyPressed(player.Right)) transform.Position += transform.Right * speed * deltaTime.GetSeconds();
-						player.ProcessMouseRotation(transform);
-					}
-				}
-			}
-			
-		}
-#pragma endregion
+#pragma endregion Systems
 
-#pragma region TransformComponentUpdate
-		
-		//Update all transform components and their forward, right and up vectors
+#pragma region AIUpdate
+
+		//The AI steps once a frame however many passes are rendered, seen from the game camera or the editor camera
+		//when there is none
 		{
-			auto view = m_Registry.view<TransformComponent>();
-			for (auto obj : view)
+			glm::vec3 viewerPosition(0.0f);
+			glm::vec3 viewerForward = {0.0f, 0.0f, -1.0f};
+			auto cameras = m_Registry.view<TransformComponent, CameraComponent>();
+			if(cameras.begin() != cameras.end())
 			{
-				auto& transform = view.get<TransformComponent>(obj);
-
-				glm::vec3 forward = glm::vec3(0.0f);
-				glm::vec3 right = glm::vec3(0.0f);
-				glm::vec3 up = glm::vec3(0.0f);
-				forward.x = cos(glm::radians(transform.Rotation.x)) * cos(glm::radians(transform.Rotation.y));
-				forward.y = sin(glm::radians(transform.Rotation.y));
-				forward.z = sin(glm::radians(transform.Rotation.x)) * cos(glm::radians(transform.Rotation.y));
-				forward = glm::normalize(forward);
-				right = glm::normalize(glm::cross(forward, glm::vec3(0, 1, 0)));
-				up = glm::normalize(glm::cross(right, forward));
-				transform.Forward = forward;
-				transform.Right = right;
-				transform.Up = up;
+				auto& transform = cameras.get<TransformComponent>(*cameras.begin());
+				viewerPosition = transform.Position;
+				viewerForward = transform.Forward;
 			}
-		}
-
-		{
-			auto view = m_Registry.view<AStarObstacleComponent, TransformComponent>();
+			else if(m_IsEditorScene)
 			{
-				for(auto entity : view)
-				{
-					auto & star = view.get<AStarObstacleComponent>(entity);
-					auto& transform = view.get<TransformComponent>(entity);
-					AStar::AddUsedPosition(Int2(static_cast<int>(round(transform.Position.x)), static_cast<int>(round(transform.Position.z))), star.dynamic);
-				}
+				auto& transform = GetEditorCamera().Transform();
+				viewerPosition = transform.Position;
+				viewerForward = transform.Forward;
 			}
+			OnAIUpdate(deltaTime, viewerPosition, viewerForward);
 		}
-		
-#pragma endregion	
+
+#pragma endregion AIUpdate
 		
 #pragma region FramebufferBindings
 		uint32_t passes = 0;
@@ -334,11 +296,11 @@ namespace tnah{
 					{
 						auto& model = view.get<MeshComponent>(entity);
 						auto& transform = view.get<TransformComponent>(entity);
-						glm::mat4 matrix = transform.GetTransform();
-						auto& go = FindGameObjectByID(entity);
-						if(go.HasComponent<RigidBodyComponent>())
+						glm::mat4 matrix = m_Hierarchy.GetWorldTransform(entity);
+						auto* go = FindGameObjectByID(entity);
+						if(go && go->HasComponent<RigidBodyComponent>())
 						{
-							auto & rb = go.GetComponent<RigidBodyComponent>();
+							auto & rb = go->GetComponent<RigidBodyComponent>();
 							if(rb.Body->GetType() == Physics::BodyType::Dynamic)
 								matrix = transform.GetQuatTransform();
 						}
@@ -382,31 +344,24 @@ namespace tnah{
 
 				{
 
+						setupAStarGrids();
 						auto view = m_Registry.view<AStarComponent, MeshComponent, TransformComponent>();
 						{
 							for(auto entity : view)
 							{
 								auto &astar = view.get<AStarComponent>(entity);
-								if(astar.reset)
-								{
-									AStar::Init(astar.StartingPos, astar.Size);
-									astar.reset = false;
-								}
-								
 								if(Application::Get().GetDebugModeStatus() || astar.DisplayMap)
 								{
 								auto& model = view.get<MeshComponent>(entity);
 								auto& transform = view.get<TransformComponent>(entity);
 							
-								auto map = AStar::GetUsedPoints();
-								//auto array = AStar::GetMapPoints();
-								auto pos = AStar::GetStartingPos();
-								auto end = AStar::GetEndPosition();
+								auto pos = astar.Grid->GetStartingPos();
+								auto end = astar.Grid->GetEndPosition();
 								for(int x = pos.x; x < end.x; x++)
 								{
 									for(int y = pos.y; y < end.y; y++)
 									{
-										if(map[x][y])
+										if(astar.Grid->IsUsed(Int2(x, y)))
 										{
 											auto tempTransform = transform;
 											tempTransform.Position.x = (float)x;
@@ -448,179 +403,527 @@ namespace tnah{
 				}
 #pragma endregion
 
-#pragma region AudioListeners
+#pragma region AIPathDebug
 
-				//Handles audio listeners
+				//Show the paths of the agents when debugging
+				if(Application::Get().GetDebugModeStatus())
 				{
-					auto view = m_Registry.view<TransformComponent, AudioListenerComponent>();
-					for(auto entity : view)
+					auto agents = m_Registry.view<AIComponent>();
+					auto markers = m_Registry.view<AStarComponent, MeshComponent, TransformComponent>();
+					for(auto agent : agents)
 					{
-						auto& listen = view.get<AudioListenerComponent>(entity);
-						auto& transform = view.get<TransformComponent>(entity);
-
-						if(listen.m_ActiveListing)
-							Audio::SetListener(transform);
-						
-						// auto hear = m_Registry.view<AudioSource>();
-						// for(auto sound : hear)
-						// {
-						//		if(sound.m_3D)
-						// 		//Call a OnAudioListen type function where we can check distance
-						// }
+						auto queue = agents.get<AIComponent>(agent).GetPositions();
+						for(auto entity : markers)
+						{
+							auto& model = markers.get<MeshComponent>(entity);
+							auto& transform = markers.get<TransformComponent>(entity);
+							for(auto& nodes : queue)
+							{
+								auto tempTransform = transform;
+								tempTransform.Position.x = (float)nodes.position.x;
+								tempTransform.Position.z = (float)nodes.position.y;
+								tempTransform.Position.y = -4.0f;
+								tempTransform.Scale = {0.25f, 0.25f, 0.25f};
+								tempTransform.Rotation = {0.0f, 0.0f, 0.0f};
+								if(model.Model)
+								{
+									for (auto& mesh : model.Model->GetMeshes())
+									{
+										Renderer::SubmitMesh(mesh.GetMeshVertexArray(), mesh.GetMeshMaterial(), sceneLights, tempTransform.GetTransform());
+									}
+								}
+							}
+						}
 					}
 				}
 
-#pragma endregion
-				
-#pragma region AudioSource
+				Physics::PhysicsEngine::OnFixedUpdate(deltaTime, PhysicsTimestep(), m_Registry);
 				
-				//Handle audio
+#pragma endregion 
+
+				Renderer::EndScene();
+			}
+#pragma endregion
+
+#pragma region FramebufferEndings
+			passes++;
+		}while(passes < m_RenderPasses);
+
+		//Only need to call this on one buffer as its always going to bind FBO 0 ie no framebuffer
+		if(m_IsEditorScene) m_EditorSceneFramebuffer->Unbind();
+#pragma endregion
+		
+	}
+
+	void Scene::OnAIUpdate(Timestep deltaTime, const glm::vec3& viewerPosition, const glm::vec3& viewerForward, AIFrameTimings* timings)
+	{
+		setupAStarGrids();
+
+		//Each system's time is only kept when someone asked for it
+		Timer timer;
+		const auto lap = [&](AISystem system)
+		{
+			if(timings)
+			{
+				(*timings)[system] = timer.ElapsedMillis();
+				timer.Reset();
+			}
+		};
+
+		auto objects = m_Registry.view<Affordance, TransformComponent>();
+		auto view = m_Registry.view<AIComponent, CharacterComponent, TransformComponent, RigidBodyComponent>();
+		auto player = m_Registry.view<PlayerInteractions, TransformComponent>();
+		bool playerClose = false;
+		mPlayerInteractions = false;
+		mTargetString = "";
+
+		//Every emotion component of the scene is stepped together over the scene's storage
+		m_Emotions.Update(deltaTime.GetSeconds());
+		lap(AISystem::Emotion);
+
+		//Work out which agents tick this frame, far and unseen ones tick less often with the time they missed
+		if(!m_AILod)
+			m_AILod = Ref<AILodScheduler>::Create();
+		m_AILod->BeginFrame(viewerPosition, viewerForward);
+		for(auto entity : view)
+		{
+			auto &ai = view.get<AIComponent>(entity);
+			m_AILod->Schedule(ai.GetLodSettings(), ai.GetLodState(), view.get<TransformComponent>(entity).Position, deltaTime.GetSeconds());
+		}
+		lap(AISystem::Lod);
+
+		//Sources everyone can perceive, then only the agents whose turn it is update what they know
+		if(!m_Perception)
+			m_Perception = Ref<PerceptionSystem>::Create();
+		m_Perception->Clear();
+		for(auto p : player)
+			m_Perception->AddSource(static_cast<uint32_t>(p), player.get<TransformComponent>(p).Position, PerceivedKind::Player);
+		for(auto obj : objects)
+			m_Perception->AddSource(static_cast<uint32_t>(obj), objects.get<TransformComponent>(obj).Position, PerceivedKind::Object, 0.0f);
+		size_t agentCount = 0;
+		float sightRange = 0.0f;
+		float hearingRange = 0.0f;
+		for(auto entity : view)
+		{
+			agentCount++;
+			const auto &perception = m_Registry.get_or_emplace<PerceptionComponent>(entity);
+			sightRange = std::max(sightRange, perception.SightRange);
+			hearingRange = std::max(hearingRange, perception.HearingRange);
+			//Standing agents make less noise than moving ones
+			const float loudness = glm::length(view.get<AIComponent>(entity).GetGroundVelocity()) > 0.1f ? 1.0f : 0.5f;
+			m_Perception->AddSource(static_cast<uint32_t>(entity), view.get<TransformComponent>(entity).Position, PerceivedKind::Agent, loudness);
+		}
+
+		Terrain* sightTerrain = nullptr;
+		glm::mat4 sightTerrainTransform = glm::mat4(1.0f);
+		auto terrains = m_Registry.view<TerrainComponent, TransformComponent>();
+		for(auto terrainEntity : terrains)
+		{
+			sightTerrain = terrains.get<TerrainComponent>(terrainEntity).SceneTerrain;
+			sightTerrainTransform = terrains.get<TransformComponent>(terrainEntity).GetTransform();
+			break;
+		}
+		m_Perception->SetTerrain(sightTerrain, sightTerrainTransform);
+
+		m_Perception->BeginUpdate(agentCount, sightRange, hearingRange);
+		size_t perceiver = 0;
+		for(auto entity : view)
+		{
+			auto &perception = m_Registry.get<PerceptionComponent>(entity);
+			if(m_Perception->IsDue(perceiver++))
+				m_Perception->Perceive(perception, static_cast<uint32_t>(entity), view.get<TransformComponent>(entity).Position);
+		}
+		lap(AISystem::Perception);
+
+		//Score the affordances each agent knows about in one pass, each agent then acts on its best one
+		if(!m_Affordances)
+			m_Affordances = Ref<AffordanceScorer>::Create();
+		m_Affordances->Clear();
+		for(auto obj : objects)
+			m_Affordances->AddObject(static_cast<uint32_t>(obj), objects.get<TransformComponent>(obj).Position, objects.get<Affordance>(obj));
+		for(auto entity : view)
+		{
+			//Agents resting this frame look no further than themselves
+			auto &c = view.get<CharacterComponent>(entity);
+			const float range = view.get<AIComponent>(entity).GetLodState().Ticking ? c.aiCharacter->GetDistance() : 0.0f;
+			m_Affordances->AddAgent(view.get<TransformComponent>(entity).Position, range, c.aiCharacter->GetDesiredAction(), m_Registry.get<PerceptionComponent>(entity));
+		}
+		m_Affordances->Score();
+		size_t agentIndex = 0;
+		lap(AISystem::Affordance);
+
+		//Resume the behaviours whose wait is over, the rest cost nothing this frame
+		if(m_Latent)
+			m_Latent->Update(deltaTime.GetSeconds());
+		lap(AISystem::Behaviour);
+
+
+		//Steer every agent around the others in one pass, moving obstacles hold their course and are avoided in full
+		if(!m_Crowd)
+			m_Crowd = Ref<CrowdSimulation>::Create();
+		m_Crowd->Clear();
+		for(auto entity : view)
+		{
+			auto &t = view.get<TransformComponent>(entity);
+			auto &ai = view.get<AIComponent>(entity);
+			const glm::vec2 preferred = ai.GetPreferredVelocity();
+			const bool responsive = ai.GetLodState().Ticking && glm::length(preferred) > 0.0f;
+			m_Crowd->AddAgent(glm::vec2(t.Position.x, t.Position.z), ai.GetGroundVelocity(), preferred, ai.GetRadius(), ai.GetMaxSpeed(), responsive);
+		}
+
+		auto movingObstacles = m_Registry.view<AStarObstacleComponent, TransformComponent>();
+		for(auto entity : movingObstacles)
+		{
+			if(!movingObstacles.get<AStarObstacleComponent>(entity).dynamic)
+				continue;
+			auto &t = movingObstacles.get<TransformComponent>(entity);
+			m_Crowd->AddAgent(glm::vec2(t.Position.x, t.Position.z), glm::vec2(0.0f), glm::vec2(0.0f), 0.5f, 0.0f, false);
+		}
+
+		if(deltaTime.GetSeconds() > 0.0f)
+		{
+			m_Crowd->ComputeVelocities(deltaTime.GetSeconds());
+			size_t agent = 0;
+			for(auto entity : view)
+				view.get<AIComponent>(entity).SetAvoidanceVelocity(m_Crowd->GetVelocity(agent++));
+		}
+		lap(AISystem::Crowd);
+
+		//Objects several agents are heading for get one flow field that all of them follow instead of a path each
+		std::unordered_map<int, int> pickers;
+		size_t picker = 0;
+		for(auto entity : view)
+		{
+			const AffordanceChoice& choice = m_Affordances->GetChoice(picker++);
+			const bool scripted = m_Latent && m_Latent->IsRunning(static_cast<uint32_t>(entity));
+			if(choice.Object >= 0 && view.get<AIComponent>(entity).GetLodState().Ticking && !scripted)
+				pickers[choice.Object]++;
+		}
+
+		std::unordered_map<int, Ref<FlowField>> sharedGoals;
+		if(auto fields = AStar::GetFlowFields())
+		{
+			for(const auto& [object, count] : pickers)
+			{
+				if(count < s_SharedGoalAgents)
+					continue;
+				const glm::vec3& position = objects.get<TransformComponent>(static_cast<entt::entity>(m_Affordances->GetObjectId(object))).Position;
+				const Int2 goal(static_cast<int>(round(position.x)), static_cast<int>(round(position.z)));
+				if(auto field = fields->Get(goal))
+					sharedGoals.emplace(object, field);
+			}
+		}
+	
+		for(auto entity : view)
+		{
+			auto &t = view.get<TransformComponent>(entity);
+			auto &ai = view.get<AIComponent>(entity);
+			auto &c = view.get<CharacterComponent>(entity);
+			auto &rb = view.get<RigidBodyComponent>(entity);
+			//Act on whatever the scoring pass picked for this agent
+			const AffordanceChoice& choice = m_Affordances->GetChoice(agentIndex++);
+			const AILodState& lod = ai.GetLodState();
+			if(!lod.Ticking)
+			{
+				rb.Body->OnUpdate(t);
+				continue;
+			}
+			const Timestep tickTime(lod.TickTime);
+
+			//Decisions read what the agent already knows rather than searching the scene, handed over each tick as
+			//the component may move in its pool between ticks
+			const auto &perception = m_Registry.get<PerceptionComponent>(entity);
+
+			if(choice.Object >= 0)
+			{
+				const auto obj = static_cast<entt::entity>(m_Affordances->GetObjectId(choice.Object));
+				auto & objTrasnform = objects.get<TransformComponent>(obj);
+				auto event = c.aiCharacter->CheckAction(choice.Value, choice.Distance, m_Affordances->GetObjectTag(choice.Object), perception);
+
+				if(event.second)
 				{
-					auto view = m_Registry.view<TransformComponent, AudioSourceComponent>();
-					for(auto entity : view)
+					Int2 new_pos = AStar::GenerateRandomPosition(Int2((int)objTrasnform.Position.x, (int)objTrasnform.Position.z)).position;
+					switch (c.aiCharacter->GetDesiredAction())
 					{
-						auto& sound = view.get<AudioSourceComponent>(entity);
-						auto& transform = view.get<TransformComponent>(entity);
-
-						if(sound.m_Loaded)
-						{
-							Audio::UpdateSound(sound, transform);
-						}
-						else if(sound.GetStartLoad())
-						{
-							sound.m_Loaded = Audio::AddAudioSource(sound);
-						}
+					case Actions::drink:
+					case Actions::pickup:
+						objTrasnform.Position.x = (float)new_pos.x;
+						objTrasnform.Position.z = (float)new_pos.y;
+						break;
+					default:
+						break;
 					}
 				}
+			}
 
 
+			if(!playerClose)
+			{
+				//Only a player the agent has perceived can interact with it
+				const PerceivedEntity* knownPlayer = perception.FindNearest(PerceivedKind::Player);
+				const auto p = knownPlayer ? static_cast<entt::entity>(knownPlayer->Id) : entt::entity(entt::null);
+				if(knownPlayer && player.contains(p))
 				{
-					auto objects = m_Registry.view<Affordance, TransformComponent>();
-					auto view = m_Registry.view<AIComponent, CharacterComponent, TransformComponent, RigidBodyComponent>();
-					auto player = m_Registry.view<PlayerInteractions, TransformComponent>();
-					auto view2 = m_Registry.view<AStarComponent, MeshComponent, TransformComponent>();
-					bool playerClose = false;
-					mPlayerInteractions = false;
-					mTargetString = "";
-				
-					for(auto entity : view)
+					auto & playerTransform = player.get<TransformComponent>(p);
+					auto & interactions = player.get<PlayerInteractions>(p);
+
+					if(glm::distance(playerTransform.Position, t.Position) < interactions.distance)
 					{
-						auto &t = view.get<TransformComponent>(entity);
-						auto &ai = view.get<AIComponent>(entity);
-						auto &c = view.get<CharacterComponent>(entity);
-						auto &rb = view.get<RigidBodyComponent>(entity);
-						int i = 0;
-						for(auto obj : objects)
+						mPlayerInteractions = true;
+						if(Input::IsKeyPressed(Key::U))
 						{
-							auto & objTrasnform = objects.get<TransformComponent>(obj);
-							auto & affordance = objects.get<Affordance>(obj);
-
-							if(glm::distance(objTrasnform.Position, t.Position) < c.aiCharacter->GetDistance())
-							{
-									float affordanceValue = affordance.GetActionValue(c.aiCharacter->GetDesiredAction());
-									auto event = c.aiCharacter->CheckAction(affordanceValue, glm::distance(objTrasnform.Position, t.Position), affordance.GetTag());
-								
-									if(event.second)
-									{
-										Int2 new_pos = AStar::GenerateRandomPosition(Int2((int)objTrasnform.Position.x, (int)objTrasnform.Position.z)).position;
-										switch (c.aiCharacter->GetDesiredAction())
-										{
-										case Actions::drink:
-										case Actions::pickup:
-											objTrasnform.Position.x = (float)new_pos.x;
-											objTrasnform.Position.z = (float)new_pos.y;
-											break;
-										default:
-											break;
-										}
-									}
-							}
+							c.aiCharacter->ApplyPlayerAction(PlayerActions::pumpUp);
 						}
-						
-						if(!playerClose)
+						else if(Input::IsKeyPressed(Key::I))
 						{
-							for(auto p : player)
-							{
-								auto & playerTransform = player.get<TransformComponent>(p);
-								auto & interactions = player.get<PlayerInteractions>(p);
-
-								if(glm::distance(playerTransform.Position, t.Position) < interactions.distance)
-								{
-									mPlayerInteractions = true;
-									if(Input::IsKeyPressed(Key::U))
-									{
-										c.aiCharacter->ApplyPlayerAction(PlayerActions::pumpUp);
-									}
-									else if(Input::IsKeyPressed(Key::I))
-									{
-										c.aiCharacter->ApplyPlayerAction(PlayerActions::calm);
-									}
-									else if(Input::IsKeyPressed(Key::P))
-									{
-										c.aiCharacter->ApplyPlayerAction(PlayerActions::compliment);
-									}
-									else if(Input::IsKeyPressed(Key::O))
-									{
-										c.aiCharacter->ApplyPlayerAction(PlayerActions::insult);
-									}
-									mTargetString = c.aiCharacter->CharacterString();
-									playerClose = true;
-								}
-							}	
+							c.aiCharacter->ApplyPlayerAction(PlayerActions::calm);
 						}
-
-						ai.SetTargetPosition(c.aiCharacter->OnUpdate(deltaTime, t));
-						ai.SetWander(c.aiCharacter->GetWander());
-						ai.SetMovementSpeed(c.aiCharacter->GetSpeed());
-						ai.OnUpdate(deltaTime, t);
-						if(Application::Get().GetDebugModeStatus())
+						else if(Input::IsKeyPressed(Key::P))
 						{
-							for(auto entity : view2)
-							{
-								auto& model = view2.get<MeshComponent>(entity);
-								auto& transform = view2.get<TransformComponent>(entity);
-							
-								auto queue = ai.GetPositions();
-								for(auto& nodes : queue)
-								{
-									auto tempTransform = transform;
-									tempTransform.Position.x = (float)nodes.position.x;
-									tempTransform.Position.z = (float)nodes.position.y;
-									tempTransform.Position.y = -4.0f;
-									tempTransform.Scale = {0.25f, 0.25f, 0.25f};
-									tempTransform.Rotation = {0.0f, 0.0f, 0.0f};
-									if(model.Model)
-									{
-										for (auto& mesh : model.Model->GetMeshes())
-										{
-											Renderer::SubmitMesh(mesh.GetMeshVertexArray(), mesh.GetMeshMaterial(), sceneLights, tempTransform.GetTransform());
-										}
-									}
-								}	
+							c.aiCharacter->ApplyPlayerAction(PlayerActions::compliment);
 						}
-							
+						else if(Input::IsKeyPressed(Key::O))
+						{
+							c.aiCharacter->ApplyPlayerAction(PlayerActions::insult);
+						}
+						mTargetString = c.aiCharacter->CharacterString();
+						playerClose = true;
 					}
-						rb.Body->OnUpdate(t);
+				}	
+			}
+
+			//Characters driven by a behaviour are left to the scheduler, the scene only carries out their moves
+			const uint32_t owner = static_cast<uint32_t>(entity);
+			if(Behaviour behaviour = c.aiCharacter->StartBehaviour())
+				GetLatentScheduler()->Start(std::move(behaviour), owner);
+			if(m_Latent && m_Latent->IsRunning(owner))
+			{
+				glm::vec3 moveTarget;
+				if(m_Latent->TakeNewMove(owner, moveTarget))
+					ai.SetDestination(Int2(static_cast<int>(round(moveTarget.x)), static_cast<int>(round(moveTarget.z))));
+				ai.SetWander(m_Latent->IsMoving(owner));
+			}
+			else
+			{
+				ai.SetTargetPosition(c.aiCharacter->OnUpdate(tickTime, t, perception));
+				ai.SetWander(c.aiCharacter->GetWander());
+
+				//Agents walled off from the object keep to their own paths
+				auto shared = sharedGoals.find(choice.Object);
+				const Int2 cell(static_cast<int>(round(t.Position.x)), static_cast<int>(round(t.Position.z)));
+				if(shared != sharedGoals.end() && shared->second->IsReachable(cell))
+				{
+					const Int2 goal = shared->second->GetGoal();
+					if(!ai.HasSharedDestination() || !ai.GetDestination().CheckSame(goal))
+						ai.SetSharedDestination(goal);
+					//The field is only followed while moving
+					ai.SetWander(true);
+				}
+				else if(ai.HasSharedDestination())
+				{
+					ai.ClearSharedDestination();
 				}
+			}
+			ai.SetMovementSpeed(c.aiCharacter->GetSpeed());
+			ai.OnUpdate(tickTime, t);
+			if(m_Latent && m_Latent->IsMoving(owner))
+				m_Latent->ReportPosition(owner, t.Position);
+			rb.Body->OnUpdate(t);
+		}
+		lap(AISystem::Agents);
+
+		//Work through the queued path requests within the path budget, the rest carry over to the next frame
+		if(auto paths = AStar::GetPathService())
+			paths->Process();
+		AStar::Update();
+		lap(AISystem::Paths);
+	}
+
+	void Scene::setupAStarGrids()
+	{
+		auto view = m_Registry.view<AStarComponent, MeshComponent, TransformComponent>();
+		for(auto entity : view)
+		{
+			auto &astar = view.get<AStarComponent>(entity);
+			if(astar.reset)
+			{
+				astar.Grid = Ref<AStarGrid>::Create(astar.StartingPos, astar.Size);
+				astar.Grid->SetSearchMode(astar.JumpPointSearch ? AStarSearchMode::JumpPoint : AStarSearchMode::AStar);
+
+				//Bake what the terrain and static obstacles block, or load it from the cache next to the scene
+				WalkabilitySource walkability;
+				auto terrains = m_Registry.view<TerrainComponent, TransformComponent>();
+				for(auto terrainEntity : terrains)
+				{
+					walkability.SceneTerrain = terrains.get<TerrainComponent>(terrainEntity).SceneTerrain;
+					walkability.TerrainTransform = terrains.get<TransformComponent>(terrainEntity).GetTransform();
+					break;
+				}
+				auto staticObstacles = m_Registry.view<AStarObstacleComponent, MeshComponent, TransformComponent>();
+				for(auto obstacle : staticObstacles)
+				{
+					if(!staticObstacles.get<AStarObstacleComponent>(obstacle).dynamic)
+					{
+						walkability.StaticMeshes.push_back({staticObstacles.get<MeshComponent>(obstacle).Model, staticObstacles.get<TransformComponent>(obstacle).GetTransform()});
+						astar.Grid->SkipStaticObstacle(static_cast<uint32_t>(obstacle));
 					}
+				}
+				WalkabilityBake::LoadOrBake(astar.WalkabilityCache, *astar.Grid, walkability, astar.Walkability);
+				AStar::SetActiveGrid(astar.Grid);
+				astar.reset = false;
+			}
+		}
+	}
 
-				Physics::PhysicsEngine::OnFixedUpdate(deltaTime, PhysicsTimestep(), m_Registry);
-				AStar::Update();
+	void Scene::onObstacleDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto view = registry.view<AStarComponent>();
+		for(auto gridEntity : view)
+		{
+			auto& astar = view.get<AStarComponent>(gridEntity);
+			if(astar.Grid)
+				astar.Grid->UnbakeStaticObstacle(static_cast<uint32_t>(entity));
+		}
+	}
+
+	void Scene::onEmotionConstruct(entt::registry& registry, entt::entity entity)
+	{
+		registry.get<EmotionComponent>(entity).MoveTo(m_Emotions);
+	}
+
+	void Scene::registerSystems()
+	{
+		m_Systems = Ref<SystemScheduler>::Create(m_Registry);
+
+		m_Systems->AddSystem("Physics", SystemAccess().Write<TransformComponent, RigidBodyComponent>(), [](Timestep deltaTime)
+		{
+			Physics::PhysicsEngine::OnUpdate(deltaTime);
+		}, SystemThread::Main);
+
+		//TODO: Actually test the player controller component
+		m_Systems->AddSystem("PlayerController", SystemAccess().Read<EditorComponent>().Write<PlayerControllerComponent, TransformComponent>(), [this](Timestep deltaTime)
+		{
+			auto view = m_Registry.view<PlayerControllerComponent, TransformComponent>();
+			for(auto obj : view)
+			{
+				auto& editor = m_GameObjectsInScene[m_EditorCamera].GetComponent<EditorComponent>();
+				auto* go = this->FindGameObjectByID(obj);
+				//Only run this update for a player controller if the editor isnt empty, were in play mode to test the scene
+				// or this scene isnt being ran in a editor ie in the runtime
+				if((editor.m_EditorMode == EditorComponent::EditorMode::Play) || (!m_IsEditorScene && go && go->IsActive()))
+				{
+					auto& transform = view.get<TransformComponent>(obj);
+					auto& player = view.get<PlayerControllerComponent>(obj);
+					// Only continue if the component is active/enabled
+					if(player.IsActive())
+					{
+						if(!player.m_MouseDisabled) Application::Get().GetWindow().SetCursorDisabled(true); player.m_MouseDisabled = true;
+						float s = 0.0f;
+						// if were sprinting, use sprint speed else if were crouched use crouched speed else use the normal movement speed
+						auto speed = (player.IsSprinting()) ? player.SprintSpeed : (s = (player.IsCrouched()) ? player.CrouchSpeed : player.MovementSpeed);
 				
-#pragma endregion 
+						if(Input::IsKeyPressed(player.Forward)) transform.Position += transform.Forward * speed * deltaTime.GetSeconds();
+						if(Input::IsKeyPressed(player.Backward)) transform.Position -= transform.Forward * speed * deltaTime.GetSeconds();
+						if(Input::IsKeyPressed(player.Left)) transform.Position -= transform.Right * speed * deltaTime.GetSeconds();
+						if(Input::IsKeyPressed(player.Right)) transform.Position += transform.Right * speed * deltaTime.GetSeconds();
+						player.ProcessMouseRotation(transform);
+					}
+				}
+			}
+		}, SystemThread::Main);
 
-				Renderer::EndScene();
+		//Update all transform components and their forward, right and up vectors
+		m_Systems->AddSystem("TransformDirections", SystemAccess().Write<TransformComponent>(), [this](Timestep)
+		{
+			auto view = m_Registry.view<TransformComponent>();
+			JobSystem::ParallelForEach(view, 1024, [&view](entt::entity obj)
+			{
+				auto& transform = view.get<TransformComponent>(obj);
+
+				glm::vec3 forward = glm::vec3(0.0f);
+				glm::vec3 right = glm::vec3(0.0f);
+				glm::vec3 up = glm::vec3(0.0f);
+				forward.x = cos(glm::radians(transform.Rotation.x)) * cos(glm::radians(transform.Rotation.y));
+				forward.y = sin(glm::radians(transform.Rotation.y));
+				forward.z = sin(glm::radians(transform.Rotation.x)) * cos(glm::radians(transform.Rotation.y));
+				forward = glm::normalize(forward);
+				right = glm::normalize(glm::cross(forward, glm::vec3(0, 1, 0)));
+				up = glm::normalize(glm::cross(right, forward));
+				transform.Forward = forward;
+				transform.Right = right;
+				transform.Up = up;
+			});
+		});
+
+		//Bring the cached world matrices up to date once the transforms have been moved
+		m_Systems->AddSystem("TransformHierarchy", SystemAccess().Read<TransformComponent>().Write<HierarchyComponent>(), [this](Timestep)
+		{
+			m_Hierarchy.Update();
+		});
+
+		//Static and dynamic obstacles only touch the grid when they change cell, destroyed static obstacles are unbaked by onObstacleDestroy
+		m_Systems->AddSystem("AStarObstacles", SystemAccess().Read<AStarObstacleComponent, TransformComponent>().WriteResource<AStarGrid>(), [this](Timestep)
+		{
+			auto grid = AStar::GetActiveGrid();
+			if(!grid)
+				return;
+
+			auto view = m_Registry.view<AStarObstacleComponent, TransformComponent>();
+			grid->BeginObstacleFrame();
+			for(auto entity : view)
+			{
+				auto & star = view.get<AStarObstacleComponent>(entity);
+				auto& transform = view.get<TransformComponent>(entity);
+				const Int2 cell(static_cast<int>(round(transform.Position.x)), static_cast<int>(round(transform.Position.z)));
+				if(star.dynamic)
+				{
+					grid->UnbakeStaticObstacle(static_cast<uint32_t>(entity));
+					grid->SetDynamicObstacle(static_cast<uint32_t>(entity), cell);
+				}
+				else
+					grid->BakeStaticObstacle(static_cast<uint32_t>(entity), cell);
 			}
-#pragma endregion
+			grid->EndObstacleFrame();
+		});
 
-#pragma region FramebufferEndings
-			passes++;
-		}while(passes < m_RenderPasses);
+		//Audio listeners and sources follow the transforms once they are final for the frame
+		m_Systems->AddSystem("Audio", SystemAccess().Read<TransformComponent>().Write<AudioListenerComponent, AudioSourceComponent>(), [this](Timestep)
+		{
+			Audio::OnUpdate();
 
-		//Only need to call this on one buffer as its always going to bind FBO 0 ie no framebuffer
-		if(m_IsEditorScene) m_EditorSceneFramebuffer->Unbind();
-#pragma endregion
-		
+			auto listeners = m_Registry.view<TransformComponent, AudioListenerComponent>();
+			for(auto entity : listeners)
+			{
+				auto& listen = listeners.get<AudioListenerComponent>(entity);
+				auto& transform = listeners.get<TransformComponent>(entity);
+
+				if(listen.m_ActiveListing)
+					Audio::SetListener(transform);
+			}
+
+			auto sources = m_Registry.view<TransformComponent, AudioSourceComponent>();
+			for(auto entity : sources)
+			{
+				auto& sound = sources.get<AudioSourceComponent>(entity);
+				auto& transform = sources.get<TransformComponent>(entity);
+
+				if(sound.m_Loaded)
+				{
+					Audio::UpdateSound(sound, transform);
+				}
+				else if(sound.GetStartLoad())
+				{
+					sound.m_Loaded = Audio::AddAudioSource(sound);
+				}
+			}
+		}, SystemThread::Main);
+	}
+
+	const std::vector<SystemTiming>& Scene::GetSystemTimings()
+	{
+		if(!m_Systems)
+			registerSystems();
+		return m_Systems->GetTimings();
 	}
 #pragma endregion SceneUpdate
 
@@ -638,21 +941,16 @@ namespace tnah{
 #pragma region SceneHelpers
 	glm::mat4 Scene::GetTransformRelativeToParent(GameObject gameObject)
 	{
-		glm::mat4 transform(1.0f);
-
-		GameObject parent = FindEntityByUUID(gameObject.GetParentUUID());
-		if (parent)
-			transform = GetTransformRelativeToParent(parent);
-
-		return transform * gameObject.Transform().GetTransform();
+		return m_Hierarchy.GetWorldTransform(gameObject.GetID());
 	}
 
 	GameObject& Scene::CreateGameObject(const std::string& name)
 	{
 		GameObject go = { m_Registry.create(), this };
-		auto& idComponent = go.AddComponent<IDComponent>();
-		idComponent.ID = {};
+		// The ID is set as the component is made, so the index sees it in the construct signal
+		auto& idComponent = go.AddComponent<IDComponent>(IDComponent{ UUID() });
 		go.AddComponent<TransformComponent>();
+		m_Registry.emplace<HierarchyComponent>(go.GetID());
 		if (!name.empty())
 		{
 			go.AddComponent<TagComponent>(name);
@@ -660,9 +958,10 @@ namespace tnah{
 
 		go.AddComponent<RelationshipComponent>();
 
-		
-		m_GameObjectsInScene[idComponent.ID] = go;
-		return m_GameObjectsInScene[idComponent.ID];
+		auto& stored = m_GameObjectsInScene[idComponent.ID];
+		stored = go;
+		m_Registry.emplace<GameObjectLinkComponent>(go.GetID(), &stored);
+		return stored;
 	}
 
 	
@@ -671,14 +970,17 @@ namespace tnah{
 	GameObject Scene::CreateGameObject()
 	{
 		GameObject go = { m_Registry.create(), this };
-		auto& idComponent = go.AddComponent<IDComponent>();
-		idComponent.ID = {};
+		// The ID is set as the component is made, so the index sees it in the construct signal
+		auto& idComponent = go.AddComponent<IDComponent>(IDComponent{ UUID() });
 		go.AddComponent<TransformComponent>();
+		m_Registry.emplace<HierarchyComponent>(go.GetID());
 		go.AddComponent<TagComponent>("Default");
 
 		go.AddComponent<RelationshipComponent>();
 
-		m_GameObjectsInScene[idComponent.ID] = go;
+		auto& stored = m_GameObjectsInScene[idComponent.ID];
+		stored = go;
+		m_Registry.emplace<GameObjectLinkComponent>(go.GetID(), &stored);
 		return go;
 	}
 
@@ -708,54 +1010,43 @@ namespace tnah{
 
 	GameObject Scene::FindEntityByTag(const std::string& tag)
 	{
-		auto view = m_Registry.view<TagComponent>();
-		for (auto entity : view)
-		{
-			const auto& canditate = view.get<TagComponent>(entity).Tag;
-			if (canditate == tag)
-				return GameObject(entity, this);
-		}
+		const entt::entity entity = m_Index.FindByTag(tag);
+		if(entity != entt::null)
+			return GameObject(entity, this);
 
 		return GameObject{};
 	}
 
 	GameObject Scene::FindEntityByUUID(UUID id)
 	{
-		auto view = m_Registry.view<IDComponent>();
-		for (auto entity : view)
-		{
-			auto& idComponent = m_Registry.get<IDComponent>(entity);
-			if (idComponent.ID == id)
-				return GameObject(entity, this);
-		}
+		const entt::entity entity = m_Index.FindByUUID(id);
+		if(entity != entt::null)
+			return GameObject(entity, this);
 
 		return GameObject{};
 	}
 
 
-	GameObject& Scene::FindGameObjectByID(const entt::entity& id)
+	GameObject* Scene::FindGameObjectByID(const entt::entity& id)
 	{
-		try
+		if(m_Registry.valid(id))
 		{
-			for(auto& go : m_GameObjectsInScene)
-			{
-				if(go.second.GetID() == id)
-				{
-					return go.second;
-				}
-			}
-
-			throw "GameObject not found!";
-		}
-		catch (const char* error)
-		{
-			TNAH_CORE_INFO("{0}", error);
+			if(auto* link = m_Registry.try_get<GameObjectLinkComponent>(id))
+				return link->Object;
 		}
+
+		TNAH_CORE_INFO("GameObject not found!");
+		return nullptr;
 	}
 	
 	void Scene::DestroyGameObject(GameObject gameObject)
 	{
-		m_Registry.destroy(gameObject.GetID());
+		const entt::entity entity = gameObject.GetID();
+		if(m_Latent)
+			m_Latent->Stop(static_cast<uint32_t>(entity));
+		if(auto* id = m_Registry.try_get<IDComponent>(entity))
+			m_GameObjectsInScene.erase(id->ID);
+		m_Registry.destroy(entity);
 	}
 
 	GameObject& Scene::GetSceneCamera()
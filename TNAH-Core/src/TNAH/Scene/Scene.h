@@ -5,6 +5,16 @@
 #include <vector>
 #include "SceneCamera.h"
 #include "Components/Components.h"
+#include "Components/AI/Crowd.h"
+#include "Components/AI/AffordanceScorer.h"
+#include "Components/AI/AILodScheduler.h"
+#include "Components/AI/Perception.h"
+#include "Components/AI/LatentScheduler.h"
+#include "Components/AI/AIProfile.h"
+#include "Components/AI/EmotionSystem.h"
+#include "SystemScheduler.h"
+#include "EntityIndex.h"
+#include "TransformHierarchy.h"
 #include "TNAH/Core/Timestep.h"
 #include "TNAH/Core/Math.h"
 #include "TNAH/Core/Ref.h"
@@ -39,6 +49,20 @@ namespace tnah {
 
 	class GameObject;
 
+	/**
+	 * @struct	GameObjectLinkComponent
+	 *
+	 * @brief	Points an entity at its game object, map nodes never move so the pointer stays good until it is erased
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct GameObjectLinkComponent
+	{
+		GameObject* Object = nullptr;
+	};
+
 	/**********************************************************************************************//**
 	 * @class	Scene
 	 *
@@ -145,11 +169,41 @@ namespace tnah {
 		 **************************************************************************************************/
 
 		void OnFixedUpdate(Timestep deltaTime, PhysicsTimestep physicsDeltaTime);
+
+		/**********************************************************************************************//**
+		 * @fn	void Scene::OnAIUpdate(Timestep deltaTime, const glm::vec3& viewerPosition, const glm::vec3& viewerForward, AIFrameTimings* timings = nullptr);
+		 *
+		 * @brief	Runs one tick of every AI system in the scene without rendering anything
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	deltaTime	  	The delta time.
+		 * @param 	viewerPosition	The position the AI level of detail is measured from.
+		 * @param 	viewerForward 	The direction the viewer is facing.
+		 * @param 	timings		  	If not null, receives the time spent in each AI system.
+		 **************************************************************************************************/
+
+		void OnAIUpdate(Timestep deltaTime, const glm::vec3& viewerPosition, const glm::vec3& viewerForward, AIFrameTimings* timings = nullptr);
+
+		/**********************************************************************************************//**
+		 * @fn	const std::vector<SystemTiming>& Scene::GetSystemTimings();
+		 *
+		 * @brief	Gets how long each system of the scene took in the last update and the thread it ran on
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The timings, in the order the systems were added.
+		 **************************************************************************************************/
+
+		const std::vector<SystemTiming>& GetSystemTimings();
 		
 		/**********************************************************************************************//**
 		 * @fn	glm::mat4 Scene::GetTransformRelativeToParent(GameObject gameObject);
 		 *
-		 * @brief	Gets the parent of this item
+		 * @brief	Gets the world transform of a game object, built from its parents. Served from the transform
+		 * 			hierarchy's cache, only the object and its ancestors are checked for changes.
 		 *
 		 * @author	Chris
 		 * @date	10/09/2021
@@ -192,14 +246,14 @@ namespace tnah {
 		/**********************************************************************************************//**
 		 * @fn	GameObject Scene::FindEntityByTag(const std::string& tag);
 		 *
-		 * @brief	Searches for the first entity by tag
+		 * @brief	Finds an entity by tag through the scene's tag index
 		 *
 		 * @author	Chris
 		 * @date	10/09/2021
 		 *
 		 * @param 	tag	The tag.
 		 *
-		 * @returns	The found entity by tag.
+		 * @returns	The entity that has had the tag the longest, if several share it.
 		 **************************************************************************************************/
 
 		GameObject FindEntityByTag(const std::string& tag);
@@ -207,7 +261,7 @@ namespace tnah {
 		/**********************************************************************************************//**
 		 * @fn	GameObject Scene::FindEntityByUUID(UUID id);
 		 *
-		 * @brief	Searches for the first entity by uuid
+		 * @brief	Finds an entity by uuid through the scene's uuid index
 		 *
 		 * @author	Chris
 		 * @date	10/09/2021
@@ -220,24 +274,25 @@ namespace tnah {
 		GameObject FindEntityByUUID(UUID id);
 
 		/**********************************************************************************************//**
-		 * @fn	GameObject& Scene::FindGameObjectByID(const entt::entity& id);
+		 * @fn	GameObject* Scene::FindGameObjectByID(const entt::entity& id);
 		 *
-		 * @brief	Searches for the first game object by identifier
+		 * @brief	Gets the game object of an entity in constant time, through the GameObjectLinkComponent every
+		 * 			created game object keeps on its entity
 		 *
 		 * @author	Chris
 		 * @date	10/09/2021
 		 *
 		 * @param 	id	The identifier.
 		 *
-		 * @returns	The found game object by identifier.
+		 * @returns	The found game object by identifier, or nullptr if the entity has none.
 		 **************************************************************************************************/
 
-		GameObject& FindGameObjectByID(const entt::entity& id);
+		GameObject* FindGameObjectByID(const entt::entity& id);
 
 		/**********************************************************************************************//**
 		 * @fn	void Scene::DestroyGameObject(GameObject gameObject);
 		 *
-		 * @brief	Destroys the game object described by gameObject
+		 * @brief	Destroys the game object described by gameObject and removes it from the scene's game objects
 		 *
 		 * @author	Chris
 		 * @date	10/09/2021
@@ -365,6 +420,37 @@ namespace tnah {
 
 		Ref<Framebuffer> GetEditorGameFramebuffer() { return m_EditorGameFramebuffer; }
 
+		/**********************************************************************************************//**
+		 * @fn	AILodStats Scene::GetAILodStats() const
+		 *
+		 * @brief	Gets how many AI agents are in each update tier and how many of them ticked last frame
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The AI level of detail stats.
+		 **************************************************************************************************/
+
+		AILodStats GetAILodStats() const { return m_AILod ? m_AILod->GetStats() : AILodStats(); }
+
+		/**********************************************************************************************//**
+		 * @fn	Ref<LatentScheduler> Scene::GetLatentScheduler()
+		 *
+		 * @brief	Gets the scheduler running the character behaviours, events for them are signalled on it
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The latent scheduler.
+		 **************************************************************************************************/
+
+		Ref<LatentScheduler> GetLatentScheduler()
+		{
+			if(!m_Latent)
+				m_Latent = Ref<LatentScheduler>::Create();
+			return m_Latent;
+		}
+
 		/**********************************************************************************************//**
 		 * @fn	entt::registry& Scene::GetRegistry()
 		 *
@@ -397,11 +483,70 @@ namespace tnah {
 
 	private:
 
+		/**********************************************************************************************//**
+		 * @fn	void Scene::setupAStarGrids();
+		 *
+		 * @brief	Bakes the A* walkability grids from the terrain the first time they are needed
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 **************************************************************************************************/
+
+		void setupAStarGrids();
+
+		/**********************************************************************************************//**
+		 * @fn	void Scene::onObstacleDestroy(entt::registry& registry, entt::entity entity);
+		 *
+		 * @brief	Unbakes a static obstacle from the scene's grids when its obstacle component is destroyed
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	registry	The registry the component belonged to.
+		 * @param 	entity  	The entity that lost the component.
+		 **************************************************************************************************/
+
+		void onObstacleDestroy(entt::registry& registry, entt::entity entity);
+
+		/**********************************************************************************************//**
+		 * @fn	void Scene::onEmotionConstruct(entt::registry& registry, entt::entity entity);
+		 *
+		 * @brief	Moves a new emotion component into the scene's emotion system
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	registry	The registry the component was added to.
+		 * @param 	entity  	The entity that got the component.
+		 **************************************************************************************************/
+
+		void onEmotionConstruct(entt::registry& registry, entt::entity entity);
+
+		/**********************************************************************************************//**
+		 * @fn	void Scene::registerSystems();
+		 *
+		 * @brief	Creates the system scheduler and adds the systems every scene runs before rendering
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 **************************************************************************************************/
+
+		void registerSystems();
+
 		/** @brief	A active scene reference */
 		static ActiveScene s_ActiveScene;
 		
+		/** @brief	The storage of the scene's emotion components, declared before the registry so it outlives them */
+		EmotionSystem m_Emotions;
+
 		/** @brief	The component registry */
 		entt::registry m_Registry;
+
+		/** @brief	The UUID and tag lookups of the registry, declared after it so it connects to a live registry */
+		EntityIndex m_Index{ m_Registry };
+
+		/** @brief	The cached local and world matrices of the game objects */
+		TransformHierarchy m_Hierarchy{ m_Registry };
 		
 		/** @brief	The game objects in scene */
 		std::map<UUID, GameObject> m_GameObjectsInScene;
@@ -431,6 +576,19 @@ namespace tnah {
 		/** @brief	The listener */
 		rp3d::EventListener * listener;
 
+		/** @brief	The crowd steering shared by every AI agent in the scene */
+		Ref<CrowdSimulation> m_Crowd;
+		/** @brief	The affordance scoring shared by every AI agent in the scene */
+		Ref<AffordanceScorer> m_Affordances;
+		/** @brief	The AI level of detail scheduler */
+		Ref<AILodScheduler> m_AILod;
+		/** @brief	The budgeted perception shared by every AI agent in the scene */
+		Ref<PerceptionSystem> m_Perception;
+		/** @brief	The scheduler that resumes the character behaviours of the scene */
+		Ref<LatentScheduler> m_Latent;
+		/** @brief	Runs the systems of the scene that come before rendering */
+		Ref<SystemScheduler> m_Systems;
+
 		bool mPlayerInteractions;
 		std::string mTargetString = "";
 		
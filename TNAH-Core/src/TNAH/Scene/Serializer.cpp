@@ -4,6 +4,7 @@
 #include "GameObject.h"
 #include "Components/AI/AIComponent.h"
 #include "Components/AI/CharacterComponent.h"
+#include "Components/AI/WalkabilityBake.h"
 #include "TNAH/Core/Application.h"
 
 #define ALPHA_SEARCH_STRING "QWERTYUIOPASDFGHJKLZXCVBNMqwertyuiopasdfghjklzxcvbnm"
@@ -414,6 +415,9 @@ namespace tnah {
         ss << GenerateTagOpen("astar", totalTabs);
         ss << GenerateValueEntry("position", glm::vec3(astar.StartingPos.x, 0, astar.StartingPos.y), totalTabs+1);
         ss << GenerateValueEntry("size", glm::vec3(astar.Size.x, 0, astar.Size.y), totalTabs+1);
+        ss << GenerateValueEntry("jumppoint", astar.JumpPointSearch, totalTabs+1);
+        ss << GenerateValueEntry("maxslope", astar.Walkability.MaxSlope, totalTabs+1);
+        ss << GenerateValueEntry("maxstep", astar.Walkability.MaxStep, totalTabs+1);
         ss << GenerateTagClose("astar", totalTabs);
         return ss.str();
     }
@@ -423,6 +427,9 @@ namespace tnah {
         std::stringstream ss;
         ss << GenerateTagOpen("ai", totalTabs);
         ss << GenerateValueEntry("type", (int)c.currentCharacter, totalTabs + 1);
+        ss << GenerateValueEntry("lodfull", ai.GetLodSettings().FullRateDistance, totalTabs + 1);
+        ss << GenerateValueEntry("lodhalf", ai.GetLodSettings().HalfRateDistance, totalTabs + 1);
+        ss << GenerateValueEntry("lodquarter", ai.GetLodSettings().QuarterRateDistance, totalTabs + 1);
         ss << GenerateTagClose("ai", totalTabs);
         return ss.str();
     }
@@ -663,7 +670,7 @@ namespace tnah {
             if(CheckTags(global))
             {
                 currentPos = (int)global.second; // the current position in the string is the end of the global section
-                if(Application::Get().CheckEditor()) // Only create and check editor scene related objects if the application is in editor mode
+                if(Application::Exists() && Application::Get().CheckEditor()) // Only create and check editor scene related objects if the application is in editor mode
                 {
                     const auto editor = FindTags("editor", fileContents);
                     if(CheckTags(editor))
@@ -678,8 +685,8 @@ namespace tnah {
                             auto transformPos = FindTags("transform", fileContents, editor.first, editor.second);
                             auto cameraPos = FindTags("camera", fileContents, editor.first, editor.second);
                         
-                            auto& t = editorCam.GetComponent<TagComponent>();
-                            t = GetTagFromFile(fileContents, tag);
+                            // Set through the game object so the scene's tag index picks up the loaded name
+                            editorCam.SetTag(GetTagFromFile(fileContents, tag).Tag);
 
                             auto& transform = editorCam.Transform();
                             transform = GetTransformFromFile(fileContents, transformPos);
@@ -698,11 +705,10 @@ namespace tnah {
                     auto transformPos = FindTags("transform", fileContents, sceneCam.first, sceneCam.second);
                     auto cameraPos  = FindTags("camera", fileContents, sceneCam.first, sceneCam.second);
 
-                    auto& tag = cam.GetComponent<TagComponent>();
                     auto& camera = cam.GetComponent<CameraComponent>();
                     auto& transform = cam.Transform();
 
-                    tag = GetTagFromFile(fileContents, tagPos);
+                    cam.SetTag(GetTagFromFile(fileContents, tagPos).Tag);
                     camera.Camera = GetCameraFromFile(fileContents, cameraPos);
                     transform = GetTransformFromFile(fileContents, transformPos);
                 }
@@ -716,11 +722,10 @@ namespace tnah {
                     auto transformPos = FindTags("transform", fileContents, sceneLight.first, sceneLight.second);
                     auto lightPos = FindTags("light", fileContents, sceneLight.first, sceneLight.second);
 
-                    auto& tag = light.GetComponent<TagComponent>();
                     auto& transform = light.Transform();
                     auto& sLight = light.GetComponent<LightComponent>();
 
-                    tag = GetTagFromFile(fileContents, tagPos);
+                    light.SetTag(GetTagFromFile(fileContents, tagPos).Tag);
                     transform = GetTransformFromFile(fileContents, transformPos);
                     //sLight.Light = GetLightFromFile(fileContents, lightPos).Light;
                 }
@@ -840,7 +845,20 @@ namespace tnah {
         if(CheckTags(ai))
         {
             //gameObject.AddComponent<CharacterComponent>(GetAiFromFile(fileContents, ai));
-            gameObject.AddComponent<AIComponent>();
+            auto& aiComponent = gameObject.AddComponent<AIComponent>();
+
+            // Scenes saved before AI level of detail keep the default distances
+            AILodSettings lod = aiComponent.GetLodSettings();
+            const float full = GetFloatValueFromFile("lodfull", fileContents, ai);
+            const float half = GetFloatValueFromFile("lodhalf", fileContents, ai);
+            const float quarter = GetFloatValueFromFile("lodquarter", fileContents, ai);
+            if(full > 0.0f)
+                lod.FullRateDistance = full;
+            if(half > 0.0f)
+                lod.HalfRateDistance = half;
+            if(quarter > 0.0f)
+                lod.QuarterRateDistance = quarter;
+            aiComponent.SetLodSettings(lod);
             added++;
         }
 
@@ -897,6 +915,16 @@ namespace tnah {
         glm::vec3 pos = GetVec3FromFile("position", fileContents, componentTagPositions);
         glm::vec3 size = GetVec3FromFile("size", fileContents, componentTagPositions);
         AStarComponent temp(Int2((int)pos.x, (int)pos.z), Int2((int)size.x, (int)size.z));
+        temp.JumpPointSearch = GetBoolValueFromFile("jumppoint", fileContents, componentTagPositions);
+
+        // Scenes saved before walkability baking keep the default limits
+        const float maxSlope = GetFloatValueFromFile("maxslope", fileContents, componentTagPositions);
+        const float maxStep = GetFloatValueFromFile("maxstep", fileContents, componentTagPositions);
+        if(maxSlope > 0.0f)
+            temp.Walkability.MaxSlope = maxSlope;
+        if(maxStep > 0.0f)
+            temp.Walkability.MaxStep = maxStep;
+        temp.WalkabilityCache = WalkabilityBake::GetCachePath(s_SceneResource.AbsoluteDirectory);
         return temp;
     }
 
@@ -0,0 +1,145 @@
+#include "tnahpch.h"
+#include "SystemScheduler.h"
+
+#include "TNAH/Core/Timer.h"
+
+#include <thread>
+
+namespace tnah {
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+	{
+		const auto overlaps = [](const std::vector<std::type_index>& a, const std::vector<std::type_index>& b)
+		{
+			for(const auto& type : a)
+			{
+				if(std::find(b.begin(), b.end(), type) != b.end())
+					return true;
+			}
+			return false;
+		};
+		return overlaps(m_Writes, other.m_Writes) || overlaps(m_Writes, other.m_Reads) || overlaps(m_Reads, other.m_Writes);
+	}
+
+	SystemScheduler::SystemScheduler(entt::registry& registry)
+		: m_Registry(registry)
+	{
+	}
+
+	void SystemScheduler::AddSystem(const char* name, const SystemAccess& access, std::function<void(Timestep)> update, SystemThread thread)
+	{
+		for(auto prepare : access.m_Prepare)
+			prepare(m_Registry);
+
+		System system;
+		system.Name = name;
+		system.Access = access;
+		system.Update = std::move(update);
+		system.Thread = thread;
+		m_Systems.push_back(std::move(system));
+		m_Dirty = true;
+	}
+
+	const std::vector<size_t>& SystemScheduler::GetDependencies(size_t system)
+	{
+		if(m_Dirty)
+			build();
+		return m_Systems[system].Dependencies;
+	}
+
+	void SystemScheduler::build()
+	{
+		const size_t count = m_Systems.size();
+		std::vector<std::vector<char>> ancestors(count, std::vector<char>(count, 0));
+		for(size_t i = 0; i < count; i++)
+		{
+			auto& system = m_Systems[i];
+			system.Dependencies.clear();
+			system.Dependents.clear();
+
+			// Nearest conflicts first, a conflict already behind one of those is waited for through it
+			for(size_t j = i; j-- > 0;)
+			{
+				if(ancestors[i][j] || !system.Access.ConflictsWith(m_Systems[j].Access))
+					continue;
+
+				system.Dependencies.push_back(j);
+				ancestors[i][j] = 1;
+				for(size_t k = 0; k < j; k++)
+					ancestors[i][k] |= ancestors[j][k];
+			}
+			for(size_t dependency : system.Dependencies)
+				m_Systems[dependency].Dependents.push_back(i);
+		}
+
+		m_Pending = std::vector<std::atomic<uint32_t>>(count);
+		m_Timings.resize(count);
+		for(size_t i = 0; i < count; i++)
+			m_Timings[i].Name = m_Systems[i].Name;
+		m_Dirty = false;
+	}
+
+	void SystemScheduler::Run(Timestep deltaTime)
+	{
+		if(m_Dirty)
+			build();
+		if(m_Systems.empty())
+			return;
+
+		m_DeltaTime = deltaTime;
+		m_Remaining.store(m_Systems.size());
+		for(size_t i = 0; i < m_Systems.size(); i++)
+			m_Pending[i].store(static_cast<uint32_t>(m_Systems[i].Dependencies.size()), std::memory_order_relaxed);
+		for(size_t i = 0; i < m_Systems.size(); i++)
+		{
+			if(m_Systems[i].Dependencies.empty())
+				launch(i);
+		}
+
+		// Main thread systems are run here as they become ready, while waiting the thread helps with the others
+		while(m_Remaining.load(std::memory_order_acquire) > 0)
+		{
+			size_t next = m_Systems.size();
+			{
+				std::lock_guard<std::mutex> lock(m_MainLock);
+				if(!m_MainReady.empty())
+				{
+					next = m_MainReady.back();
+					m_MainReady.pop_back();
+				}
+			}
+
+			if(next < m_Systems.size())
+				runSystem(next);
+			else if(!JobSystem::RunPending())
+				std::this_thread::yield();
+		}
+		JobSystem::Wait(m_Jobs);
+	}
+
+	void SystemScheduler::launch(size_t system)
+	{
+		if(m_Systems[system].Thread == SystemThread::Main || JobSystem::GetThreadCount() == 1)
+		{
+			std::lock_guard<std::mutex> lock(m_MainLock);
+			m_MainReady.push_back(system);
+			return;
+		}
+		JobSystem::Run([this, system]() { runSystem(system); }, &m_Jobs);
+	}
+
+	void SystemScheduler::runSystem(size_t system)
+	{
+		Timer timer;
+		m_Systems[system].Update(m_DeltaTime);
+		m_Timings[system].Milliseconds = timer.ElapsedMillis();
+		m_Timings[system].Thread = JobSystem::GetThreadIndex();
+
+		for(size_t dependent : m_Systems[system].Dependents)
+		{
+			if(m_Pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				launch(dependent);
+		}
+		m_Remaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
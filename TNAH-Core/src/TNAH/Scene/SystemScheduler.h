@@ -0,0 +1,342 @@
+#pragma once
+#include "TNAH/Core/Ref.h"
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Core/Timestep.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <typeindex>
+#include <vector>
+
+#pragma warning(push, 0)
+#include <entt/entt.hpp>
+#pragma warning(pop)
+
+namespace tnah {
+
+	/**
+	 * @class	SystemAccess
+	 *
+	 * @brief	The components and resources a system reads and writes. Two systems that both only read something
+	 * 			can run at the same time, a system that writes it runs alone. Resources are anything shared outside
+	 * 			the registry, such as the active A* grid or the audio engine, named by their type.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class SystemAccess
+	{
+	public:
+
+		/**
+		 * @fn	template<typename... Components> SystemAccess& SystemAccess::Read()
+		 *
+		 * @brief	Declares components the system only reads
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	This access, for chaining.
+		 */
+
+		template<typename... Components>
+		SystemAccess& Read()
+		{
+			(m_Reads.emplace_back(typeid(Components)), ...);
+			m_Prepare.push_back([](entt::registry& registry) { (static_cast<void>(registry.view<Components>()), ...); });
+			return *this;
+		}
+
+		/**
+		 * @fn	template<typename... Components> SystemAccess& SystemAccess::Write()
+		 *
+		 * @brief	Declares components the system writes
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	This access, for chaining.
+		 */
+
+		template<typename... Components>
+		SystemAccess& Write()
+		{
+			(m_Writes.emplace_back(typeid(Components)), ...);
+			m_Prepare.push_back([](entt::registry& registry) { (static_cast<void>(registry.view<Components>()), ...); });
+			return *this;
+		}
+
+		/**
+		 * @fn	template<typename... Resources> SystemAccess& SystemAccess::ReadResource()
+		 *
+		 * @brief	Declares shared state outside the registry that the system only reads
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	This access, for chaining.
+		 */
+
+		template<typename... Resources>
+		SystemAccess& ReadResource()
+		{
+			(m_Reads.emplace_back(typeid(Resources)), ...);
+			return *this;
+		}
+
+		/**
+		 * @fn	template<typename... Resources> SystemAccess& SystemAccess::WriteResource()
+		 *
+		 * @brief	Declares shared state outside the registry that the system writes
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	This access, for chaining.
+		 */
+
+		template<typename... Resources>
+		SystemAccess& WriteResource()
+		{
+			(m_Writes.emplace_back(typeid(Resources)), ...);
+			return *this;
+		}
+
+		/**
+		 * @fn	bool SystemAccess::ConflictsWith(const SystemAccess& other) const;
+		 *
+		 * @brief	Query if either system writes something the other reads or writes
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	other	The other access.
+		 *
+		 * @returns	True if they cannot run at the same time, false if they can.
+		 */
+
+		bool ConflictsWith(const SystemAccess& other) const;
+
+	private:
+
+		/** @brief	The types only read */
+		std::vector<std::type_index> m_Reads;
+
+		/** @brief	The types written */
+		std::vector<std::type_index> m_Writes;
+
+		/** @brief	Creates the component pools up front, so running systems never change the registry itself */
+		std::vector<void(*)(entt::registry&)> m_Prepare;
+
+		friend class SystemScheduler;
+	};
+
+	/**
+	 * @enum	SystemThread
+	 *
+	 * @brief	Where a system may run. Anything that touches the renderer, the window, input or the physics world
+	 * 			must stay on the main thread.
+	 */
+
+	enum class SystemThread
+	{
+		Any, Main
+	};
+
+	/**
+	 * @struct	SystemTiming
+	 *
+	 * @brief	How long a system took in the last run and the job system thread it ran on
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct SystemTiming
+	{
+		const char* Name = "";
+		float Milliseconds = 0.0f;
+		uint32_t Thread = 0;
+	};
+
+	/**
+	 * @class	SystemScheduler
+	 *
+	 * @brief	Runs the systems of a scene over the job system. A system waits for every system added before it that
+	 * 			it conflicts with, everything else runs at the same time. The graph is built once and only rebuilt
+	 * 			when a system is added.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class SystemScheduler : public RefCounted
+	{
+	public:
+
+		/**
+		 * @fn	SystemScheduler::SystemScheduler(entt::registry& registry);
+		 *
+		 * @brief	Constructor
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	registry	The registry the systems run over.
+		 */
+
+		SystemScheduler(entt::registry& registry);
+
+		/**
+		 * @fn	void SystemScheduler::AddSystem(const char* name, const SystemAccess& access, std::function<void(Timestep)> update, SystemThread thread = SystemThread::Any);
+		 *
+		 * @brief	Adds a system, systems that conflict run in the order they were added
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	name  	The name shown in the timings.
+		 * @param 	access	What the system reads and writes.
+		 * @param 	update	The function that runs the system.
+		 * @param 	thread	Where the system may run.
+		 */
+
+		void AddSystem(const char* name, const SystemAccess& access, std::function<void(Timestep)> update, SystemThread thread = SystemThread::Any);
+
+		/**
+		 * @fn	void SystemScheduler::Run(Timestep deltaTime);
+		 *
+		 * @brief	Runs every system once, the calling thread runs the main thread systems and helps with the rest
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	deltaTime	The delta time.
+		 */
+
+		void Run(Timestep deltaTime);
+
+		/**
+		 * @fn	const std::vector<SystemTiming>& SystemScheduler::GetTimings() const
+		 *
+		 * @brief	Gets the timings of the last run, in the order the systems were added
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The timings.
+		 */
+
+		const std::vector<SystemTiming>& GetTimings() const { return m_Timings; }
+
+		/**
+		 * @fn	const std::vector<size_t>& SystemScheduler::GetDependencies(size_t system)
+		 *
+		 * @brief	Gets the systems that must finish before a system can start
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	system	The index of the system.
+		 *
+		 * @returns	The indices of the systems it waits for.
+		 */
+
+		const std::vector<size_t>& GetDependencies(size_t system);
+
+		/**
+		 * @fn	size_t SystemScheduler::GetSystemCount() const
+		 *
+		 * @brief	Gets the number of systems
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The system count.
+		 */
+
+		size_t GetSystemCount() const { return m_Systems.size(); }
+
+	private:
+
+		/**
+		 * @fn	void SystemScheduler::build();
+		 *
+		 * @brief	Builds the graph, keeping only the edges that are not implied by a longer path
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		void build();
+
+		/**
+		 * @fn	void SystemScheduler::launch(size_t system);
+		 *
+		 * @brief	Hands a system whose dependencies are done to the main thread or the job system
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	system	The index of the system.
+		 */
+
+		void launch(size_t system);
+
+		/**
+		 * @fn	void SystemScheduler::runSystem(size_t system);
+		 *
+		 * @brief	Runs a system, then launches the systems that were only waiting for it
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	system	The index of the system.
+		 */
+
+		void runSystem(size_t system);
+
+		/** @brief	A system and its place in the graph */
+		struct System
+		{
+			const char* Name;
+			SystemAccess Access;
+			std::function<void(Timestep)> Update;
+			SystemThread Thread;
+			std::vector<size_t> Dependencies;
+			std::vector<size_t> Dependents;
+		};
+
+		/** @brief	The registry the systems run over */
+		entt::registry& m_Registry;
+
+		/** @brief	The systems in the order they were added */
+		std::vector<System> m_Systems;
+
+		/** @brief	The timings of the last run */
+		std::vector<SystemTiming> m_Timings;
+
+		/** @brief	Dependencies each system is still waiting for in the current run */
+		std::vector<std::atomic<uint32_t>> m_Pending;
+
+		/** @brief	Systems not finished in the current run */
+		std::atomic<size_t> m_Remaining = 0;
+
+		/** @brief	Main thread systems that are ready to run */
+		std::vector<size_t> m_MainReady;
+
+		/** @brief	Guards the main thread systems that are ready */
+		std::mutex m_MainLock;
+
+		/** @brief	Counts the systems handed to the job system in the current run */
+		JobCounter m_Jobs;
+
+		/** @brief	The delta time of the current run */
+		Timestep m_DeltaTime;
+
+		/** @brief	True if the graph needs building */
+		bool m_Dirty = true;
+	};
+}
@@ -0,0 +1,238 @@
+#include "tnahpch.h"
+#include "TransformHierarchy.h"
+
+#include "Components/Components.h"
+
+namespace tnah {
+
+	TransformHierarchy::TransformHierarchy(entt::registry& registry)
+		: m_Registry(registry)
+	{
+		m_Registry.on_construct<HierarchyComponent>().connect<&TransformHierarchy::onConstruct>(this);
+		m_Registry.on_destroy<HierarchyComponent>().connect<&TransformHierarchy::onDestroy>(this);
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		m_Registry.on_construct<HierarchyComponent>().disconnect(this);
+		m_Registry.on_destroy<HierarchyComponent>().disconnect(this);
+	}
+
+	bool TransformHierarchy::SetParent(entt::entity child, entt::entity parent)
+	{
+		auto* node = m_Registry.try_get<HierarchyComponent>(child);
+		if(!node)
+			return false;
+
+		if(parent != entt::null)
+		{
+			if(!m_Registry.try_get<HierarchyComponent>(parent))
+				return false;
+			for(entt::entity ancestor = parent; ancestor != entt::null; ancestor = m_Registry.get<HierarchyComponent>(ancestor).Parent)
+			{
+				if(ancestor == child)
+					return false;
+			}
+		}
+
+		if(node->Parent == parent)
+			return true;
+
+		unlink(child, *node);
+		node->Parent = parent;
+		if(parent != entt::null)
+		{
+			auto& parentNode = m_Registry.get<HierarchyComponent>(parent);
+			node->NextSibling = parentNode.FirstChild;
+			parentNode.FirstChild = child;
+		}
+
+		// The cached world matrix was built on the old parent
+		if(node->Index < m_Nodes.size() && m_Nodes[node->Index].Entity == child)
+			m_Nodes[node->Index].ParentVersion = ~0ull;
+		m_Dirty = true;
+		return true;
+	}
+
+	void TransformHierarchy::Update()
+	{
+		if(m_Dirty)
+			build();
+
+		m_Recomputed = 0;
+		const uint32_t count = static_cast<uint32_t>(m_Nodes.size());
+		for(uint32_t i = 0; i < count; i++)
+		{
+			if(refresh(i))
+				m_Recomputed++;
+		}
+	}
+
+	glm::mat4 TransformHierarchy::GetWorldTransform(entt::entity entity)
+	{
+		const uint32_t index = refreshPath(entity);
+		if(index != ~0u)
+			return m_Nodes[index].World;
+
+		if(auto* transform = m_Registry.try_get<TransformComponent>(entity))
+			return transform->GetTransform();
+		return glm::mat4(1.0f);
+	}
+
+	const glm::mat4& TransformHierarchy::GetLocalTransform(entt::entity entity)
+	{
+		static const glm::mat4 s_Identity(1.0f);
+		const uint32_t index = refreshPath(entity);
+		return index != ~0u ? m_Nodes[index].Local : s_Identity;
+	}
+
+	void TransformHierarchy::onConstruct(entt::registry& registry, entt::entity entity)
+	{
+		m_Dirty = true;
+	}
+
+	void TransformHierarchy::onDestroy(entt::registry& registry, entt::entity entity)
+	{
+		auto* node = registry.try_get<HierarchyComponent>(entity);
+		if(!node)
+			return;
+
+		unlink(entity, *node);
+
+		// The children become roots, keeping their local transforms
+		for(entt::entity child = node->FirstChild; child != entt::null;)
+		{
+			auto* childNode = registry.try_get<HierarchyComponent>(child);
+			if(!childNode)
+				break;
+
+			const entt::entity next = childNode->NextSibling;
+			childNode->Parent = entt::null;
+			childNode->NextSibling = entt::null;
+			if(childNode->Index < m_Nodes.size() && m_Nodes[childNode->Index].Entity == child)
+				m_Nodes[childNode->Index].ParentVersion = ~0ull;
+			child = next;
+		}
+		node->FirstChild = entt::null;
+		m_Dirty = true;
+	}
+
+	void TransformHierarchy::unlink(entt::entity child, HierarchyComponent& node)
+	{
+		if(node.Parent == entt::null)
+			return;
+
+		if(auto* parent = m_Registry.try_get<HierarchyComponent>(node.Parent))
+		{
+			if(parent->FirstChild == child)
+			{
+				parent->FirstChild = node.NextSibling;
+			}
+			else
+			{
+				for(entt::entity sibling = parent->FirstChild; sibling != entt::null;)
+				{
+					auto* siblingNode = m_Registry.try_get<HierarchyComponent>(sibling);
+					if(!siblingNode)
+						break;
+					if(siblingNode->NextSibling == child)
+					{
+						siblingNode->NextSibling = node.NextSibling;
+						break;
+					}
+					sibling = siblingNode->NextSibling;
+				}
+			}
+		}
+		node.Parent = entt::null;
+		node.NextSibling = entt::null;
+	}
+
+	void TransformHierarchy::build()
+	{
+		std::vector<Node> previous;
+		previous.swap(m_Nodes);
+		m_Nodes.reserve(previous.size());
+
+		auto view = m_Registry.view<HierarchyComponent>();
+		for(auto root : view)
+		{
+			if(view.get<HierarchyComponent>(root).Parent != entt::null)
+				continue;
+
+			// Walk the subtree depth first through the child and sibling links, climbing back up at each last child
+			entt::entity current = root;
+			while(current != entt::null)
+			{
+				auto& hierarchy = view.get<HierarchyComponent>(current);
+
+				Node node;
+				if(hierarchy.Index < previous.size() && previous[hierarchy.Index].Entity == current)
+					node = previous[hierarchy.Index];
+				node.Entity = current;
+				node.Parent = hierarchy.Parent != entt::null ? view.get<HierarchyComponent>(hierarchy.Parent).Index : ~0u;
+				hierarchy.Index = static_cast<uint32_t>(m_Nodes.size());
+				m_Nodes.push_back(node);
+
+				if(hierarchy.FirstChild != entt::null)
+				{
+					current = hierarchy.FirstChild;
+					continue;
+				}
+
+				while(current != root && view.get<HierarchyComponent>(current).NextSibling == entt::null)
+					current = view.get<HierarchyComponent>(current).Parent;
+				current = current != root ? view.get<HierarchyComponent>(current).NextSibling : entt::entity(entt::null);
+			}
+		}
+		m_Dirty = false;
+	}
+
+	bool TransformHierarchy::refresh(uint32_t index)
+	{
+		Node& node = m_Nodes[index];
+
+		bool changed = !node.HasLocal;
+		if(auto* transform = m_Registry.try_get<TransformComponent>(node.Entity))
+		{
+			if(changed || transform->Position != node.Position || transform->Rotation != node.Rotation || transform->Scale != node.Scale)
+			{
+				node.Position = transform->Position;
+				node.Rotation = transform->Rotation;
+				node.Scale = transform->Scale;
+				node.Local = transform->GetTransform();
+				changed = true;
+			}
+		}
+		else if(changed)
+		{
+			node.Local = glm::mat4(1.0f);
+		}
+		node.HasLocal = true;
+
+		const uint64_t parentVersion = node.Parent != ~0u ? m_Nodes[node.Parent].Version : 0;
+		if(!changed && parentVersion == node.ParentVersion)
+			return false;
+
+		node.World = node.Parent != ~0u ? m_Nodes[node.Parent].World * node.Local : node.Local;
+		node.ParentVersion = parentVersion;
+		node.Version = ++m_Version;
+		return true;
+	}
+
+	uint32_t TransformHierarchy::refreshPath(entt::entity entity)
+	{
+		auto* hierarchy = m_Registry.try_get<HierarchyComponent>(entity);
+		if(!hierarchy)
+			return ~0u;
+		if(m_Dirty)
+			build();
+
+		m_Path.clear();
+		for(uint32_t index = hierarchy->Index; index != ~0u; index = m_Nodes[index].Parent)
+			m_Path.push_back(index);
+		for(auto step = m_Path.rbegin(); step != m_Path.rend(); ++step)
+			refresh(*step);
+		return hierarchy->Index;
+	}
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#pragma warning(push, 0)
+#include <entt/entt.hpp>
+#pragma warning(pop)
+
+namespace tnah {
+
+	/**
+	 * @struct	HierarchyComponent
+	 *
+	 * @brief	Where an entity sits in the transform hierarchy. Children are a list through the first child and
+	 * 			each child's next sibling, so walking them needs no lookups. Only change it through
+	 * 			TransformHierarchy::SetParent.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct HierarchyComponent
+	{
+		/** @brief	The parent, null for a root */
+		entt::entity Parent = entt::null;
+
+		/** @brief	The first child, null if there are none */
+		entt::entity FirstChild = entt::null;
+
+		/** @brief	The next child of the same parent, null for the last one */
+		entt::entity NextSibling = entt::null;
+
+		/** @brief	The position of the entity in the depth first order, only good while the order is built */
+		uint32_t Index = ~0u;
+	};
+
+	/**
+	 * @class	TransformHierarchy
+	 *
+	 * @brief	Caches the local and world matrix of every entity with a HierarchyComponent. The nodes are kept in
+	 * 			depth first order so every parent comes before its children, and one pass from the front updates
+	 * 			every world matrix. A local matrix is only rebuilt when its transform changed, and a world matrix
+	 * 			only when its local matrix or its parent's world matrix did, so untouched subtrees cost a compare
+	 * 			per node. Transforms are written directly all over the engine, so changes are found by comparing
+	 * 			against the cached position, rotation and scale rather than through signals.
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class TransformHierarchy
+	{
+	public:
+
+		/**
+		 * @fn	TransformHierarchy::TransformHierarchy(entt::registry& registry);
+		 *
+		 * @brief	Constructor, connects to the signals of the registry
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	registry	The registry, must outlive the hierarchy.
+		 */
+
+		TransformHierarchy(entt::registry& registry);
+
+		/**
+		 * @fn	TransformHierarchy::~TransformHierarchy();
+		 *
+		 * @brief	Destructor, disconnects from the signals of the registry
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		~TransformHierarchy();
+
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+		/**
+		 * @fn	bool TransformHierarchy::SetParent(entt::entity child, entt::entity parent);
+		 *
+		 * @brief	Moves an entity under a new parent, or to the root with null. The entity's local transform is
+		 * 			kept, so its world matrix follows the new parent.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	child 	The entity to move, must have a HierarchyComponent.
+		 * @param 	parent	The new parent, must have a HierarchyComponent or be null.
+		 *
+		 * @returns	True if moved, false if either is not in the hierarchy or the parent is below the child.
+		 */
+
+		bool SetParent(entt::entity child, entt::entity parent);
+
+		/**
+		 * @fn	void TransformHierarchy::Update();
+		 *
+		 * @brief	Brings every cached matrix up to date in one pass, rebuilding the order first if the hierarchy
+		 * 			changed
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		void Update();
+
+		/**
+		 * @fn	glm::mat4 TransformHierarchy::GetWorldTransform(entt::entity entity);
+		 *
+		 * @brief	Gets the world matrix of an entity, bringing only it and its ancestors up to date. Must not be
+		 * 			called while Update runs.
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	entity	The entity.
+		 *
+		 * @returns	The world matrix, or the entity's own transform if it is not in the hierarchy.
+		 */
+
+		glm::mat4 GetWorldTransform(entt::entity entity);
+
+		/**
+		 * @fn	const glm::mat4& TransformHierarchy::GetLocalTransform(entt::entity entity);
+		 *
+		 * @brief	Gets the cached local matrix of an entity, brought up to date the same way as the world matrix
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	entity	The entity, must have a HierarchyComponent.
+		 *
+		 * @returns	The local matrix.
+		 */
+
+		const glm::mat4& GetLocalTransform(entt::entity entity);
+
+		/**
+		 * @fn	size_t TransformHierarchy::GetRecomputedCount() const
+		 *
+		 * @brief	Gets how many world matrices the last Update rebuilt
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @returns	The count.
+		 */
+
+		size_t GetRecomputedCount() const { return m_Recomputed; }
+
+	private:
+
+		/** @brief	The signal listeners, entt calls these with the entity whose hierarchy component changed */
+		void onConstruct(entt::registry& registry, entt::entity entity);
+		void onDestroy(entt::registry& registry, entt::entity entity);
+
+		/**
+		 * @fn	void TransformHierarchy::unlink(entt::entity child, HierarchyComponent& node);
+		 *
+		 * @brief	Takes an entity out of its parent's children
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	child	The entity.
+		 * @param 	node 	The entity's hierarchy component.
+		 */
+
+		void unlink(entt::entity child, HierarchyComponent& node);
+
+		/**
+		 * @fn	void TransformHierarchy::build();
+		 *
+		 * @brief	Lays the nodes out depth first, carrying over the cached matrices of nodes that were already there
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 */
+
+		void build();
+
+		/**
+		 * @fn	bool TransformHierarchy::refresh(uint32_t index);
+		 *
+		 * @brief	Brings one node up to date, its parent must already be
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	index	The index of the node.
+		 *
+		 * @returns	True if its world matrix was rebuilt.
+		 */
+
+		bool refresh(uint32_t index);
+
+		/**
+		 * @fn	uint32_t TransformHierarchy::refreshPath(entt::entity entity);
+		 *
+		 * @brief	Brings an entity and its ancestors up to date, from the root down
+		 *
+		 * @author	Chris
+		 * @date	17/10/2026
+		 *
+		 * @param 	entity	The entity.
+		 *
+		 * @returns	The index of the entity's node, or ~0u if it is not in the hierarchy.
+		 */
+
+		uint32_t refreshPath(entt::entity entity);
+
+		/** @brief	A node of the hierarchy and its cached matrices */
+		struct Node
+		{
+			entt::entity Entity = entt::null;
+			/** @brief	The index of the parent node, always lower than this one, or ~0u for a root */
+			uint32_t Parent = ~0u;
+			/** @brief	The transform the local matrix was built from */
+			glm::vec3 Position = glm::vec3(0.0f);
+			glm::vec3 Rotation = glm::vec3(0.0f);
+			glm::vec3 Scale = glm::vec3(1.0f);
+			glm::mat4 Local = glm::mat4(1.0f);
+			glm::mat4 World = glm::mat4(1.0f);
+			/** @brief	Stamped whenever the world matrix is rebuilt */
+			uint64_t Version = 0;
+			/** @brief	The parent's version the world matrix was built from */
+			uint64_t ParentVersion = 0;
+			/** @brief	False until the local matrix has been built once */
+			bool HasLocal = false;
+		};
+
+		/** @brief	The registry */
+		entt::registry& m_Registry;
+
+		/** @brief	The nodes in depth first order */
+		std::vector<Node> m_Nodes;
+
+		/** @brief	Scratch space for the nodes from an entity up to its root */
+		std::vector<uint32_t> m_Path;
+
+		/** @brief	The last version stamped */
+		uint64_t m_Version = 0;
+
+		/** @brief	World matrices rebuilt by the last Update */
+		size_t m_Recomputed = 0;
+
+		/** @brief	True if nodes were added, removed or moved since the order was built */
+		bool m_Dirty = true;
+	};
+}
@@ -4,7 +4,9 @@
 
 #ifdef TNAH_PLATFORM_WINDOWS
     #include <Windows.h>
-    #ifdef TNAH_BUILD_DLL
+    #if defined(TNAH_STATIC_LINK)
+        #define TNAH_API
+    #elif defined(TNAH_BUILD_DLL)
         #define TNAH_API __declspec(dllexport)
     #else
         #define TNAH_API __declspec(dllimport)
@@ -0,0 +1,98 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Core/Random.h"
+#include "TNAH/Renderer/RendererAPI.h"
+#include "TNAH/Scene/AISimulation.h"
+#include "TNAH/Scene/GameObject.h"
+#include "TNAH/Scene/Components/AI/CharacterComponent.h"
+
+namespace tnah::test {
+
+	/**
+	 * @class	WanderingCharacter
+	 *
+	 * @brief	A character that only wanders, so the run is decided by the paths the agents are given
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	class WanderingCharacter : public Character
+	{
+	public:
+		glm::vec3 OnUpdate(Timestep deltaTime, TransformComponent& transform, const PerceptionComponent& perception) override
+		{
+			SetWander(true);
+			SetSpeed(4.0f);
+			return transform.Position;
+		}
+
+		std::pair<bool, bool> CheckAction(float affordanceValue, float distance, const std::string& tag, const PerceptionComponent& perception) override { return { false, false }; }
+		void ApplyPlayerAction(PlayerActions givenAction) override {}
+		std::string CharacterString() override { return name; }
+	};
+
+	/**
+	 * @fn	static uint64_t RunWanderers(uint64_t seed)
+	 *
+	 * @brief	Builds a scene with a grid big enough for a hierarchical graph and wandering agents, and runs it
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	seed	The seed of the run.
+	 *
+	 * @returns	The checksum of the run.
+	 */
+
+	static uint64_t RunWanderers(uint64_t seed)
+	{
+		AISimulationSettings settings;
+		settings.Seed = seed;
+		settings.Ticks = 600;
+
+		std::vector<Ref<WanderingCharacter>> characters;
+		uint64_t checksum = 0;
+		{
+			Random::Seed(seed);
+			Ref<Scene> scene = Scene::CreateEmptyScene();
+
+			auto& grid = scene->CreateGameObject("Grid");
+			grid.AddComponent<AStarComponent>(Int2(0, 0), Int2(192, 192));
+			grid.AddComponent<MeshComponent>();
+
+			for(int i = 0; i < 32; i++)
+			{
+				auto& agent = scene->CreateGameObject("Agent");
+				const int x = Random::Range(0, 191);
+				const int z = Random::Range(0, 191);
+				agent.Transform().Position = glm::vec3(static_cast<float>(x), 0.0f, static_cast<float>(z));
+				agent.AddComponent<AIComponent>();
+				characters.push_back(Ref<WanderingCharacter>::Create());
+				agent.AddComponent<CharacterComponent>(CharacterNames::StudentAi, characters.back().Raw());
+				agent.AddComponent<RigidBodyComponent>(agent);
+			}
+
+			checksum = AISimulation::Run(scene, settings).Checksum;
+			AStar::SetActiveGrid(nullptr);
+		}
+		Scene::ClearActiveScene();
+		return checksum;
+	}
+
+	TNAH_TEST(AISimulationRepeatsOnHierarchicalGrid)
+	{
+		RendererAPI::SetAPI(RendererAPI::API::None);
+
+		// Workers make the hierarchy build race the ticks if the run does not wait for it
+		JobSystem::Init(3);
+		const uint64_t first = RunWanderers(5);
+		const uint64_t second = RunWanderers(5);
+		JobSystem::Shutdown();
+
+		TNAH_CHECK(first != 0);
+		TNAH_CHECK(first == second);
+	}
+}
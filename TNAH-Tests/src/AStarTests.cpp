@@ -0,0 +1,262 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include "TNAH/Core/JobSystem.h"
+#include "TNAH/Scene/Components/AI/AStar.h"
+#include "TNAH/Scene/Components/AI/HPAStar.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+namespace tnah::test {
+
+	/**
+	 * @fn	static Ref<AStarGrid> MakeBlockedGrid(int side, float blockedShare, uint32_t seed)
+	 *
+	 * @brief	Makes a square grid with a share of its cells blocked at random
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	side			The width and height of the grid.
+	 * @param 	blockedShare	The share of cells blocked, 0 to 1.
+	 * @param 	seed			The seed of the random blocking.
+	 *
+	 * @returns	The grid.
+	 */
+
+	static Ref<AStarGrid> MakeBlockedGrid(int side, float blockedShare, uint32_t seed)
+	{
+		auto grid = Ref<AStarGrid>::Create(Int2(0, 0), Int2(side, side));
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> share(0.0f, 1.0f);
+		for(int y = 0; y < side; y++)
+		{
+			for(int x = 0; x < side; x++)
+			{
+				if(share(random) < blockedShare)
+					grid->AddUsedPosition({ x, y }, false);
+			}
+		}
+		return grid;
+	}
+
+	/**
+	 * @fn	static std::vector<PathRequest> MakeRequests(int side, size_t count, uint32_t seed)
+	 *
+	 * @brief	Makes requests between random cells, blocked and unreachable ones included so failures are compared too
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	side 	The width and height of the grid.
+	 * @param 	count	The number of requests.
+	 * @param 	seed 	The seed of the random cells.
+	 *
+	 * @returns	The requests.
+	 */
+
+	static std::vector<PathRequest> MakeRequests(int side, size_t count, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<int> cell(0, side - 1);
+		std::vector<PathRequest> requests;
+		requests.reserve(count);
+		for(size_t i = 0; i < count; i++)
+			requests.emplace_back(Int2(cell(random), cell(random)), Int2(cell(random), cell(random)));
+		return requests;
+	}
+
+	/**
+	 * @fn	static bool SamePath(const std::deque<Node>& left, const std::deque<Node>& right)
+	 *
+	 * @brief	Checks that two paths visit the same cells with the same costs
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	left 	The first path.
+	 * @param 	right	The second path.
+	 *
+	 * @returns	True if the paths are the same.
+	 */
+
+	static bool SamePath(const std::deque<Node>& left, const std::deque<Node>& right)
+	{
+		if(left.size() != right.size())
+			return false;
+		for(size_t i = 0; i < left.size(); i++)
+		{
+			if(left[i].position.x != right[i].position.x || left[i].position.y != right[i].position.y || left[i].g != right[i].g)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @fn	static void CheckBatchMatchesSerial(uint32_t workers)
+	 *
+	 * @brief	Solves the same requests with SolveBatch and one at a time with FindPath and checks every path matches
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	workers	The job system workers to start, 0 leaves the job system off so every job runs inline.
+	 */
+
+	static void CheckBatchMatchesSerial(uint32_t workers)
+	{
+		const int side = 96;
+		auto grid = MakeBlockedGrid(side, 0.25f, 7u);
+		std::vector<PathRequest> requests = MakeRequests(side, 400, 11u);
+
+		std::vector<std::deque<Node>> serial;
+		serial.reserve(requests.size());
+		AStarSearchContext context;
+		size_t found = 0;
+		for(const auto& request : requests)
+		{
+			serial.push_back(grid->FindPath(request.Start, request.Destination, context));
+			found += serial.back().empty() ? 0 : 1;
+		}
+
+		// A batch that is all failures or all paths would not show much, the blocking is chosen to give both
+		TNAH_CHECK(found > requests.size() / 4);
+		TNAH_CHECK(found < requests.size());
+
+		if(workers > 0)
+			JobSystem::Init(workers);
+
+		// Solved twice so the second run reuses the per thread contexts left by the first
+		for(int run = 0; run < 2; run++)
+		{
+			for(auto& request : requests)
+				request.Path.clear();
+			grid->SolveBatch(requests);
+
+			size_t mismatches = 0;
+			for(size_t i = 0; i < requests.size(); i++)
+				mismatches += SamePath(requests[i].Path, serial[i]) ? 0 : 1;
+			TNAH_CHECK(mismatches == 0);
+		}
+
+		if(workers > 0)
+			JobSystem::Shutdown();
+	}
+
+	TNAH_TEST(SolveBatchMatchesSerialInline)
+	{
+		CheckBatchMatchesSerial(0);
+	}
+
+	TNAH_TEST(SolveBatchMatchesSerialOnWorkers)
+	{
+		CheckBatchMatchesSerial(3);
+	}
+
+	TNAH_TEST(SolveBatchMatchesSerialOnOneWorker)
+	{
+		CheckBatchMatchesSerial(1);
+	}
+
+	TNAH_TEST(SolveBatchFromTwoOutsideThreads)
+	{
+		const int side = 96;
+		auto grid = MakeBlockedGrid(side, 0.25f, 7u);
+		const std::vector<PathRequest> requests = MakeRequests(side, 200, 13u);
+
+		std::vector<std::deque<Node>> serial;
+		AStarSearchContext context;
+		for(const auto& request : requests)
+			serial.push_back(grid->FindPath(request.Start, request.Destination, context));
+
+		// Threads the job system does not own run the first chunk of their batch themselves, two at once on one grid
+		// must not search with the same context
+		JobSystem::Init(2);
+		std::atomic<size_t> mismatches = 0;
+		auto solve = [&]()
+		{
+			for(int run = 0; run < 50; run++)
+			{
+				std::vector<PathRequest> batch = requests;
+				grid->SolveBatch(batch);
+				for(size_t i = 0; i < batch.size(); i++)
+					mismatches += SamePath(batch[i].Path, serial[i]) ? 0 : 1;
+			}
+		};
+		std::thread first(solve);
+		std::thread second(solve);
+		first.join();
+		second.join();
+		JobSystem::Shutdown();
+
+		TNAH_CHECK(mismatches == 0);
+	}
+
+	TNAH_TEST(HPAStarCatchUpIsSpreadOverPolls)
+	{
+		const int side = 256;
+		auto grid = MakeBlockedGrid(side, 0.2f, 19u);
+		auto hierarchy = Ref<HPAStarGraph>::Create(grid);
+		hierarchy->Build();
+
+		std::mt19937 random(23u);
+		std::uniform_int_distribution<int> cell(0, side - 1);
+		for(int i = 0; i < 300; i++)
+			grid->AddUsedPosition({ cell(random), cell(random) }, false);
+
+		// A budget that is always spent lets each poll rebuild one border or cluster
+		size_t polls = 1;
+		while(!hierarchy->IsReady([]() { return true; }) && polls < 100000)
+			polls++;
+		TNAH_CHECK(polls > 1);
+		TNAH_CHECK(hierarchy->IsReady());
+
+		// Caught up piece by piece the graph has to answer like one built from the final grid
+		auto fresh = Ref<HPAStarGraph>::Create(grid);
+		fresh->Build();
+		TNAH_CHECK(hierarchy->GetNodeCount() == fresh->GetNodeCount());
+
+		size_t mismatches = 0, routed = 0;
+		for(const auto& request : MakeRequests(side, 200, 29u))
+		{
+			HPARoute caughtUp, built;
+			const bool found = hierarchy->FindRoute(request.Start, request.Destination, caughtUp);
+			mismatches += found == fresh->FindRoute(request.Start, request.Destination, built) ? 0 : 1;
+			routed += found ? 1 : 0;
+		}
+		TNAH_CHECK(routed > 0);
+		TNAH_CHECK(mismatches == 0);
+	}
+
+	TNAH_TEST(StaticObstaclesUnbakeAndMove)
+	{
+		auto grid = Ref<AStarGrid>::Create(Int2(0, 0), Int2(8, 8));
+		grid->BakeStaticCells(std::vector<uint64_t>{ 1ull << 9 });
+
+		// Two obstacles share a cell, one sits on a cell the walkability bake already blocks
+		grid->BakeStaticObstacle(1u, { 2, 2 });
+		grid->BakeStaticObstacle(2u, { 2, 2 });
+		grid->BakeStaticObstacle(3u, { 1, 1 });
+		TNAH_CHECK(!grid->IsValid({ 2, 2 }));
+
+		grid->UnbakeStaticObstacle(1u);
+		TNAH_CHECK(!grid->IsValid({ 2, 2 }));
+		grid->UnbakeStaticObstacle(2u);
+		TNAH_CHECK(grid->IsValid({ 2, 2 }));
+		grid->UnbakeStaticObstacle(3u);
+		TNAH_CHECK(!grid->IsValid({ 1, 1 }));
+
+		// Baking again at a new cell moves the obstacle instead of leaving its old cell blocked
+		grid->BakeStaticObstacle(4u, { 5, 5 });
+		grid->BakeStaticObstacle(4u, { 6, 5 });
+		TNAH_CHECK(grid->IsValid({ 5, 5 }));
+		TNAH_CHECK(!grid->IsValid({ 6, 5 }));
+
+		// An obstacle the walkability bake stamped is not baked a second time
+		grid->SkipStaticObstacle(5u);
+		grid->BakeStaticObstacle(5u, { 3, 3 });
+		TNAH_CHECK(grid->IsValid({ 3, 3 }));
+	}
+}
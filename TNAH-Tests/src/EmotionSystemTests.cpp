@@ -0,0 +1,59 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include "TNAH/Scene/Components/AI/EmotionComponent.h"
+
+namespace tnah::test {
+
+	TNAH_TEST(EmotionSystemsStepOnlyTheirOwnComponents)
+	{
+		EmotionSystem first;
+		EmotionSystem second;
+		EmotionComponent inFirst(0.0f, 0.0f, Mood::Happy);
+		EmotionComponent inSecond(0.0f, 0.0f, Mood::Happy);
+		inFirst.MoveTo(first);
+		inSecond.MoveTo(second);
+		TNAH_CHECK(first.GetCount() == 1);
+		TNAH_CHECK(second.GetCount() == 1);
+
+		// Each scene steps its own system once a frame, the other scene's components must not move
+		first.Update(1000.0f);
+		TNAH_CHECK(inFirst.GetArousal() > 0.0f);
+		TNAH_CHECK(inSecond.GetArousal() == 0.0f);
+
+		// A copy stays in the system of the component it was copied from
+		EmotionComponent copy(inFirst);
+		TNAH_CHECK(first.GetCount() == 2);
+		TNAH_CHECK(copy.GetArousal() == inFirst.GetArousal());
+	}
+
+	TNAH_TEST(EmotionTableChangesStayWithTheComponent)
+	{
+		EmotionSystem system;
+		EmotionComponent changed;
+		EmotionComponent untouched;
+		changed.MoveTo(system);
+		untouched.MoveTo(system);
+
+		const Emotion before = untouched.ReturnEmotion(0.9f, 0.5f);
+		changed.RemoveEmotion(0.9f, 0.5f);
+		changed.AddEmotion(0.9f, 0.5f, Emotion::Tense);
+		TNAH_CHECK(changed.ReturnEmotion(0.9f, 0.5f) == Emotion::Tense);
+		TNAH_CHECK(untouched.ReturnEmotion(0.9f, 0.5f) == before);
+
+		// The update reads each component's own table
+		changed.SetArousal(0.9f);
+		changed.SetValence(0.5f);
+		untouched.SetArousal(0.9f);
+		untouched.SetValence(0.5f);
+		system.Update(0.0f);
+		TNAH_CHECK(changed.GetEmotion() == Emotion::Tense);
+		TNAH_CHECK(untouched.GetEmotion() == before);
+
+		// Moving to another system keeps the changed table
+		EmotionSystem other;
+		changed.MoveTo(other);
+		TNAH_CHECK(changed.ReturnEmotion(0.9f, 0.5f) == Emotion::Tense);
+		TNAH_CHECK(system.GetCount() == 1);
+	}
+}
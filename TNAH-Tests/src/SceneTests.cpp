@@ -0,0 +1,81 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include "TNAH/Renderer/RendererAPI.h"
+#include "TNAH/Scene/GameObject.h"
+#include "TNAH/Scene/Scene.h"
+#include "TNAH/Scene/Serializer.h"
+
+#include <filesystem>
+
+namespace tnah::test {
+
+	TNAH_TEST(FindGameObjectByIDResolvesThroughItsLink)
+	{
+		RendererAPI::SetAPI(RendererAPI::API::None);
+		{
+			Ref<Scene> scene = Scene::CreateEmptyScene();
+			auto& registry = scene->GetRegistry();
+			auto& objects = scene->GetGameObjectsInScene();
+
+			std::vector<entt::entity> ids;
+			while(ids.size() < 1000)
+				ids.push_back(scene->CreateGameObject("Object").GetID());
+
+			// Every lookup hands back the stored game object the entity's link points at
+			size_t wrong = 0;
+			for(entt::entity id : ids)
+			{
+				GameObject* found = scene->FindGameObjectByID(id);
+				const auto* link = registry.try_get<GameObjectLinkComponent>(id);
+				wrong += found && link && found == link->Object && found == &objects.at(found->GetUUID()) ? 0 : 1;
+			}
+			TNAH_CHECK(wrong == 0);
+
+			// Without its link an entity is not found even though the scene still holds its game object, so the
+			// lookup never falls back to walking the objects
+			GameObject* unlinked = scene->FindGameObjectByID(ids[10]);
+			registry.remove<GameObjectLinkComponent>(ids[10]);
+			TNAH_CHECK(objects.count(unlinked->GetUUID()) == 1);
+			TNAH_CHECK(scene->FindGameObjectByID(ids[10]) == nullptr);
+			registry.emplace<GameObjectLinkComponent>(ids[10], unlinked);
+
+			GameObject destroyed = *scene->FindGameObjectByID(ids[500]);
+			scene->DestroyGameObject(destroyed);
+			TNAH_CHECK(scene->FindGameObjectByID(ids[500]) == nullptr);
+			TNAH_CHECK(scene->FindGameObjectByID(ids[501])->GetID() == ids[501]);
+			TNAH_CHECK(scene->FindGameObjectByID(entt::null) == nullptr);
+		}
+		Scene::ClearActiveScene();
+	}
+
+	TNAH_TEST(LoadedSceneFindsCameraAndLightByTag)
+	{
+		RendererAPI::SetAPI(RendererAPI::API::None);
+		const std::string path = (std::filesystem::temp_directory_path() / "TagLookupTest.tnah").string();
+		{
+			Ref<Scene> scene = Scene::CreateEmptyScene();
+			scene->GetSceneCamera().SetTag("Saved Camera");
+			scene->GetSceneLight().SetTag("Saved Light");
+			Serializer::SaveScene(scene, path);
+		}
+		Scene::ClearActiveScene();
+
+		{
+			// The camera and light already exist when the file is read, loading renames them
+			Ref<Scene> loaded = Serializer::LoadScene(path);
+			TNAH_CHECK(loaded);
+			if(loaded)
+			{
+				GameObject camera = loaded->FindEntityByTag("Saved Camera");
+				GameObject light = loaded->FindEntityByTag("Saved Light");
+				TNAH_CHECK(camera && camera.GetID() == loaded->GetSceneCamera().GetID());
+				TNAH_CHECK(light && light.GetID() == loaded->GetSceneLight().GetID());
+				TNAH_CHECK(!loaded->FindEntityByTag("Main Camera"));
+				TNAH_CHECK(!loaded->FindEntityByTag("Main Light"));
+			}
+		}
+		Scene::ClearActiveScene();
+		std::filesystem::remove(path);
+	}
+}
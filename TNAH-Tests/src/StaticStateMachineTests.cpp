@@ -0,0 +1,106 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include "TNAH/Scene/Components/AI/AIComponent.h"
+#include "TNAH/Scene/Components/AI/StaticStateMachine.h"
+
+#include <string>
+
+namespace tnah::test {
+
+	/** @brief	Records what its states did so the order of calls can be checked */
+	struct RecordingOwner
+	{
+		std::string Calls;
+	};
+
+	struct Idle
+	{
+		void Enter(RecordingOwner& owner) { owner.Calls += "+idle "; }
+		void Exit(RecordingOwner& owner) { owner.Calls += "-idle "; }
+		void Execute(RecordingOwner& owner, int step) { owner.Calls += "idle" + std::to_string(step) + " "; }
+	};
+
+	struct Counting
+	{
+		int Count = 0;
+
+		template<class MachineType>
+		void Execute(RecordingOwner& owner, MachineType& machine, int step)
+		{
+			owner.Calls += "count" + std::to_string(step) + " ";
+			if(++Count == 2)
+			{
+				machine.template ChangeState<Idle>(owner);
+				owner.Calls += "asked ";
+			}
+		}
+	};
+
+	using RecordingMachine = StaticStateMachine<RecordingOwner, Idle, Counting>;
+
+	TNAH_TEST(StaticStateMachineHoldsChangesUntilExecuteReturns)
+	{
+		RecordingOwner owner;
+		RecordingMachine machine;
+		machine.Start(owner);
+		machine.Update(owner, 1);
+		machine.ChangeState<Counting>(owner);
+		machine.Update(owner, 2);
+		machine.Update(owner, 3);
+		machine.Update(owner, 4);
+
+		// Counting asks to go idle during its second update, idle is only entered once that update returns
+		TNAH_CHECK(owner.Calls == "+idle idle1 -idle count2 count3 asked +idle idle4 ");
+		TNAH_CHECK(machine.IsInState<Idle>());
+	}
+
+	TNAH_TEST(StaticStateMachineRevertKeepsStateData)
+	{
+		RecordingOwner owner;
+		RecordingMachine machine;
+		machine.ChangeState<Counting>(owner);
+		machine.Update(owner, 1);
+		TNAH_CHECK(machine.GetState<Counting>().Count == 1);
+
+		machine.ChangeState<Idle>(owner);
+		machine.RevertToPreviousState(owner);
+		TNAH_CHECK(machine.IsInState<Counting>());
+		TNAH_CHECK(machine.GetState<Counting>().Count == 1);
+		TNAH_CHECK(machine.GetStateIndex() == 1);
+	}
+
+	TNAH_TEST(StaticStateMachineMovesWithItsOwner)
+	{
+		// The machine keeps no pointer to the owner, so moving the owner somewhere else is safe
+		std::vector<RecordingOwner> owners(1);
+		RecordingMachine machine;
+		machine.ChangeState<Counting>(owners[0]);
+		owners.resize(64);
+		machine.Update(owners[0], 1);
+		machine.Update(owners[0], 2);
+		TNAH_CHECK(owners[0].Calls == "-idle count1 count2 asked +idle ");
+	}
+
+	TNAH_TEST(AIComponentSharedDestinationFallsBackWithoutField)
+	{
+		// With no grid there is no flow field to follow, the agent has to drop back to its own path on the next update
+		AStar::SetActiveGrid(nullptr);
+		AIComponent ai;
+		TransformComponent transform;
+		TNAH_CHECK(!ai.HasSharedDestination());
+
+		ai.SetSharedDestination(Int2(4, 4));
+		TNAH_CHECK(ai.HasSharedDestination());
+		TNAH_CHECK(ai.GetDestination().CheckSame(Int2(4, 4)));
+
+		AIComponent copy = ai;
+		TNAH_CHECK(copy.HasSharedDestination());
+
+		ai.OnUpdate(Timestep(0.016f), transform);
+		TNAH_CHECK(!ai.HasSharedDestination());
+
+		copy.ClearSharedDestination();
+		TNAH_CHECK(!copy.HasSharedDestination());
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdio>
+#include <vector>
+
+namespace tnah::test {
+
+	/** @brief	A test, it reports failures through TNAH_CHECK */
+	using TestFunction = void(*)();
+
+	/**
+	 * @struct	TestCase
+	 *
+	 * @brief	A registered test
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 */
+
+	struct TestCase
+	{
+		const char* Name;
+		TestFunction Function;
+	};
+
+	/**
+	 * @fn	inline std::vector<TestCase>& GetTestCases()
+	 *
+	 * @brief	Gets every test registered with TNAH_TEST, in the order the files were linked
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @returns	The tests.
+	 */
+
+	inline std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> s_Cases;
+		return s_Cases;
+	}
+
+	/**
+	 * @fn	inline size_t& GetFailureCount()
+	 *
+	 * @brief	Gets the number of checks that failed in the test being run
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @returns	The count, reset by the runner before each test.
+	 */
+
+	inline size_t& GetFailureCount()
+	{
+		static size_t s_Failures = 0;
+		return s_Failures;
+	}
+
+	/**
+	 * @fn	inline bool RegisterTest(const char* name, TestFunction function)
+	 *
+	 * @brief	Adds a test, called by TNAH_TEST before main
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	name		The name the test is picked by on the command line.
+	 * @param 	function	The test.
+	 *
+	 * @returns	True.
+	 */
+
+	inline bool RegisterTest(const char* name, TestFunction function)
+	{
+		GetTestCases().push_back({ name, function });
+		return true;
+	}
+
+	/**
+	 * @fn	inline bool Check(bool passed, const char* expression, const char* file, int line)
+	 *
+	 * @brief	Records a check, printing it if it failed
+	 *
+	 * @author	Chris
+	 * @date	17/10/2026
+	 *
+	 * @param 	passed	  	The result of the check.
+	 * @param 	expression	The checked expression.
+	 * @param 	file	  	The file of the check.
+	 * @param 	line	  	The line of the check.
+	 *
+	 * @returns	The result of the check.
+	 */
+
+	inline bool Check(bool passed, const char* expression, const char* file, int line)
+	{
+		if(!passed)
+		{
+			std::printf("  %s(%d): check failed: %s\n", file, line, expression);
+			GetFailureCount()++;
+		}
+		return passed;
+	}
+}
+
+/** @brief	Defines and registers a test */
+#define TNAH_TEST(name) \
+	static void name(); \
+	static const bool s_##name##Registered = ::tnah::test::RegisterTest(#name, &name); \
+	static void name()
+
+/** @brief	Fails the running test if the expression is false, evaluates to the result so a test can stop early */
+#define TNAH_CHECK(expression) ::tnah::test::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
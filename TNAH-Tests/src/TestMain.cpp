@@ -0,0 +1,44 @@
+#include "tnahpch.h"
+#include "Test.h"
+
+#include <cstring>
+
+/**
+ * @fn	int main(int argc, char** argv)
+ *
+ * @brief	Runs every test, or only those whose name contains one of the arguments
+ *
+ * @author	Chris
+ * @date	17/10/2026
+ *
+ * @param 	argc	The number of command-line arguments.
+ * @param 	argv	Parts of the names of the tests to run.
+ *
+ * @returns	0 if every test passed, else 1.
+ */
+
+int main(int argc, char** argv)
+{
+	tnah::Log::Init();
+
+	size_t run = 0;
+	size_t failed = 0;
+	for(const auto& test : tnah::test::GetTestCases())
+	{
+		bool selected = argc < 2;
+		for(int arg = 1; arg < argc && !selected; arg++)
+			selected = std::strstr(test.Name, argv[arg]) != nullptr;
+		if(!selected)
+			continue;
+
+		tnah::test::GetFailureCount() = 0;
+		test.Function();
+		const bool passed = tnah::test::GetFailureCount() == 0;
+		std::printf("[%s] %s\n", passed ? "pass" : "FAIL", test.Name);
+		run++;
+		failed += passed ? 0 : 1;
+	}
+
+	std::printf("%zu of %zu tests passed\n", run - failed, run);
+	return failed == 0 ? 0 : 1;
+}